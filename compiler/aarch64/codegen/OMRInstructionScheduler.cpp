@@ -0,0 +1,499 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "codegen/InstructionScheduler.hpp"
+
+#include "codegen/ARM64Instruction.hpp"
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/MemoryReference.hpp"
+#include "codegen/RealRegister.hpp"
+#include "codegen/Register.hpp"
+#include "compile/Compilation.hpp"
+
+// Resource number of the condition flags; real registers use their register number
+//
+#define FLAGS_RESOURCE ((int32_t)TR::RealRegister::NumRegisters)
+
+// A generic out-of-order ARMv8-A core with two integer pipelines, one
+// multiply/divide pipeline, one load and one store pipeline and two FP/SIMD
+// pipelines (ports 0-1: integer, 2: multiply/divide, 3: load, 4: store,
+// 5-6: FP/SIMD).
+//
+static const OMR::ARM64::InstructionScheduler::MachineModel armv8aModel =
+   {
+   "ARMv8-A", 3,
+   //  ALU   IMul  Div   Load  Store FPAdd FPMul FPDiv VALU  VMul
+   {   1,    3,    12,   4,    1,    3,    4,    12,   2,    4    },
+   {   0x03, 0x04, 0x04, 0x08, 0x10, 0x60, 0x60, 0x20, 0x60, 0x20 }
+   };
+
+OMR::ARM64::InstructionScheduler::InstructionScheduler(TR::Compilation* comp) :
+   OMR::InstructionScheduler(comp)
+   {}
+
+const OMR::ARM64::InstructionScheduler::MachineModel *
+OMR::ARM64::InstructionScheduler::getMachineModel()
+   {
+   return &armv8aModel;
+   }
+
+bool
+OMR::ARM64::InstructionScheduler::addRegister(TR::Register *reg, ResourceSet &resources)
+   {
+   if (reg == NULL)
+      return true;
+
+   TR::RealRegister *realReg = reg->getRealRegister();
+   if (realReg == NULL)
+      return false;
+
+   TR::RealRegister::RegNum regNum = realReg->getRegisterNumber();
+   if (regNum == TR::RealRegister::sp)
+      return false;
+
+   if (regNum != TR::RealRegister::xzr)
+      resources.set(regNum);
+   return true;
+   }
+
+bool
+OMR::ARM64::InstructionScheduler::getEffects(TR::Instruction *instr, InstructionEffects &effects)
+   {
+   if (instr->getDependencyConditions() != NULL || instr->needsGCMap())
+      return false;
+
+   bool readsTarget = false;
+   bool setsFlags = false;
+   bool readsFlags = false;
+
+   switch (instr->getOpCodeValue())
+      {
+      case TR::InstOpCode::movkw:
+      case TR::InstOpCode::movkx:
+      case TR::InstOpCode::bfmw:
+      case TR::InstOpCode::bfmx:
+         readsTarget = true;
+         /* fall through */
+      case TR::InstOpCode::addimmw:
+      case TR::InstOpCode::subimmw:
+      case TR::InstOpCode::addimmx:
+      case TR::InstOpCode::subimmx:
+      case TR::InstOpCode::andimmw:
+      case TR::InstOpCode::orrimmw:
+      case TR::InstOpCode::eorimmw:
+      case TR::InstOpCode::andimmx:
+      case TR::InstOpCode::orrimmx:
+      case TR::InstOpCode::eorimmx:
+      case TR::InstOpCode::movnw:
+      case TR::InstOpCode::movzw:
+      case TR::InstOpCode::movnx:
+      case TR::InstOpCode::movzx:
+      case TR::InstOpCode::sbfmw:
+      case TR::InstOpCode::ubfmw:
+      case TR::InstOpCode::sbfmx:
+      case TR::InstOpCode::ubfmx:
+      case TR::InstOpCode::extrw:
+      case TR::InstOpCode::extrx:
+      case TR::InstOpCode::andw:
+      case TR::InstOpCode::bicw:
+      case TR::InstOpCode::orrw:
+      case TR::InstOpCode::ornw:
+      case TR::InstOpCode::eorw:
+      case TR::InstOpCode::eonw:
+      case TR::InstOpCode::andx:
+      case TR::InstOpCode::bicx:
+      case TR::InstOpCode::orrx:
+      case TR::InstOpCode::ornx:
+      case TR::InstOpCode::eorx:
+      case TR::InstOpCode::eonx:
+      case TR::InstOpCode::addw:
+      case TR::InstOpCode::subw:
+      case TR::InstOpCode::addx:
+      case TR::InstOpCode::subx:
+      case TR::InstOpCode::addextw:
+      case TR::InstOpCode::subextw:
+      case TR::InstOpCode::addextx:
+      case TR::InstOpCode::subextx:
+      case TR::InstOpCode::lslvw:
+      case TR::InstOpCode::lslvx:
+      case TR::InstOpCode::lsrvw:
+      case TR::InstOpCode::lsrvx:
+      case TR::InstOpCode::asrvw:
+      case TR::InstOpCode::asrvx:
+      case TR::InstOpCode::rorvw:
+      case TR::InstOpCode::rorvx:
+      case TR::InstOpCode::rbitw:
+      case TR::InstOpCode::rbitx:
+      case TR::InstOpCode::clzw:
+      case TR::InstOpCode::clzx:
+      case TR::InstOpCode::clsw:
+      case TR::InstOpCode::clsx:
+      case TR::InstOpCode::revw:
+      case TR::InstOpCode::revx:
+      case TR::InstOpCode::rev16w:
+      case TR::InstOpCode::rev16x:
+      case TR::InstOpCode::rev32:
+         effects._class = IntegerALU;
+         break;
+
+      case TR::InstOpCode::adcsw:
+      case TR::InstOpCode::sbcsw:
+      case TR::InstOpCode::adcsx:
+      case TR::InstOpCode::sbcsx:
+         readsFlags = true;
+         /* fall through */
+      case TR::InstOpCode::addsimmw:
+      case TR::InstOpCode::subsimmw:
+      case TR::InstOpCode::addsimmx:
+      case TR::InstOpCode::subsimmx:
+      case TR::InstOpCode::andsimmw:
+      case TR::InstOpCode::andsimmx:
+      case TR::InstOpCode::andsw:
+      case TR::InstOpCode::bicsw:
+      case TR::InstOpCode::andsx:
+      case TR::InstOpCode::bicsx:
+      case TR::InstOpCode::addsw:
+      case TR::InstOpCode::subsw:
+      case TR::InstOpCode::addsx:
+      case TR::InstOpCode::subsx:
+      case TR::InstOpCode::addsextw:
+      case TR::InstOpCode::subsextw:
+      case TR::InstOpCode::addsextx:
+      case TR::InstOpCode::subsextx:
+         setsFlags = true;
+         effects._class = IntegerALU;
+         break;
+
+      case TR::InstOpCode::adcw:
+      case TR::InstOpCode::sbcw:
+      case TR::InstOpCode::adcx:
+      case TR::InstOpCode::sbcx:
+      case TR::InstOpCode::cselw:
+      case TR::InstOpCode::csincw:
+      case TR::InstOpCode::csinvw:
+      case TR::InstOpCode::csnegw:
+      case TR::InstOpCode::cselx:
+      case TR::InstOpCode::csincx:
+      case TR::InstOpCode::csinvx:
+      case TR::InstOpCode::csnegx:
+         readsFlags = true;
+         effects._class = IntegerALU;
+         break;
+
+      case TR::InstOpCode::maddw:
+      case TR::InstOpCode::maddx:
+      case TR::InstOpCode::smaddl:
+      case TR::InstOpCode::umaddl:
+      case TR::InstOpCode::msubw:
+      case TR::InstOpCode::msubx:
+      case TR::InstOpCode::smsubl:
+      case TR::InstOpCode::umsubl:
+      case TR::InstOpCode::smulh:
+      case TR::InstOpCode::umulh:
+      case TR::InstOpCode::crc32x:
+      case TR::InstOpCode::crc32cx:
+      case TR::InstOpCode::crc32b:
+      case TR::InstOpCode::crc32cb:
+      case TR::InstOpCode::crc32h:
+      case TR::InstOpCode::crc32ch:
+      case TR::InstOpCode::crc32w:
+      case TR::InstOpCode::crc32cw:
+         effects._class = IntegerMultiply;
+         break;
+
+      case TR::InstOpCode::udivw:
+      case TR::InstOpCode::udivx:
+      case TR::InstOpCode::sdivw:
+      case TR::InstOpCode::sdivx:
+         effects._class = IntegerDivide;
+         break;
+
+      case TR::InstOpCode::fcmps:
+      case TR::InstOpCode::fcmps_zero:
+      case TR::InstOpCode::fcmpd:
+      case TR::InstOpCode::fcmpd_zero:
+         setsFlags = true;
+         effects._class = FloatingPointAdd;
+         break;
+
+      case TR::InstOpCode::fcsels:
+      case TR::InstOpCode::fcseld:
+         readsFlags = true;
+         /* fall through */
+      case TR::InstOpCode::fmov_stow:
+      case TR::InstOpCode::fmov_wtos:
+      case TR::InstOpCode::fmov_dtox:
+      case TR::InstOpCode::fmov_xtod:
+      case TR::InstOpCode::fcvt_stod:
+      case TR::InstOpCode::fcvt_dtos:
+      case TR::InstOpCode::fcvtzs_stow:
+      case TR::InstOpCode::fcvtzs_dtow:
+      case TR::InstOpCode::fcvtzs_stox:
+      case TR::InstOpCode::fcvtzs_dtox:
+      case TR::InstOpCode::scvtf_wtos:
+      case TR::InstOpCode::scvtf_wtod:
+      case TR::InstOpCode::scvtf_xtos:
+      case TR::InstOpCode::scvtf_xtod:
+      case TR::InstOpCode::fmovimms:
+      case TR::InstOpCode::fmovimmd:
+      case TR::InstOpCode::movi0s:
+      case TR::InstOpCode::movi0d:
+      case TR::InstOpCode::fmovs:
+      case TR::InstOpCode::fmovd:
+      case TR::InstOpCode::fabss:
+      case TR::InstOpCode::fabsd:
+      case TR::InstOpCode::fnegs:
+      case TR::InstOpCode::fnegd:
+      case TR::InstOpCode::fadds:
+      case TR::InstOpCode::faddd:
+      case TR::InstOpCode::fsubs:
+      case TR::InstOpCode::fsubd:
+      case TR::InstOpCode::fmaxs:
+      case TR::InstOpCode::fmaxd:
+      case TR::InstOpCode::fmins:
+      case TR::InstOpCode::fmind:
+         effects._class = FloatingPointAdd;
+         break;
+
+      case TR::InstOpCode::fmuls:
+      case TR::InstOpCode::fmuld:
+      case TR::InstOpCode::fmaddd:
+      case TR::InstOpCode::fmadds:
+         effects._class = FloatingPointMultiply;
+         break;
+
+      case TR::InstOpCode::fsqrts:
+      case TR::InstOpCode::fsqrtd:
+      case TR::InstOpCode::fdivs:
+      case TR::InstOpCode::fdivd:
+      case TR::InstOpCode::vfdiv4s:
+      case TR::InstOpCode::vfdiv2d:
+         effects._class = FloatingPointDivide;
+         break;
+
+      case TR::InstOpCode::vorr2d:
+      case TR::InstOpCode::vadd16b:
+      case TR::InstOpCode::vadd8h:
+      case TR::InstOpCode::vadd4s:
+      case TR::InstOpCode::vadd2d:
+      case TR::InstOpCode::vfadd4s:
+      case TR::InstOpCode::vfadd2d:
+      case TR::InstOpCode::vsub16b:
+      case TR::InstOpCode::vsub8h:
+      case TR::InstOpCode::vsub4s:
+      case TR::InstOpCode::vsub2d:
+      case TR::InstOpCode::vfsub4s:
+      case TR::InstOpCode::vfsub2d:
+      case TR::InstOpCode::vand16b:
+      case TR::InstOpCode::vorr16b:
+      case TR::InstOpCode::veor16b:
+      case TR::InstOpCode::vneg16b:
+      case TR::InstOpCode::vneg8h:
+      case TR::InstOpCode::vneg4s:
+      case TR::InstOpCode::vneg2d:
+      case TR::InstOpCode::vfneg4s:
+      case TR::InstOpCode::vfneg2d:
+      case TR::InstOpCode::vnot16b:
+      case TR::InstOpCode::vdup16b:
+      case TR::InstOpCode::vdup8h:
+      case TR::InstOpCode::vdup4s:
+      case TR::InstOpCode::vdup2d:
+      case TR::InstOpCode::vfdup4s:
+      case TR::InstOpCode::vfdup2d:
+         effects._class = VectorALU;
+         break;
+
+      case TR::InstOpCode::vmul16b:
+      case TR::InstOpCode::vmul8h:
+      case TR::InstOpCode::vmul4s:
+      case TR::InstOpCode::vfmul4s:
+      case TR::InstOpCode::vfmul2d:
+         effects._class = VectorMultiply;
+         break;
+
+      case TR::InstOpCode::ldrimmw:
+      case TR::InstOpCode::ldrimmx:
+      case TR::InstOpCode::ldrbimm:
+      case TR::InstOpCode::ldrhimm:
+      case TR::InstOpCode::ldrsbimmw:
+      case TR::InstOpCode::ldrsbimmx:
+      case TR::InstOpCode::ldrshimmw:
+      case TR::InstOpCode::ldrshimmx:
+      case TR::InstOpCode::ldrswimm:
+      case TR::InstOpCode::vldrimmb:
+      case TR::InstOpCode::vldrimmh:
+      case TR::InstOpCode::vldrimms:
+      case TR::InstOpCode::vldrimmd:
+      case TR::InstOpCode::vldrimmq:
+      case TR::InstOpCode::ldurb:
+      case TR::InstOpCode::ldursbw:
+      case TR::InstOpCode::ldursbx:
+      case TR::InstOpCode::ldurh:
+      case TR::InstOpCode::ldurshw:
+      case TR::InstOpCode::ldurshx:
+      case TR::InstOpCode::ldurw:
+      case TR::InstOpCode::ldursw:
+      case TR::InstOpCode::ldurx:
+      case TR::InstOpCode::vldurb:
+      case TR::InstOpCode::vldurh:
+      case TR::InstOpCode::vldurs:
+      case TR::InstOpCode::vldurd:
+      case TR::InstOpCode::vldurq:
+      case TR::InstOpCode::ldroffw:
+      case TR::InstOpCode::ldroffx:
+      case TR::InstOpCode::ldrboff:
+      case TR::InstOpCode::ldrhoff:
+      case TR::InstOpCode::ldrsboffw:
+      case TR::InstOpCode::ldrsboffx:
+      case TR::InstOpCode::ldrshoffw:
+      case TR::InstOpCode::ldrshoffx:
+      case TR::InstOpCode::ldrswoff:
+      case TR::InstOpCode::vldroffb:
+      case TR::InstOpCode::vldroffh:
+      case TR::InstOpCode::vldroffs:
+      case TR::InstOpCode::vldroffd:
+      case TR::InstOpCode::vldroffq:
+         effects._class = Load;
+         effects._readsMemory = true;
+         break;
+
+      case TR::InstOpCode::strimmw:
+      case TR::InstOpCode::strimmx:
+      case TR::InstOpCode::strbimm:
+      case TR::InstOpCode::strhimm:
+      case TR::InstOpCode::vstrimmb:
+      case TR::InstOpCode::vstrimmh:
+      case TR::InstOpCode::vstrimms:
+      case TR::InstOpCode::vstrimmd:
+      case TR::InstOpCode::vstrimmq:
+      case TR::InstOpCode::sturb:
+      case TR::InstOpCode::sturh:
+      case TR::InstOpCode::sturw:
+      case TR::InstOpCode::sturx:
+      case TR::InstOpCode::vsturb:
+      case TR::InstOpCode::vsturh:
+      case TR::InstOpCode::vsturs:
+      case TR::InstOpCode::vsturd:
+      case TR::InstOpCode::vsturq:
+      case TR::InstOpCode::stroffw:
+      case TR::InstOpCode::stroffx:
+      case TR::InstOpCode::strboff:
+      case TR::InstOpCode::strhoff:
+      case TR::InstOpCode::vstroffb:
+      case TR::InstOpCode::vstroffh:
+      case TR::InstOpCode::vstroffs:
+      case TR::InstOpCode::vstroffd:
+      case TR::InstOpCode::vstroffq:
+         effects._class = Store;
+         effects._writesMemory = true;
+         break;
+
+      default:
+         return false;
+      }
+
+   TR::Register *target = NULL;
+   TR::Register *sources[3] = { NULL, NULL, NULL };
+   TR::MemoryReference *mr = NULL;
+
+   switch (instr->getKind())
+      {
+      case TR::Instruction::IsTrg1:
+      case TR::Instruction::IsTrg1Cond:
+      case TR::Instruction::IsTrg1Imm:
+      case TR::Instruction::IsTrg1ZeroImm:
+         target = static_cast<TR::ARM64Trg1Instruction *>(instr)->getTargetRegister();
+         break;
+      case TR::Instruction::IsTrg1Src1:
+      case TR::Instruction::IsTrg1ZeroSrc1:
+      case TR::Instruction::IsTrg1Src1Imm:
+         target = static_cast<TR::ARM64Trg1Src1Instruction *>(instr)->getTargetRegister();
+         sources[0] = static_cast<TR::ARM64Trg1Src1Instruction *>(instr)->getSource1Register();
+         break;
+      case TR::Instruction::IsTrg1Src2:
+      case TR::Instruction::IsCondTrg1Src2:
+      case TR::Instruction::IsTrg1Src2Shifted:
+      case TR::Instruction::IsTrg1Src2Extended:
+      case TR::Instruction::IsTrg1Src2Zero:
+         target = static_cast<TR::ARM64Trg1Src2Instruction *>(instr)->getTargetRegister();
+         sources[0] = static_cast<TR::ARM64Trg1Src2Instruction *>(instr)->getSource1Register();
+         sources[1] = static_cast<TR::ARM64Trg1Src2Instruction *>(instr)->getSource2Register();
+         break;
+      case TR::Instruction::IsTrg1Src3:
+         target = static_cast<TR::ARM64Trg1Src3Instruction *>(instr)->getTargetRegister();
+         sources[0] = static_cast<TR::ARM64Trg1Src3Instruction *>(instr)->getSource1Register();
+         sources[1] = static_cast<TR::ARM64Trg1Src3Instruction *>(instr)->getSource2Register();
+         sources[2] = static_cast<TR::ARM64Trg1Src3Instruction *>(instr)->getSource3Register();
+         break;
+      case TR::Instruction::IsTrg1Mem:
+         target = static_cast<TR::ARM64Trg1MemInstruction *>(instr)->getTargetRegister();
+         mr = static_cast<TR::ARM64Trg1MemInstruction *>(instr)->getMemoryReference();
+         break;
+      case TR::Instruction::IsMemSrc1:
+         sources[0] = static_cast<TR::ARM64MemSrc1Instruction *>(instr)->getSource1Register();
+         mr = static_cast<TR::ARM64MemSrc1Instruction *>(instr)->getMemoryReference();
+         break;
+      case TR::Instruction::IsSrc1:
+      case TR::Instruction::IsZeroSrc1Imm:
+         sources[0] = static_cast<TR::ARM64Src1Instruction *>(instr)->getSource1Register();
+         break;
+      case TR::Instruction::IsSrc2:
+      case TR::Instruction::IsZeroSrc2:
+         sources[0] = static_cast<TR::ARM64Src2Instruction *>(instr)->getSource1Register();
+         sources[1] = static_cast<TR::ARM64Src2Instruction *>(instr)->getSource2Register();
+         break;
+      default:
+         return false;
+      }
+
+   // Loads and stores must come with their memory reference
+   //
+   if ((effects._readsMemory || effects._writesMemory) != (mr != NULL))
+      return false;
+
+   if (!addRegister(target, effects._defs))
+      return false;
+   if (readsTarget && !addRegister(target, effects._uses))
+      return false;
+
+   for (int32_t i = 0; i < 3; ++i)
+      {
+      if (!addRegister(sources[i], effects._uses))
+         return false;
+      }
+
+   if (mr != NULL)
+      {
+      if (mr->getUnresolvedSnippet() != NULL || mr->getExtraRegister() != NULL)
+         return false;
+      if (!addRegister(mr->getBaseRegister(), effects._uses) || !addRegister(mr->getIndexRegister(), effects._uses))
+         return false;
+      }
+
+   if (setsFlags)
+      effects._defs.set(FLAGS_RESOURCE);
+   if (readsFlags)
+      effects._uses.set(FLAGS_RESOURCE);
+
+   return true;
+   }
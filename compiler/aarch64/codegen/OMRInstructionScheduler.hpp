@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#ifndef OMR_ARM64_INSTRUCTIONSCHEDULER_INCL
+#define OMR_ARM64_INSTRUCTIONSCHEDULER_INCL
+
+/*
+ * The following #define and typedef must appear before any #includes in this file
+ */
+#ifndef OMR_INSTRUCTIONSCHEDULER_CONNECTOR
+#define OMR_INSTRUCTIONSCHEDULER_CONNECTOR
+namespace OMR { namespace ARM64 { class InstructionScheduler; } }
+namespace OMR { typedef OMR::ARM64::InstructionScheduler InstructionSchedulerConnector; }
+#else
+#error OMR::ARM64::InstructionScheduler expected to be a primary connector, but an OMR connector is already defined
+#endif
+
+#include "compiler/codegen/OMRInstructionScheduler.hpp"
+
+namespace TR { class Compilation; }
+namespace TR { class Instruction; }
+namespace TR { class Register; }
+
+namespace OMR
+{
+
+namespace ARM64
+{
+
+/**
+ * \brief
+ *    Describes AArch64 instructions to the list scheduler.
+ *
+ * \details
+ *    Only the integer, floating point and vector data processing instructions
+ *    and the single register loads and stores with an immediate or register
+ *    offset are moved. Branches, pair, exclusive, acquire/release and atomic
+ *    memory accesses, writeback addressing, PC-relative and relocatable
+ *    instructions, instructions with register dependencies, and anything
+ *    referencing the stack pointer stay in place.
+ */
+class OMR_EXTENSIBLE InstructionScheduler : public OMR::InstructionScheduler
+   {
+   public:
+
+   InstructionScheduler(TR::Compilation* comp);
+
+   protected:
+
+   virtual const MachineModel *getMachineModel();
+   virtual bool getEffects(TR::Instruction *instr, InstructionEffects &effects);
+
+   private:
+
+   bool addRegister(TR::Register *reg, ResourceSet &resources);
+   };
+
+}
+
+}
+
+#endif
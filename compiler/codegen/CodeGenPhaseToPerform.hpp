@@ -34,6 +34,7 @@
     RegisterAssigningPhase,
     MapStackPhase,
     PeepholePhase,
+    InstructionSchedulingPhase,
     ExpandInstructionsPhase,
 
     BinaryEncodingPhase,
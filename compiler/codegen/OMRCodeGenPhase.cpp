@@ -40,6 +40,7 @@
 #include "codegen/CodeGenerator.hpp"
 #include "codegen/CodeGenerator_inlines.hpp"
 #include "codegen/GCStackAtlas.hpp"
+#include "codegen/InstructionScheduler.hpp"
 #include "codegen/Linkage.hpp"
 #include "codegen/Linkage_inlines.hpp"
 #include "codegen/Peephole.hpp"
@@ -337,6 +338,25 @@ OMR::CodeGenPhase::performPeepholePhase(TR::CodeGenerator * cg, TR::CodeGenPhase
 
 
 
+void
+OMR::CodeGenPhase::performInstructionSchedulingPhase(TR::CodeGenerator * cg, TR::CodeGenPhase * phase)
+   {
+   TR::Compilation* comp = cg->comp();
+
+   if (!comp->getOption(TR_DisableInstructionScheduling) && comp->getMethodHotness() >= warm)
+      {
+      phase->reportPhase(InstructionSchedulingPhase);
+
+      TR::LexicalMemProfiler mp(phase->getName(), comp->phaseMemProfiler());
+      LexicalTimer pt(phase->getName(), comp->phaseTimer());
+
+      TR::InstructionScheduler scheduler(comp);
+      bool performed = scheduler.perform();
+
+      if (performed && comp->getOption(TR_TraceCG))
+         comp->getDebug()->dumpMethodInstrs(comp->getOutFile(), "Post Instruction Scheduling Instructions", false);
+      }
+   }
 
 
 void
@@ -620,6 +640,8 @@ OMR::CodeGenPhase::getName(PhaseValue phase)
 	 return "CleanUpFlagsPhase";
       case ExpandInstructionsPhase:
          return "ExpandInstructionsPhase";
+      case InstructionSchedulingPhase:
+         return "InstructionScheduling";
       default:
          TR_ASSERT(false, "TR::CodeGenPhase %d doesn't have a corresponding name.", phase);
          return NULL;
@@ -99,6 +99,7 @@ class OMR_EXTENSIBLE CodeGenPhase
    static void performCleanUpFlagsPhase(TR::CodeGenerator * cg, TR::CodeGenPhase * phase);
    static void performInsertDebugCountersPhase(TR::CodeGenerator * cg, TR::CodeGenPhase * phase);
    static void performExpandInstructionsPhase(TR::CodeGenerator * cg, TR::CodeGenPhase * phase);
+   static void performInstructionSchedulingPhase(TR::CodeGenerator * cg, TR::CodeGenPhase * phase);
 
    protected:
 
@@ -43,4 +43,5 @@
       InsertDebugCountersPhase,
       CleanUpFlagsPhase,
       ExpandInstructionsPhase,
-      LastOMRPhase = ExpandInstructionsPhase,
+      InstructionSchedulingPhase,
+      LastOMRPhase = InstructionSchedulingPhase,
@@ -43,3 +43,4 @@
    TR::CodeGenPhase::performInsertDebugCountersPhase,
    TR::CodeGenPhase::performCleanUpFlagsPhase,
    TR::CodeGenPhase::performExpandInstructionsPhase,
+   TR::CodeGenPhase::performInstructionSchedulingPhase,
@@ -98,6 +98,7 @@
 #include "infra/Link.hpp"
 #include "infra/List.hpp"
 #include "infra/Stack.hpp"
+#include "infra/vector.hpp"
 #include "infra/Checklist.hpp"
 #include "infra/CfgEdge.hpp"
 #include "infra/CfgNode.hpp"
@@ -109,6 +110,7 @@
 #include "runtime/CodeCache.hpp"
 #include "runtime/CodeCacheExceptions.hpp"
 #include "runtime/CodeCacheManager.hpp"
+#include "runtime/JitDump.hpp"
 #include "runtime/Runtime.hpp"
 #include "stdarg.h"
 #include "OMR/Bytes.hpp"
@@ -1129,6 +1131,61 @@ OMR::CodeGenerator::getCodeLength() // cast explicitly
    return (uint32_t)(self()->getCodeEnd() - self()->getCodeStart());
    }
 
+void
+OMR::CodeGenerator::writeJitDumpInfo(TR::JitDump *jitDump, uint8_t *startPC, uint32_t codeSize, const char *fileName)
+   {
+#if defined(LINUX)
+   TR::StackMemoryRegion stackMemoryRegion(*self()->trMemory());
+   TR::vector<TR::JitDump::DebugEntry, TR::Region&> debugEntries(stackMemoryRegion);
+   TR::vector<TR::JitDump::UnwindRow, TR::Region&> unwindRows(stackMemoryRegion);
+
+   // On entry only the return address is on the stack
+   //
+   int32_t cfaOffset = self()->comp()->target().is64Bit() ? 8 : 4;
+   bool describeUnwinding = TR::JitDump::supportsUnwindingInfo();
+
+   for (TR::Instruction *instr = self()->getFirstInstruction(); instr; instr = instr->getNext())
+      {
+      uint8_t *encoding = instr->getBinaryEncoding();
+      TR::Node *node = instr->getNode();
+      if (encoding && node && instr->getBinaryLength() > 0 && encoding >= startPC && encoding < startPC + codeSize)
+         {
+         int32_t line = node->getByteCodeIndex();
+         int32_t discriminator = node->getInlinedSiteIndex() + 1;
+         if (debugEntries.empty() || debugEntries.back()._line != line || debugEntries.back()._discriminator != discriminator)
+            {
+            TR::JitDump::DebugEntry entry = { (uintptr_t)encoding, line, discriminator };
+            debugEntries.push_back(entry);
+            }
+         }
+
+      if (describeUnwinding)
+         {
+         int32_t previousOffset = cfaOffset;
+         if (!self()->updateCFAOffset(instr, cfaOffset))
+            {
+            describeUnwinding = false;
+            }
+         else if (encoding && cfaOffset != previousOffset)
+            {
+            uint8_t *end = encoding + instr->getBinaryLength();
+            TR::JitDump::UnwindRow row = { end > startPC ? (uint32_t)(end - startPC) : 0, cfaOffset };
+            if (!unwindRows.empty() && unwindRows.back()._codeOffset == row._codeOffset)
+               unwindRows.back() = row;
+            else
+               unwindRows.push_back(row);
+            }
+         }
+      }
+
+   if (!debugEntries.empty())
+      jitDump->writeDebugInfo(startPC, fileName, &debugEntries[0], debugEntries.size());
+
+   if (describeUnwinding)
+      jitDump->writeUnwindingInfo(codeSize, unwindRows.empty() ? NULL : &unwindRows[0], unwindRows.size());
+#endif
+   }
+
 bool
 OMR::CodeGenerator::needRelocationsForLookupEvaluationData()
    {
@@ -1746,7 +1803,10 @@ OMR::CodeGenerator::reserveCodeCache()
    int32_t numReserved = 0;
    int32_t compThreadID = 0;
 
-   _codeCache = TR::CodeCacheManager::instance()->reserveCodeCache(false, 0, compThreadID, &numReserved);
+   // Hot code is clustered together in the code cache
+   bool isHotCode = self()->comp()->getMethodHotness() >= hot;
+
+   _codeCache = TR::CodeCacheManager::instance()->reserveCodeCache(false, 0, compThreadID, &numReserved, isHotCode);
 
    if (!_codeCache) // Cannot reserve a cache; all are used
       {
@@ -95,6 +95,7 @@ namespace TR { class Block; }
 namespace TR { class CodeCache; }
 namespace TR { class CodeGenerator; }
 namespace TR { class Instruction; }
+namespace TR { class JitDump; }
 namespace TR { class LabelSymbol; }
 namespace TR { class Linkage; }
 namespace TR { class MemoryReference; }
@@ -775,6 +776,43 @@ public:
 
    uint8_t *alignBinaryBufferCursor();
 
+   /**
+    * \brief
+    *    Writes the jitdump records describing the source lines of the encoded
+    *    instructions and how to unwind through them. Must be called before
+    *    the code itself is registered with the code cache manager.
+    *
+    * \param jitDump
+    *    The jitdump file writer.
+    *
+    * \param startPC
+    *    The start of the code being registered.
+    *
+    * \param codeSize
+    *    The size of the code being registered.
+    *
+    * \param fileName
+    *    The name the source lines are reported against.
+    */
+   void writeJitDumpInfo(TR::JitDump *jitDump, uint8_t *startPC, uint32_t codeSize, const char *fileName);
+
+   /**
+    * \brief
+    *    Tracks the offset of the canonical frame address (the stack pointer
+    *    before the call to the method) from the stack pointer across an
+    *    encoded instruction. Instructions are visited in encoding order.
+    *
+    * \param instr
+    *    The instruction.
+    *
+    * \param cfaOffset
+    *    The offset before \p instr; updated to the offset after it.
+    *
+    * \return
+    *    false if the effect of \p instr on the stack pointer cannot be described.
+    */
+   virtual bool updateCFAOffset(TR::Instruction *instr, int32_t &cfaOffset) { return false; }
+
    uint32_t getBinaryBufferLength() {return (uint32_t)(_binaryBufferCursor - _binaryBufferStart - _jitMethodEntryPaddingSize);} // cast explicitly
 
    int32_t getEstimatedSnippetStart() {return _estimatedSnippetStart;}
@@ -0,0 +1,253 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "codegen/InstructionScheduler.hpp"
+
+#include <algorithm>
+#include <string.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/CodeGenerator_inlines.hpp"
+#include "codegen/Instruction.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "ras/Debug.hpp"
+
+OMR::InstructionScheduler::InstructionScheduler(TR::Compilation* comp) :
+   _comp(comp), _cg(comp->cg()), _model(NULL)
+   {}
+
+TR::InstructionScheduler*
+OMR::InstructionScheduler::self()
+   {
+   return static_cast<TR::InstructionScheduler*>(this);
+   }
+
+TR::Compilation*
+OMR::InstructionScheduler::comp() const
+   {
+   return _comp;
+   }
+
+TR::CodeGenerator*
+OMR::InstructionScheduler::cg() const
+   {
+   return _cg;
+   }
+
+int32_t
+OMR::InstructionScheduler::getLatency(const InstructionEffects &effects)
+   {
+   int32_t latency = _model->_latency[effects._class];
+
+   // A memory operand of an arithmetic instruction is loaded before the operation starts
+   //
+   if (effects._readsMemory && effects._class != Load && effects._class != Store)
+      latency += _model->_latency[Load];
+
+   return latency;
+   }
+
+bool
+OMR::InstructionScheduler::perform()
+   {
+   _model = getMachineModel();
+   if (_model == NULL)
+      return false;
+
+   if (comp()->getOption(TR_TraceCG))
+      traceMsg(comp(), "Scheduling instructions for %s\n", _model->_name);
+
+   TR::StackMemoryRegion stackMemoryRegion(*comp()->trMemory());
+   InstructionEffects *effects = new (comp()->trMemory()->currentStackRegion()) InstructionEffects[MaxRegionLength];
+
+   bool performed = false;
+   TR::Instruction *cursor = cg()->getFirstInstruction();
+   while (cursor != NULL)
+      {
+      // Collect the next run of movable instructions
+      //
+      TR::Instruction *first = cursor;
+      int32_t length = 0;
+      while (cursor != NULL && length < MaxRegionLength)
+         {
+         // An instruction that may fault on behalf of an implicit exception
+         // check must stay ordered with the stores around it
+         //
+         if (cursor == cg()->getImplicitExceptionPoint())
+            break;
+
+         effects[length] = InstructionEffects();
+         if (!getEffects(cursor, effects[length]))
+            break;
+         length++;
+         cursor = cursor->getNext();
+         }
+
+      if (length == 0)
+         cursor = cursor->getNext();
+      else if (length > 1 && first->getPrev() != NULL)
+         performed |= scheduleRegion(first, length, effects);
+      }
+
+   return performed;
+   }
+
+bool
+OMR::InstructionScheduler::scheduleRegion(TR::Instruction *first, int32_t length, InstructionEffects *effects)
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*comp()->trMemory());
+   TR::Region &region = comp()->trMemory()->currentStackRegion();
+
+   TR::Instruction **instructions = new (region) TR::Instruction *[length];
+   TR::Instruction *cursor = first;
+   for (int32_t i = 0; i < length; ++i, cursor = cursor->getNext())
+      instructions[i] = cursor;
+
+   // Build the dependence graph. edges[i * length + j] is the number of
+   // cycles instruction j has to wait after instruction i issues, or -1 when
+   // j does not depend on i. A latency of 0 only keeps j after i.
+   //
+   int32_t *edges = new (region) int32_t[length * length];
+   for (int32_t i = 0; i < length * length; ++i)
+      edges[i] = -1;
+
+   int32_t *unscheduledPredecessors = new (region) int32_t[length];
+   memset(unscheduledPredecessors, 0, length * sizeof(int32_t));
+
+   for (int32_t j = 1; j < length; ++j)
+      {
+      const InstructionEffects &to = effects[j];
+      for (int32_t i = 0; i < j; ++i)
+         {
+         const InstructionEffects &from = effects[i];
+         int32_t latency = -1;
+
+         if (from._defs.intersects(to._uses))
+            latency = std::max(latency, getLatency(from));
+         if (from._defs.intersects(to._defs))
+            latency = std::max(latency, 1);
+         if (from._uses.intersects(to._defs))
+            latency = std::max(latency, 0);
+
+         if (from._writesMemory && to._readsMemory)
+            latency = std::max(latency, getLatency(from));
+         else if (from._writesMemory && to._writesMemory)
+            latency = std::max(latency, 1);
+         else if (from._readsMemory && to._writesMemory)
+            latency = std::max(latency, 0);
+
+         if (latency >= 0)
+            {
+            edges[i * length + j] = latency;
+            unscheduledPredecessors[j]++;
+            }
+         }
+      }
+
+   // Priority is the length of the longest latency path to the end of the region
+   //
+   int32_t *height = new (region) int32_t[length];
+   for (int32_t i = length - 1; i >= 0; --i)
+      {
+      height[i] = getLatency(effects[i]);
+      for (int32_t j = i + 1; j < length; ++j)
+         {
+         if (edges[i * length + j] >= 0)
+            height[i] = std::max(height[i], edges[i * length + j] + height[j]);
+         }
+      }
+
+   int32_t *readyCycle = new (region) int32_t[length];
+   int32_t *order = new (region) int32_t[length];
+   bool *scheduled = new (region) bool[length];
+   memset(readyCycle, 0, length * sizeof(int32_t));
+   memset(scheduled, 0, length * sizeof(bool));
+
+   int32_t numScheduled = 0;
+   int32_t cycle = 0;
+   while (numScheduled < length)
+      {
+      uint32_t busyPorts = 0;
+      for (int32_t issued = 0; issued < _model->_issueWidth; ++issued)
+         {
+         int32_t best = -1;
+         uint32_t bestPorts = 0;
+         for (int32_t i = 0; i < length; ++i)
+            {
+            if (scheduled[i] || unscheduledPredecessors[i] > 0 || readyCycle[i] > cycle)
+               continue;
+
+            uint32_t ports = _model->_ports[effects[i]._class];
+            if (ports == 0)
+               ports = ~(uint32_t)0;
+            ports &= ~busyPorts;
+
+            if (ports != 0 && (best == -1 || height[i] > height[best]))
+               {
+               best = i;
+               bestPorts = ports;
+               }
+            }
+
+         if (best == -1)
+            break;
+
+         busyPorts |= bestPorts & (~bestPorts + 1);
+         scheduled[best] = true;
+         order[numScheduled++] = best;
+
+         for (int32_t j = best + 1; j < length; ++j)
+            {
+            int32_t latency = edges[best * length + j];
+            if (latency >= 0)
+               {
+               unscheduledPredecessors[j]--;
+               readyCycle[j] = std::max(readyCycle[j], cycle + latency);
+               }
+            }
+         }
+      cycle++;
+      }
+
+   bool reordered = false;
+   for (int32_t i = 0; i < length && !reordered; ++i)
+      reordered = (order[i] != i);
+
+   if (!reordered)
+      return false;
+
+   if (comp()->getOption(TR_TraceCG))
+      traceMsg(comp(), "Scheduled %d instructions from " POINTER_PRINTF_FORMAT " in %d cycles\n", length, first, cycle);
+
+   cursor = first->getPrev();
+   for (int32_t i = 0; i < length; ++i)
+      {
+      TR::Instruction *instr = instructions[order[i]];
+      if (cursor->getNext() != instr)
+         instr->move(cursor);
+      cursor = instr;
+      }
+
+   return true;
+   }
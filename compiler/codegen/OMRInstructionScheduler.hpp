@@ -0,0 +1,181 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_INSTRUCTIONSCHEDULER_INCL
+#define OMR_INSTRUCTIONSCHEDULER_INCL
+
+/*
+ * The following #define and typedef must appear before any #includes in this file
+ */
+#ifndef OMR_INSTRUCTIONSCHEDULER_CONNECTOR
+#define OMR_INSTRUCTIONSCHEDULER_CONNECTOR
+namespace OMR { class InstructionScheduler; }
+namespace OMR { typedef OMR::InstructionScheduler InstructionSchedulerConnector; }
+#endif
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "infra/Annotations.hpp"
+
+namespace TR { class CodeGenerator; }
+namespace TR { class Compilation; }
+namespace TR { class Instruction; }
+namespace TR { class InstructionScheduler; }
+
+namespace OMR
+{
+
+/**
+ * \brief
+ *    List scheduler over the instruction stream after register assignment.
+ *
+ * \details
+ *    The instruction stream is cut into regions at every instruction the
+ *    target does not describe (labels, branches, calls, instructions with
+ *    register dependencies, ...). Within a region a dependence graph is built
+ *    from the real registers, condition flags and memory each instruction
+ *    reads and writes, and instructions are issued cycle by cycle in order of
+ *    decreasing critical path length, subject to the issue width and
+ *    execution ports of the target's machine model.
+ *
+ *    Memory is treated as a single resource: loads may be reordered with
+ *    respect to each other but never across a store.
+ *
+ *    The base class describes no instruction, so targets without a machine
+ *    model are left untouched.
+ */
+class OMR_EXTENSIBLE InstructionScheduler
+   {
+   public:
+
+   TR_ALLOC(TR_Memory::UnknownType)
+
+   InstructionScheduler(TR::Compilation* comp);
+
+   TR::InstructionScheduler* self();
+
+   TR::CodeGenerator* cg() const;
+   TR::Compilation* comp() const;
+
+   /** \brief
+    *     Schedules every region of the instruction stream.
+    *
+    *  \return
+    *     true if any instruction was moved; false otherwise.
+    */
+   bool perform();
+
+   enum InstructionClass
+      {
+      IntegerALU,
+      IntegerMultiply,
+      IntegerDivide,
+      Load,
+      Store,
+      FloatingPointAdd,
+      FloatingPointMultiply,
+      FloatingPointDivide,
+      VectorALU,
+      VectorMultiply,
+      NumInstructionClasses
+      };
+
+   /**
+    * \brief
+    *    Latencies and execution ports of one microarchitecture.
+    */
+   struct MachineModel
+      {
+      const char *_name;
+      int32_t     _issueWidth;                        ///< instructions issued per cycle
+      uint8_t     _latency[NumInstructionClasses];    ///< cycles until the result can be used
+      uint32_t    _ports[NumInstructionClasses];      ///< mask of the ports that execute the class
+      };
+
+   protected:
+
+   static const int32_t MaxResources = 128;
+
+   /**
+    * \brief
+    *    Registers and other machine resources (condition flags) an instruction
+    *    reads or writes, numbered by the target.
+    */
+   class ResourceSet
+      {
+      public:
+      ResourceSet() { _bits[0] = _bits[1] = 0; }
+      void set(int32_t r) { _bits[r >> 6] |= ((uint64_t)1) << (r & 63); }
+      bool intersects(const ResourceSet &other) const { return (_bits[0] & other._bits[0]) || (_bits[1] & other._bits[1]); }
+      private:
+      uint64_t _bits[2];
+      };
+
+   struct InstructionEffects
+      {
+      InstructionEffects() : _class(IntegerALU), _readsMemory(false), _writesMemory(false) {}
+
+      InstructionClass _class;
+      ResourceSet      _defs;
+      ResourceSet      _uses;
+      bool             _readsMemory;
+      bool             _writesMemory;
+      };
+
+   /** \brief
+    *     Answers the machine model of the processor being compiled for.
+    *
+    *  \return
+    *     The model, or NULL if instructions should not be scheduled.
+    */
+   virtual const MachineModel *getMachineModel() { return NULL; }
+
+   /** \brief
+    *     Describes what an instruction reads and writes.
+    *
+    *  \param instr
+    *     The instruction to describe.
+    *
+    *  \param effects
+    *     Filled in with the class and effects of \p instr.
+    *
+    *  \return
+    *     true if \p instr may be moved within its region; false if it must
+    *     stay in place and end the region.
+    */
+   virtual bool getEffects(TR::Instruction *instr, InstructionEffects &effects) { return false; }
+
+   private:
+
+   bool scheduleRegion(TR::Instruction *first, int32_t length, InstructionEffects *effects);
+   int32_t getLatency(const InstructionEffects &effects);
+
+   /// Longer runs of movable instructions are split to bound the quadratic dependence graph construction
+   static const int32_t MaxRegionLength = 128;
+
+   TR::Compilation* _comp;
+   TR::CodeGenerator* _cg;
+   const MachineModel* _model;
+   };
+
+}
+
+#endif
@@ -54,10 +54,13 @@
 #include "ilgen/IlGenRequest.hpp"
 #include "ilgen/IlGeneratorMethodDetails.hpp"
 #include "infra/Assert.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
 #include "infra/String.hpp"
 #include "ras/Debug.hpp"
 #include "env/SystemSegmentProvider.hpp"
 #include "env/DebugSegmentProvider.hpp"
+#include "env/SegmentPool.hpp"
 #include "omrformatconsts.h"
 #include "runtime/CodeCacheManager.hpp"
 
@@ -132,6 +135,154 @@ generatePerfToolEntry(uint8_t *startPC, uint8_t *endPC, const char *sig, const c
 #include "p/codegen/PPCTableOfConstants.hpp"
 #endif
 
+/*
+ * Scratch memory segments kept warm between compilations.
+ *
+ * A compilation takes an idle cache for as long as it runs and hands it back
+ * when it is done, so every thread that is compiling works with a cache of its
+ * own and no locking is needed on the allocation path. The segments a cache
+ * retains are trimmed to the resident size when it is handed back, which
+ * returns the pages of the rest to the operating system but keeps them mapped.
+ */
+namespace {
+
+struct WarmSegmentCache
+   {
+   WarmSegmentCache(size_t segmentSize, size_t poolSize, size_t residentSize, TR::RawAllocator rawAllocator) :
+      _systemSegmentProvider(segmentSize, rawAllocator),
+      _segmentPool(_systemSegmentProvider, poolSize, residentSize, rawAllocator),
+      _next(NULL)
+      {
+      }
+
+   TR::SystemSegmentProvider _systemSegmentProvider;
+   TR::SegmentPool _segmentPool;
+   WarmSegmentCache *_next;
+   };
+
+TR::Monitor *warmSegmentCacheMonitor = NULL;
+WarmSegmentCache *idleWarmSegmentCaches = NULL;
+TR::SegmentPool::Statistics warmSegmentCacheStatistics; // of the caches that have been freed
+
+const size_t scratchSegmentSize = 1 << 16;
+
+// The caller must hold warmSegmentCacheMonitor or be the only thread left
+void
+freeWarmSegmentCache(WarmSegmentCache *cache)
+   {
+   const TR::SegmentPool::Statistics &statistics = cache->_segmentPool.statistics();
+   warmSegmentCacheStatistics._requests += statistics._requests;
+   warmSegmentCacheStatistics._recycled += statistics._recycled;
+   warmSegmentCacheStatistics._released += statistics._released;
+   warmSegmentCacheStatistics._trimmed += statistics._trimmed;
+
+   TR::RawAllocator rawAllocator;
+   cache->~WarmSegmentCache();
+   rawAllocator.deallocate(cache);
+   }
+
+class WarmSegmentCacheLease
+   {
+public:
+   WarmSegmentCacheLease(TR::RawAllocator rawAllocator) :
+      _rawAllocator(rawAllocator),
+      _cache(NULL)
+      {
+      if (!warmSegmentCacheMonitor
+          || TR::Options::getCmdLineOptions()->getOption(TR_EnableScratchMemoryDebugging))
+         return;
+
+         {
+         OMR::CriticalSection takeCache(warmSegmentCacheMonitor);
+         _cache = idleWarmSegmentCaches;
+         if (_cache)
+            idleWarmSegmentCaches = _cache->_next;
+         }
+
+      if (!_cache)
+         {
+         size_t const poolSize = TR::Options::getWarmSegmentCacheSize() / scratchSegmentSize;
+         size_t const residentSize = TR::Options::getWarmSegmentCacheResidentSize() / scratchSegmentSize;
+         void *storage = _rawAllocator.allocate(sizeof(WarmSegmentCache), std::nothrow);
+         if (storage)
+            _cache = new (storage) WarmSegmentCache(scratchSegmentSize, poolSize, residentSize, _rawAllocator);
+         }
+
+      if (_cache)
+         _cache->_segmentPool.resetHighWaterMark();
+      }
+
+   ~WarmSegmentCacheLease()
+      {
+      if (!_cache)
+         return;
+
+      // Memory of a region that outlived the compilation can't be reused
+      // safely, so such a cache is freed along with the region's segments
+      bool const reusable = _cache->_segmentPool.bytesInUse() == 0;
+      if (reusable)
+         _cache->_segmentPool.trim();
+
+      OMR::CriticalSection returnCache(warmSegmentCacheMonitor);
+      if (!reusable)
+         {
+         freeWarmSegmentCache(_cache);
+         return;
+         }
+
+      _cache->_next = idleWarmSegmentCaches;
+      idleWarmSegmentCaches = _cache;
+      }
+
+   TR::SegmentPool *segmentPool() { return _cache ? &_cache->_segmentPool : NULL; }
+
+private:
+   TR::RawAllocator _rawAllocator;
+   WarmSegmentCache *_cache;
+   };
+
+}
+
+static void
+initializeWarmSegmentCaches()
+   {
+   if (TR::Options::getCmdLineOptions()->getOption(TR_DisableWarmSegmentCache)
+       || TR::Options::getWarmSegmentCacheSize() < scratchSegmentSize)
+      return;
+
+   memset(&warmSegmentCacheStatistics, 0, sizeof(warmSegmentCacheStatistics));
+   warmSegmentCacheMonitor = TR::Monitor::create("WarmSegmentCacheMonitor");
+   }
+
+static void
+freeWarmSegmentCaches()
+   {
+   if (!warmSegmentCacheMonitor)
+      return;
+
+   while (idleWarmSegmentCaches)
+      {
+      WarmSegmentCache *cache = idleWarmSegmentCaches;
+      idleWarmSegmentCaches = cache->_next;
+      freeWarmSegmentCache(cache);
+      }
+
+   if (TR::Options::getVerboseOption(TR_VerbosePerformance))
+      {
+      TR_VerboseLog::writeLineLocked(
+         TR_Vlog_MEMORY,
+         "warm segment caches: %llu segment requests, %llu recycled, %llu released, %llu trimmed",
+         static_cast<unsigned long long>(warmSegmentCacheStatistics._requests),
+         static_cast<unsigned long long>(warmSegmentCacheStatistics._recycled),
+         static_cast<unsigned long long>(warmSegmentCacheStatistics._released),
+         static_cast<unsigned long long>(warmSegmentCacheStatistics._trimmed)
+         );
+      }
+
+   TR::Monitor::destroy(warmSegmentCacheMonitor);
+   warmSegmentCacheMonitor = NULL;
+   }
+
 int32_t commonJitInit(OMR::FrontEnd &fe, char *cmdLineOptions)
    {
    auto jitConfig = fe.jitConfig();
@@ -147,6 +298,7 @@ int32_t commonJitInit(OMR::FrontEnd &fe, char *cmdLineOptions)
    TR::Options::setCanJITCompile(true);
    TR::Options::getCmdLineOptions()->setOption(TR_NoRecompile);
    TR::CompilationController::init(NULL);
+   initializeWarmSegmentCaches();
 
    void *pseudoTOC = NULL;
 #if defined(TR_TARGET_POWER)
@@ -177,6 +329,11 @@ int32_t commonJitInit(OMR::FrontEnd &fe, char *cmdLineOptions)
    return 0;
    }
 
+void commonJitShutdown()
+   {
+   freeWarmSegmentCaches();
+   }
+
 int32_t init_options(TR::JitConfig *jitConfig, char *cmdLineOptions)
    {
    OMR::FrontEnd *fe = OMR::FrontEnd::instance();
@@ -276,12 +433,15 @@ compileMethodFromDetails(
    OMR::FrontEnd &fe = OMR::FrontEnd::singleton();
    auto jitConfig = fe.jitConfig();
    TR::RawAllocator rawAllocator;
-   TR::SystemSegmentProvider defaultSegmentProvider(1 << 16, rawAllocator);
-   TR::DebugSegmentProvider debugSegmentProvider(1 << 16, rawAllocator);
-   TR::SegmentAllocator &scratchSegmentProvider =
+   TR::SystemSegmentProvider defaultSegmentProvider(scratchSegmentSize, rawAllocator);
+   TR::DebugSegmentProvider debugSegmentProvider(scratchSegmentSize, rawAllocator);
+   WarmSegmentCacheLease warmSegmentCache(rawAllocator);
+   TR::SegmentProvider &scratchSegmentProvider =
+      warmSegmentCache.segmentPool() ?
+         static_cast<TR::SegmentProvider &>(*warmSegmentCache.segmentPool()) :
       TR::Options::getCmdLineOptions()->getOption(TR_EnableScratchMemoryDebugging) ?
-         static_cast<TR::SegmentAllocator &>(debugSegmentProvider) :
-         static_cast<TR::SegmentAllocator &>(defaultSegmentProvider);
+         static_cast<TR::SegmentProvider &>(debugSegmentProvider) :
+         static_cast<TR::SegmentProvider &>(defaultSegmentProvider);
    TR::Region dispatchRegion(scratchSegmentProvider, rawAllocator);
    TR_Memory trMemory(*fe.persistentMemory(), dispatchRegion);
    TR_ResolvedMethod & compilee = *((TR_ResolvedMethod *)details.getMethod());
@@ -400,10 +560,15 @@ compileMethodFromDetails(
                compiler.getOption(TR_PerfTool)
             || compiler.getOption(TR_EmitExecutableELFFile)
             || compiler.getOption(TR_EmitRelocatableELFFile)
+            || compiler.getOption(TR_EmitJitDump)
             )
             {
             TR::CodeCacheManager &codeCacheManager(fe.codeCacheManager());
             TR::CodeGenerator &codeGenerator(*compiler.cg());
+            if (codeCacheManager.getJitDump())
+               {
+               codeGenerator.writeJitDumpInfo(codeCacheManager.getJitDump(), startPC, codeGenerator.getCodeLength(), compiler.signature());
+               }
             codeCacheManager.registerCompiledMethod(compiler.externalName(), startPC, codeGenerator.getCodeLength());
             if (compiler.getOption(TR_EmitRelocatableELFFile))
                {
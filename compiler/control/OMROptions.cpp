@@ -275,6 +275,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableCheapWarmOpts",               "O\tenable cheap warm optimizations",               SET_OPTION_BIT(TR_DisableCheapWarmOpts), "F"},
    {"disableCheckcastAndProfiledGuardCoalescer", "O\tdisable checkcast and profiled guard  coalescion optimization ",   SET_OPTION_BIT(TR_DisableCheckcastAndProfiledGuardCoalescer), "F"},
    {"disableCHOpts",                      "O\tdisable CHTable based optimizations",            SET_OPTION_BIT(TR_DisableCHOpts), "F"},
+   {"disableChunkedDataFlowSets",         "O\tnever use chunked bit vectors for liveness and reaching definitions", SET_OPTION_BIT(TR_DisableChunkedDataFlowSets), "F"},
    {"disableClassChainSharing",            "M\tdisable class sharing", RESET_OPTION_BIT(TR_EnableClassChainSharing), "F", NOT_IN_SUBSET},
    {"disableClassChainValidationCaching",  "M\tdisable class chain validation caching", RESET_OPTION_BIT(TR_EnableClassChainValidationCaching), "F", NOT_IN_SUBSET},
    {"disableClearCodeCacheFullFlag",      "I\tdisable the re-enabling of full code cache when a method body is freed.", SET_OPTION_BIT(TR_DisableClearCodeCacheFullFlag),"F", NOT_IN_SUBSET},
@@ -385,6 +386,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableInliningDuringVPAtWarm",       "O\tdisable inlining during VP for warm bodies",    SET_OPTION_BIT(TR_DisableInliningDuringVPAtWarm), "F"},
    {DisableInliningOfNativesString,       "O\tdisable inlining of natives",                    SET_OPTION_BIT(TR_DisableInliningOfNatives), "F"},
    {"disableInnerPreexistence",           "O\tdisable inner preexistence",                     TR::Options::disableOptimization, innerPreexistence, 0, "P"},
+   {"disableInstructionScheduling",       "O\tdisable instruction scheduling phase",           SET_OPTION_BIT(TR_DisableInstructionScheduling), "F"},
    {"disableIntegerCompareSimplification",      "O\tdisable byte/short/int/long compare simplification  ",      SET_OPTION_BIT(TR_DisableIntegerCompareSimplification), "F"},
    {"disableInterfaceCallCaching",                          "O\tdisable interfaceCall caching   ",      SET_OPTION_BIT(TR_disableInterfaceCallCaching), "F"},
    {"disableInterfaceInlining",           "O\tdisable merge new",                              SET_OPTION_BIT(TR_DisableInterfaceInlining), "F"},
@@ -586,6 +588,8 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
                                           RESET_OPTION_BIT(TR_EnableVirtualScratchMemory), "F", NOT_IN_SUBSET},
    {"disableVMCSProfiling",               "O\tdisable VM data for virtual call sites", SET_OPTION_BIT(TR_DisableVMCSProfiling), "F", NOT_IN_SUBSET},
    {"disableVSSStackCompaction",          "O\tdisable VariableSizeSymbol stack compaction", SET_OPTION_BIT(TR_DisableVSSStackCompaction), "F"},
+   {"disableWarmSegmentCache",            "M\tallocate scratch memory for each compilation from the system instead of from segments kept between compilations",
+                                          SET_OPTION_BIT(TR_DisableWarmSegmentCache), "F", NOT_IN_SUBSET},
    {"disableWriteBarriersRangeCheck",     "O\tdisable adding range check to write barriers",   SET_OPTION_BIT(TR_DisableWriteBarriersRangeCheck), "F"},
    {"disableWrtBarSrcObjCheck",           "O\tdisable to not check srcObj location for wrtBar in gc", SET_OPTION_BIT(TR_DisableWrtBarSrcObjCheck), "F"},
    {"disableZ10",                         "O\tdisable z10 support",                            SET_OPTION_BIT(TR_DisableZ10), "F"},
@@ -655,9 +659,11 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableBranchPreload",                "O\tenable return branch preload for each method (for func testing)",  SET_OPTION_BIT(TR_EnableBranchPreload), "F"},
    {"enableCFGEdgeCounters",              "O\tenable CFG edge counters to keep track of taken and non taken branches in compiled code",      SET_OPTION_BIT(TR_EnableCFGEdgeCounters), "F"},
    {"enableCheapWarmOpts",                "O\tenable cheap warm optimizations", RESET_OPTION_BIT(TR_DisableCheapWarmOpts), "F"},
+   {"enableChunkedDataFlowSets",          "O\talways use chunked bit vectors for liveness and reaching definitions", SET_OPTION_BIT(TR_EnableChunkedDataFlowSets), "F"},
    {"enableClassChainSharing",            "M\tenable class sharing", SET_OPTION_BIT(TR_EnableClassChainSharing), "F", NOT_IN_SUBSET},
    {"enableClassChainValidationCaching",  "M\tenable class chain validation caching", SET_OPTION_BIT(TR_EnableClassChainValidationCaching), "F", NOT_IN_SUBSET},
    {"enableCodeCacheConsolidation",       "M\tenable code cache consolidation", SET_OPTION_BIT(TR_EnableCodeCacheConsolidation), "F", NOT_IN_SUBSET},
+   {"enableCodeCacheHugePages",           "M\tback code cache segments with 2MB huge pages where the OS supports it", SET_OPTION_BIT(TR_EnableCodeCacheHugePages), "F", NOT_IN_SUBSET},
    {"enableColdCheapTacticalGRA",         "O\tenable cold cheap tactical GRA", SET_OPTION_BIT(TR_EnableColdCheapTacticalGRA), "F"},
    {"enableCompilationSpreading",         "C\tenable adding spreading invocations to methods before compiling", SET_OPTION_BIT(TR_EnableCompilationSpreading), "F", NOT_IN_SUBSET},
    {"enableCompilationThreadThrottlingDuringStartup", "M\tenable compilation thread throttling during startup", SET_OPTION_BIT(TR_EnableCompThreadThrottlingDuringStartup), "F", NOT_IN_SUBSET },
@@ -701,6 +707,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableIprofilerChanges",             "O\tenable iprofiler changes", SET_OPTION_BIT(TR_EnableIprofilerChanges), "F"},
    {"enableIVTT",                         "O\tenable IV Type Transformation", TR::Options::enableOptimization, IVTypeTransformation, 0, "P"},
    {"enableJCLInline",                    "O\tenable JCL Integer and Long methods inlining", SET_OPTION_BIT(TR_EnableJCLInline), "F"},
+   {"enableJitDump",                      "I\tenable the generation of a jitdump file describing compiled code for perf", SET_OPTION_BIT(TR_EmitJitDump), "F", NOT_IN_SUBSET},
    {"enableJITHelpershashCodeImpl",       "O\tenable java version of object hashCode()", SET_OPTION_BIT(TR_EnableJITHelpershashCodeImpl), "F"},
    {"enableJITHelpersoptimizedClone",     "O\tenable java version of object clone()", SET_OPTION_BIT(TR_EnableJITHelpersoptimizedClone), "F"},
    {"enableJITServerFollowRemoteCompileWithLocalCompile", "O\tenable JITServer to perform local compilations for its remotely compiled methods", SET_OPTION_BIT(TR_JITServerFollowRemoteCompileWithLocalCompile), "F"},
@@ -906,6 +913,14 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
         TR::Options::set32BitSignedNumeric, offsetof(OMR::Options,_lastOptSubIndex), 0, "F%d"},
    {"lastOptTransformationIndex=", "O<nnn>\tindex of the last optimization transformation to perform",
         TR::Options::set32BitSignedNumeric, offsetof(OMR::Options,_lastOptTransformationIndex), 0, "F%d"},
+   {"linearScanGRAMaxOptLevel=cold",  "O\tuse linear scan register assignment in GRA at cold and lower levels",
+        TR::Options::set32BitValue, offsetof(OMR::Options, _linearScanGRAMaxOptLevel), cold, "F"},
+   {"linearScanGRAMaxOptLevel=hot",   "O\tuse linear scan register assignment in GRA at hot and lower levels",
+        TR::Options::set32BitValue, offsetof(OMR::Options, _linearScanGRAMaxOptLevel), hot, "F"},
+   {"linearScanGRAMaxOptLevel=noOpt", "O\tuse linear scan register assignment in GRA at noOpt level",
+        TR::Options::set32BitValue, offsetof(OMR::Options, _linearScanGRAMaxOptLevel), noOpt, "F"},
+   {"linearScanGRAMaxOptLevel=warm",  "O\tuse linear scan register assignment in GRA at warm and lower levels",
+        TR::Options::set32BitValue, offsetof(OMR::Options, _linearScanGRAMaxOptLevel), warm, "F"},
    {"lockReserveClass=",  "O{regex}\tenable reserving locks for specified classes", TR::Options::setRegex, offsetof(OMR::Options, _lockReserveClass), 0, "P"},
    {"lockVecRegs=",    "M<nn>\tThe number of vector register to lock (from end) Range: 0-32", TR::Options::setStaticNumeric, (intptr_t)&OMR::Options::_numVecRegsToLock, 0, "F%d", NOT_IN_SUBSET},
    {"log=",               "L<filename>\twrite log output to filename",
@@ -1284,6 +1299,10 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"virtualMemoryCheckFrequencySec=", "O<nnn>\tFrequency of the virtual memory check (only applicable for 32 bit systems)",
         TR::Options::setStaticNumeric, (intptr_t)&OMR::Options::_virtualMemoryCheckFrequencySec, 0, "F%d", NOT_IN_SUBSET},
    {"waitOnCompilationQueue",        "M\tPerform synchronous wait until compilation queue empty. Primarily for use with Compiler.command", SET_OPTION_BIT(TR_WaitBit), "F", NOT_IN_SUBSET},
+   {"warmSegmentCacheResidentSize=", "M<nnn>\tscratch memory, in KB, that a warm segment cache keeps resident between compilations",
+                                         TR::Options::setStaticNumericKBAdjusted, (intptr_t)&OMR::Options::_warmSegmentCacheResidentSize, 0, "F%d (bytes)", NOT_IN_SUBSET},
+   {"warmSegmentCacheSize=", "M<nnn>\tscratch memory, in KB, that a warm segment cache retains between compilations",
+                                         TR::Options::setStaticNumericKBAdjusted, (intptr_t)&OMR::Options::_warmSegmentCacheSize, 0, "F%d (bytes)", NOT_IN_SUBSET},
    {"x86HLE",         "C\tEnable haswell hardware lock elision", SET_OPTION_BIT(TR_X86HLE), "F"},
    {"x86UseMFENCE",   "M\tEnable to use mfence to handle volatile store", SET_OPTION_BIT(TR_X86UseMFENCE), "F", NOT_IN_SUBSET},
    {NULL}
@@ -1694,6 +1713,8 @@ TR::SimpleRegex *OMR::Options::_debugCounterInsertMethod = NULL;
 
 size_t OMR::Options::_scratchSpaceLimit = 0;
 size_t OMR::Options::_scratchSpaceLowerBound = 0;
+size_t OMR::Options::_warmSegmentCacheSize = 4 * 1024 * 1024; // 4MB
+size_t OMR::Options::_warmSegmentCacheResidentSize = 1024 * 1024; // 1MB
 
 uint32_t OMR::Options::_minBytesToLeaveAllocatedInSharedPool = 1024*512; // 512kb
 uint32_t OMR::Options::_maxBytesToLeaveAllocatedInSharedPool = 1024*1024*25; //25MB
@@ -2588,6 +2609,7 @@ OMR::Options::jitPreProcess()
    _inlinerCGVeryColdBorderFrequency = -1;
    _alwaysWorthInliningThreshold = 15;
    _maxLimitedGRACandidates = TR_MAX_LIMITED_GRA_CANDIDATES;
+   _linearScanGRAMaxOptLevel = -1;
    _maxLimitedGRARegs = TR_MAX_LIMITED_GRA_REGS;
    _counterBucketGranularity = 2;
    _minCounterFidelity = INT_MIN;
@@ -187,7 +187,7 @@ enum TR_CompilationOptions
    TR_DisableAotAtCheapWarm               = 0x00001000 + 3,
    TR_Profile                             = 0x00002000 + 3,
    TR_DisableAsyncCompilation             = 0x00004000 + 3,
-   // Available                           = 0x00008000 + 3,
+   TR_DisableWarmSegmentCache             = 0x00008000 + 3,
    // Available                           = 0x00010000 + 3,
    TR_EnableJITServerHeuristics           = 0x00020000 + 3,
    TR_SoftFailOnAssume                    = 0x00040000 + 3,
@@ -358,8 +358,8 @@ enum TR_CompilationOptions
 
    // Option word 9
    //
-   // Available                           = 0x00000020 + 9,
-   // Available                           = 0x00000040 + 9,
+   TR_DisableInstructionScheduling        = 0x00000020 + 9,
+   TR_EnableCodeCacheHugePages            = 0x00000040 + 9,
    TR_DisableTLHPrefetch                  = 0x00000080 + 9,
    TR_DisableJProfilerThread              = 0x00000100 + 9,
    TR_DisableIProfilerThread              = 0x00000200 + 9,
@@ -381,15 +381,15 @@ enum TR_CompilationOptions
    TR_CountWriteBarriersRT                = 0x02000000 + 9,
    TR_DisableNoServerDuringStartup        = 0x04000000 + 9,  // set TR_NoOptServer during startup and insert GCR trees
    TR_BreakOnNew                          = 0x08000000 + 9,
-   // Available                           = 0x10000000 + 9,
+   TR_EmitJitDump                         = 0x10000000 + 9,
    // Available                           = 0x20000000 + 9,
    // Available                           = 0x40000000 + 9,
    // Available                           = 0x80000000 + 9,
 
    // Option word 10
    //
-   // Available                           = 0x00000020 + 10,
-   // Available                           = 0x00000040 + 10,
+   TR_EnableChunkedDataFlowSets           = 0x00000020 + 10,
+   TR_DisableChunkedDataFlowSets          = 0x00000040 + 10,
    // Available                           = 0x00000080 + 10,
    TR_FirstLevelProfiling                 = 0x00000100 + 10,
    // Available                           = 0x00000200 + 10,
@@ -1666,6 +1666,7 @@ public:
    void    setInlinerCGVeryColdBorderFrequency(int32_t n) { _inlinerCGVeryColdBorderFrequency = n; }
    int32_t getAlwaysWorthInliningThreshold() const { return _alwaysWorthInliningThreshold; }
    int32_t getMaxLimitedGRACandidates()   { return _maxLimitedGRACandidates; }
+   int32_t getLinearScanGRAMaxOptLevel()  { return _linearScanGRAMaxOptLevel; }
    int32_t getMaxLimitedGRARegs()         { return _maxLimitedGRARegs; }
    int32_t getNumLimitedGRARegsWithheld();
 
@@ -1687,6 +1688,8 @@ public:
    static void setScratchSpaceLimit(size_t newScratchSpaceLimit) { _scratchSpaceLimit = newScratchSpaceLimit; }
    static size_t getScratchSpaceLowerBound() { return _scratchSpaceLowerBound; }
    static void setScratchSpaceLowerBound(size_t scratchSpaceLowerBound) { _scratchSpaceLowerBound = scratchSpaceLowerBound; }
+   static size_t getWarmSegmentCacheSize() { return _warmSegmentCacheSize; }
+   static size_t getWarmSegmentCacheResidentSize() { return _warmSegmentCacheResidentSize; }
 
 
    static int32_t getAggressivityLevel() { return _aggressivenessLevel; }
@@ -1751,6 +1754,8 @@ public:
 
    static size_t _scratchSpaceLimit;
    static size_t _scratchSpaceLowerBound;
+   static size_t _warmSegmentCacheSize;          // scratch memory retained between compilations by each warm segment cache
+   static size_t _warmSegmentCacheResidentSize;  // of which this much is kept resident
    static uint32_t _minBytesToLeaveAllocatedInSharedPool; // 0 to disable the feature and revert to old behavior
    static uint32_t _maxBytesToLeaveAllocatedInSharedPool; // 0 to disable the feature and revert to old behavior
 
@@ -2297,6 +2302,7 @@ protected:
    bool                        _insertGCRTrees; // more like a flag than an option; cannot be set by user
 
    int32_t                     _maxLimitedGRACandidates;
+   int32_t                     _linearScanGRAMaxOptLevel; // highest opt level at which GRA assigns by linear scan, -1 for none
    int32_t                     _maxLimitedGRARegs;
 
    int32_t                     _enableGPU;
@@ -23,6 +23,7 @@
 #include "env/Environment.hpp"
 #include "env/CPU.hpp"
 #include "env/defines.h"
+#include "infra/BitVectorKernels.hpp"
 
 
 OMR::CompilerEnv::CompilerEnv(
@@ -56,6 +57,8 @@ OMR::CompilerEnv::initialize()
 
    om.initialize();
 
+   TR_BitVectorKernels::initialize();
+
    _initialized = true;
    }
 
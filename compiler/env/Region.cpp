@@ -24,11 +24,16 @@
 #include "env/Region.hpp"
 #include "infra/ReferenceWrapper.hpp"
 #include "env/TRMemory.hpp"
+#include "infra/Bit.hpp"
 
 namespace TR {
 
 Region::Region(TR::SegmentProvider &segmentProvider, TR::RawAllocator rawAllocator) :
+   _freeLists(NULL),
    _bytesAllocated(0),
+   _bytesReused(0),
+   _bytesFreed(0),
+   _peakBytesInUse(0),
    _segmentProvider(segmentProvider),
    _rawAllocator(rawAllocator),
    _initialSegment(_initialSegmentArea.data, INITIAL_SEGMENT_SIZE),
@@ -38,7 +43,11 @@ Region::Region(TR::SegmentProvider &segmentProvider, TR::RawAllocator rawAllocat
    }
 
 Region::Region(const Region &prototype) :
+   _freeLists(NULL),
    _bytesAllocated(0),
+   _bytesReused(0),
+   _bytesFreed(0),
+   _peakBytesInUse(0),
    _segmentProvider(prototype._segmentProvider),
    _rawAllocator(prototype._rawAllocator),
    _initialSegment(_initialSegmentArea.data, INITIAL_SEGMENT_SIZE),
@@ -77,6 +86,12 @@ void *
 Region::allocate(size_t const size, void *hint)
    {
    size_t const roundedSize = round(size);
+   if (_freeLists && roundedSize > 0)
+      {
+      void *recycled = allocateFromFreeList(roundedSize);
+      if (recycled)
+         return recycled;
+      }
    if (_currentSegment.get().remaining() >= roundedSize)
       {
       _bytesAllocated += roundedSize;
@@ -91,8 +106,66 @@ Region::allocate(size_t const size, void *hint)
    }
 
 void
-Region::deallocate(void * allocation, size_t) throw()
+Region::deallocate(void * allocation, size_t size) throw()
+   {
+   if (_freeLists && allocation && size > 0)
+      addToFreeList(allocation, round(size));
+   }
+
+void *
+Region::allocateFromFreeList(size_t roundedSize)
    {
+   size_t sizeClass;
+   if (roundedSize <= MAX_SMALL_BLOCK_SIZE)
+      {
+      sizeClass = roundedSize / 16 - 1;
+      }
+   else
+      {
+      // Any block in the class of the next power of two is large enough
+      size_t log2 = 64 - leadingZeroes(static_cast<uint64_t>(roundedSize - 1));
+      sizeClass = NUM_SMALL_SIZE_CLASSES + log2 - MAX_SMALL_BLOCK_SIZE_LOG2 - 1;
+      if (sizeClass >= NUM_SIZE_CLASSES)
+         return NULL;
+      }
+
+   FreeBlock *block = _freeLists[sizeClass];
+   if (!block)
+      return NULL;
+   _freeLists[sizeClass] = block->_next;
+   _bytesReused += roundedSize;
+   return block;
+   }
+
+void
+Region::addToFreeList(void *allocation, size_t roundedSize)
+   {
+   // Deallocations are the only points where the bytes in use can drop
+   size_t const inUse = bytesInUse();
+   if (inUse > _peakBytesInUse)
+      _peakBytesInUse = inUse;
+   _bytesFreed += roundedSize;
+
+   size_t sizeClass;
+   if (roundedSize <= MAX_SMALL_BLOCK_SIZE)
+      {
+      sizeClass = roundedSize / 16 - 1;
+      }
+   else
+      {
+      // A block only goes in the class of the largest power of two it can hold
+      size_t log2 = 63 - leadingZeroes(static_cast<uint64_t>(roundedSize));
+      if (log2 == MAX_SMALL_BLOCK_SIZE_LOG2)
+         sizeClass = NUM_SMALL_SIZE_CLASSES - 1;
+      else if (log2 - MAX_SMALL_BLOCK_SIZE_LOG2 - 1 < NUM_LARGE_SIZE_CLASSES)
+         sizeClass = NUM_SMALL_SIZE_CLASSES + log2 - MAX_SMALL_BLOCK_SIZE_LOG2 - 1;
+      else
+         return;
+      }
+
+   FreeBlock *block = static_cast<FreeBlock *>(allocation);
+   block->_next = _freeLists[sizeClass];
+   _freeLists[sizeClass] = block;
    }
 
 size_t
@@ -135,14 +135,63 @@ public:
       return TR::typed_allocator<T, Region& >(*this);
       }
 
+   /**
+    * @brief Bytes carved out of the region's segments. Memory handed out again
+    * by a recycling region is not counted.
+    */
    size_t bytesAllocated() { return _bytesAllocated; }
+
+   /**
+    * @brief Bytes allocated and not yet deallocated. Only a recycling region
+    * takes deallocations into account.
+    */
+   size_t bytesInUse() { return _bytesAllocated + _bytesReused - _bytesFreed; }
+
+   /**
+    * @brief The largest value bytesInUse() has had.
+    */
+   size_t peakBytesInUse()
+      {
+      size_t const inUse = bytesInUse();
+      return inUse > _peakBytesInUse ? inUse : _peakBytesInUse;
+      }
+
    static size_t initialSize() { return INITIAL_SEGMENT_SIZE; }
+
+protected:
+   /**
+    * @brief A deallocated block on one of the free lists of a recycling region.
+    */
+   struct FreeBlock
+      {
+      FreeBlock *_next;
+      };
+
+   /*
+    * Blocks of up to MAX_SMALL_BLOCK_SIZE bytes are kept in one list per
+    * rounded size; larger ones in one list per power of two, up to
+    * 2^(MAX_SMALL_BLOCK_SIZE_LOG2 + NUM_LARGE_SIZE_CLASSES).
+    */
+   static const size_t MAX_SMALL_BLOCK_SIZE_LOG2 = 8;
+   static const size_t MAX_SMALL_BLOCK_SIZE = 1 << MAX_SMALL_BLOCK_SIZE_LOG2;
+   static const size_t NUM_SMALL_SIZE_CLASSES = MAX_SMALL_BLOCK_SIZE / 16;
+   static const size_t NUM_LARGE_SIZE_CLASSES = 24;
+   static const size_t NUM_SIZE_CLASSES = NUM_SMALL_SIZE_CLASSES + NUM_LARGE_SIZE_CLASSES;
+
+   /// Heads of the free lists by size class, or NULL if deallocated memory is not recycled
+   FreeBlock **_freeLists;
+
 private:
    friend class TR::RegionProfiler;
 
    size_t round(size_t bytes);
+   void *allocateFromFreeList(size_t roundedSize);
+   void addToFreeList(void *allocation, size_t roundedSize);
 
    size_t _bytesAllocated;
+   size_t _bytesReused;
+   size_t _bytesFreed;
+   size_t _peakBytesInUse;
    TR::SegmentProvider &_segmentProvider;
    TR::RawAllocator _rawAllocator;
    TR::MemorySegment _initialSegment;
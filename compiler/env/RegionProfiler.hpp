@@ -39,7 +39,9 @@ namespace TR {
  * This class makes use of the compiler's debug counter facility to record the
  * difference in memory usage for a region and its segment provider between the
  * two points of execution determined by the invocation of its constructor and
- * the invocation of its destructor. The lifetime of the region tracked by the
+ * the invocation of its destructor, as well as the peak number of bytes the
+ * region had in use in between, which only differs from the bytes allocated
+ * for a TR::RecyclingRegion. The lifetime of the region tracked by the
  * profiler object must comprehend the lifetime of the profiler itself. The
  * implementation requires a compilation object in order to determine whether
  * or not the facility is active.
@@ -52,10 +54,15 @@ public:
       _region(region),
       _initialRegionSize(_region.bytesAllocated()),
       _initialSegmentProviderSize(_region._segmentProvider.bytesAllocated()),
+      _initialBytesInUse(_region.bytesInUse()),
+      _enclosingPeakBytesInUse(_region._peakBytesInUse),
       _compilation(compilation)
       {
       if (_compilation.getOption(TR_ProfileMemoryRegions))
          {
+         // Measure the peak from here; the enclosing peak is restored on exit
+         _region._peakBytesInUse = _initialBytesInUse;
+
          va_list args;
          va_start(args, format);
          int len = vsnprintf(_identifier, sizeof(_identifier), format, args);
@@ -87,6 +94,17 @@ public:
                 ),
             static_cast<int32_t>((_region._segmentProvider.bytesAllocated() - _initialSegmentProviderSize) / 1024)
             );
+         size_t const peakBytesInUse = _region.peakBytesInUse();
+         TR::DebugCounter::incStaticDebugCounter(
+            &_compilation,
+            TR::DebugCounter::debugCounterName(
+               &_compilation,
+               "kbytesPeak.details/%s",
+               _identifier
+               ),
+            static_cast<int32_t>((peakBytesInUse - _initialBytesInUse) / 1024)
+            );
+         _region._peakBytesInUse = peakBytesInUse > _enclosingPeakBytesInUse ? peakBytesInUse : _enclosingPeakBytesInUse;
          }
       }
 
@@ -94,6 +112,8 @@ private:
    TR::Region &_region;
    size_t const _initialRegionSize;
    size_t const _initialSegmentProviderSize;
+   size_t const _initialBytesInUse;
+   size_t const _enclosingPeakBytesInUse;
    TR::Compilation &_compilation;
    char _identifier[256];
    };
@@ -19,69 +19,150 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+
 #include "env/SegmentPool.hpp"
 #include "env/MemorySegment.hpp"
 
+#if defined(LINUX) || defined(OSX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 TR::SegmentPool::SegmentPool(TR::SegmentProvider &backingProvider, size_t poolSize, TR::RawAllocator rawAllocator) :
    SegmentProvider(backingProvider.defaultSegmentSize()),
    _poolSize(poolSize),
-   _storedSegments(0),
+   _residentSize(poolSize),
+   _backingProvider(backingProvider),
+   _segments(DequeAllocator(rawAllocator)),
+   _trimmedSegments(0),
+   _bytesInUse(0),
+   _highWaterMark(0)
+   {
+   _statistics._requests = 0;
+   _statistics._recycled = 0;
+   _statistics._released = 0;
+   _statistics._trimmed = 0;
+   }
+
+TR::SegmentPool::SegmentPool(TR::SegmentProvider &backingProvider, size_t poolSize, size_t residentSize, TR::RawAllocator rawAllocator) :
+   SegmentProvider(backingProvider.defaultSegmentSize()),
+   _poolSize(poolSize),
+   _residentSize(residentSize < poolSize ? residentSize : poolSize),
    _backingProvider(backingProvider),
-   _segmentStack(StackContainer(DequeAllocator(rawAllocator)))
+   _segments(DequeAllocator(rawAllocator)),
+   _trimmedSegments(0),
+   _bytesInUse(0),
+   _highWaterMark(0)
    {
+   _statistics._requests = 0;
+   _statistics._recycled = 0;
+   _statistics._released = 0;
+   _statistics._trimmed = 0;
    }
 
 TR::SegmentPool::~SegmentPool() throw()
    {
-   while (!_segmentStack.empty())
+   while (!_segments.empty())
       {
-      TR_ASSERT(_storedSegments > 0, "Too many segments");
-      TR::MemorySegment &topSegment = _segmentStack.top().get();
-      _segmentStack.pop();
-      _backingProvider.release(topSegment);
-      --_storedSegments;
+      TR::MemorySegment &segment = _segments.back().get();
+      _segments.pop_back();
+      _backingProvider.release(segment);
       }
-   TR_ASSERT(0 == _storedSegments, "Lost a segment");
    }
 
 TR::MemorySegment &
 TR::SegmentPool::request(size_t requiredSize)
    {
+   if (requiredSize <= defaultSegmentSize())
+      ++_statistics._requests;
+
+   TR::MemorySegment *segment;
    if (
       requiredSize <= defaultSegmentSize()
-      && !_segmentStack.empty()
+      && !_segments.empty()
       )
       {
-      --_storedSegments;
-      TR_ASSERT(0 <= _storedSegments, "We lost a segment");
-      TR::MemorySegment &recycledSegment = _segmentStack.top().get();
-      _segmentStack.pop();
-      recycledSegment.reset();
-      return recycledSegment;
+      segment = &_segments.back().get();
+      _segments.pop_back();
+      if (_trimmedSegments > _segments.size())
+         _trimmedSegments = _segments.size();
+      segment->reset();
+      ++_statistics._recycled;
       }
-   return _backingProvider.request(requiredSize);
+   else
+      {
+      segment = &_backingProvider.request(requiredSize);
+      }
+
+   _bytesInUse += segment->size();
+   if (_bytesInUse > _highWaterMark)
+      _highWaterMark = _bytesInUse;
+   return *segment;
    }
 
 void
 TR::SegmentPool::release(TR::MemorySegment &segment) throw()
    {
+   _bytesInUse -= segment.size();
    if (
       segment.size() == defaultSegmentSize()
-      && _storedSegments < _poolSize
+      && _segments.size() < _poolSize
       )
       {
       try
          {
-         _segmentStack.push(TR::ref(segment));
-         ++_storedSegments;
+         _segments.push_back(TR::ref(segment));
+         return;
          }
       catch (...)
          {
-         _backingProvider.release(segment);
          }
       }
-   else
+   else if (segment.size() == defaultSegmentSize())
       {
+      ++_statistics._released;
+      }
+   _backingProvider.release(segment);
+   }
+
+size_t
+TR::SegmentPool::bytesAllocated() const throw()
+   {
+   return _highWaterMark;
+   }
+
+void
+TR::SegmentPool::trim() throw()
+   {
+   size_t const excess = _segments.size() > _residentSize ? _segments.size() - _residentSize : 0;
+#if defined(LINUX) || defined(OSX)
+   for (size_t i = _trimmedSegments; i < excess; ++i)
+      {
+      returnPages(_segments[i].get());
+      ++_statistics._trimmed;
+      }
+   if (excess > _trimmedSegments)
+      _trimmedSegments = excess;
+#else
+   for (size_t i = 0; i < excess; ++i)
+      {
+      TR::MemorySegment &segment = _segments.front().get();
+      _segments.pop_front();
       _backingProvider.release(segment);
+      ++_statistics._trimmed;
       }
+#endif
+   }
+
+void
+TR::SegmentPool::returnPages(TR::MemorySegment &segment) throw()
+   {
+#if defined(LINUX) || defined(OSX)
+   // Only whole pages inside the segment can be given back
+   static uintptr_t const pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+   uintptr_t start = (reinterpret_cast<uintptr_t>(segment.base()) + pageSize - 1) & ~(pageSize - 1);
+   uintptr_t end = (reinterpret_cast<uintptr_t>(segment.base()) + segment.size()) & ~(pageSize - 1);
+   if (start < end)
+      madvise(reinterpret_cast<void *>(start), end - start, MADV_DONTNEED);
+#endif
    }
@@ -25,7 +25,6 @@
 #pragma once
 
 #include <deque>
-#include <stack>
 #include "env/TypedAllocator.hpp"
 #include "infra/ReferenceWrapper.hpp"
 #include "env/SegmentProvider.hpp"
@@ -35,20 +34,57 @@ namespace TR {
 
 /**
  * @brief The SegmentPool class maintains a pool of memory segments.
+ *
+ * Released segments of the default size are kept, up to the size of the pool,
+ * and handed out again by later requests. A pool that outlives the regions
+ * using it, such as one reused by a thread for each of its compilations,
+ * keeps a warm set of segments and spares those compilations the system
+ * calls and page faults of getting fresh memory.
+ *
+ * trim() returns the pages of the pooled segments beyond the resident size
+ * to the operating system, but keeps the segments themselves. Where pages
+ * cannot be returned that way, the segments are released to the backing
+ * provider instead.
  */
 
 class SegmentPool : public TR::SegmentProvider
    {
 public:
-   SegmentPool(TR::SegmentProvider &backingProvider, size_t cacheSize, TR::RawAllocator rawAllocator);
+   struct Statistics
+      {
+      size_t _requests;   // requests for a segment of the default size
+      size_t _recycled;   // requests satisfied from the pool
+      size_t _released;   // segments released to the backing provider because the pool was full
+      size_t _trimmed;    // pooled segments whose pages were returned by trim()
+      };
+
+   SegmentPool(TR::SegmentProvider &backingProvider, size_t poolSize, TR::RawAllocator rawAllocator);
+   SegmentPool(TR::SegmentProvider &backingProvider, size_t poolSize, size_t residentSize, TR::RawAllocator rawAllocator);
    ~SegmentPool() throw();
 
    virtual TR::MemorySegment &request(size_t requiredSize);
    virtual void release(TR::MemorySegment &) throw();
 
+   /**
+    * @brief The largest number of bytes in segments handed out by the pool at
+    * any one time since the pool was created or resetHighWaterMark() was called.
+    */
+   virtual size_t bytesAllocated() const throw();
+   void resetHighWaterMark() throw() { _highWaterMark = _bytesInUse; }
+
+   /// Bytes in segments handed out by the pool and not yet released
+   size_t bytesInUse() const throw() { return _bytesInUse; }
+
+   void trim() throw();
+
+   size_t pooledSegments() const throw() { return _segments.size(); }
+   const Statistics &statistics() const throw() { return _statistics; }
+
 private:
+   void returnPages(TR::MemorySegment &segment) throw();
+
    size_t const _poolSize;
-   size_t _storedSegments;
+   size_t const _residentSize;
    TR::SegmentProvider &_backingProvider;
 
    typedef TR::typed_allocator<
@@ -59,15 +95,16 @@ private:
    typedef std::deque<
       TR::reference_wrapper<TR::MemorySegment>,
       DequeAllocator
-      > StackContainer;
-
-   typedef std::stack<
-      TR::reference_wrapper<TR::MemorySegment>,
-      StackContainer
-      > SegmentStack;
+      > SegmentDeque;
 
-   SegmentStack _segmentStack;
+   // Most recently released segments at the back. The first _trimmedSegments
+   // have had their pages returned.
+   SegmentDeque _segments;
+   size_t _trimmedSegments;
 
+   size_t _bytesInUse;
+   size_t _highWaterMark;
+   Statistics _statistics;
    };
 
 }
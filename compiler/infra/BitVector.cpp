@@ -50,25 +50,9 @@ static int8_t bitsInByte[] =
 
 int32_t TR_BitVector::elementCount()
    {
-   int32_t count = 0;
-   for (int32_t i = _firstChunkWithNonZero; i <= _lastChunkWithNonZero; i++)
-      {
-      if (_chunks[i])
-         {
-         uint8_t *p = (uint8_t*)&_chunks[i];
-         count += bitsInByte[p[0]];
-         count += bitsInByte[p[1]];
-         count += bitsInByte[p[2]];
-         count += bitsInByte[p[3]];
-#if BITS_IN_CHUNK == 64
-         count += bitsInByte[p[4]];
-         count += bitsInByte[p[5]];
-         count += bitsInByte[p[6]];
-         count += bitsInByte[p[7]];
-#endif
-         }
-      }
-   return count;
+   if (_lastChunkWithNonZero < 0)
+      return 0;
+   return TR_BitVectorKernels::active().populationCount(_chunks + _firstChunkWithNonZero, _lastChunkWithNonZero - _firstChunkWithNonZero + 1);
    }
 
 
@@ -78,26 +62,7 @@ int32_t TR_BitVector::commonElementCount(TR_BitVector& v2)
       return false; // No intersection
    int32_t low = _firstChunkWithNonZero >= v2._firstChunkWithNonZero ? _firstChunkWithNonZero : v2._firstChunkWithNonZero;
    int32_t high = _lastChunkWithNonZero <= v2._lastChunkWithNonZero ? _lastChunkWithNonZero : v2._lastChunkWithNonZero;
-   int32_t count = 0;
-   for (int32_t i = low; i <= high; i++)
-      {
-      chunk_t tmp = _chunks[i] & v2._chunks[i];
-      if (tmp)
-         {
-         uint8_t *p = (uint8_t*)&tmp;
-         count += bitsInByte[p[0]];
-         count += bitsInByte[p[1]];
-         count += bitsInByte[p[2]];
-         count += bitsInByte[p[3]];
-#if BITS_IN_CHUNK == 64
-         count += bitsInByte[p[4]];
-         count += bitsInByte[p[5]];
-         count += bitsInByte[p[6]];
-         count += bitsInByte[p[7]];
-#endif
-         }
-      }
-   return count;
+   return TR_BitVectorKernels::active().commonPopulationCount(_chunks + low, v2._chunks + low, high - low + 1);
    }
 
 
@@ -178,6 +143,8 @@ void TR_BitVector::setChunkSize(int32_t chunkSize)
       memcpy(newChunks, _chunks, chunksToCopy*sizeof(chunk_t));
       if(_region == NULL)
          jitPersistentFree(_chunks);
+      else
+         _region->deallocate(_chunks, _numChunks*sizeof(chunk_t));
       }
 
    _chunks = newChunks;
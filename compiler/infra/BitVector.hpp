@@ -28,21 +28,12 @@
 #include "env/TRMemory.hpp"
 #include "env/defines.h"
 #include "infra/Assert.hpp"
+#include "infra/BitVectorKernels.hpp"
 
 class TR_BitVector;
 class TR_BitVectorCursor;
 namespace TR { class Compilation; }
 
-#if defined(BITVECTOR_64BIT)
-typedef uint64_t chunk_t;
-#define BITS_IN_CHUNK 64
-#define SHIFT    6
-#else
-typedef uint32_t chunk_t;
-#define BITS_IN_CHUNK 32
-#define SHIFT    5
-#endif
-
 #define BV_SANITY_CHECK 0
 
 enum TR_BitContainerType
@@ -289,7 +280,19 @@ class TR_BitVector
       else
          {
          TR_BitVector &v2 = *(bc._bitVector);
-         _region = v2._region;
+         if (_region != v2._region)
+            {
+            // The chunks belong to the old region, which may recycle them,
+            // so start over with chunks from the new one
+            if (_chunks && _region == NULL)
+               jitPersistentFree(_chunks);
+            _chunks = NULL;
+            _numChunks = 0;
+            _firstChunkWithNonZero = 0;
+            _lastChunkWithNonZero = -1;
+            _region = v2._region;
+            _growable = growable;
+            }
          *this = v2;
          _growable = v2._growable;
          }
@@ -488,8 +491,15 @@ class TR_BitVector
          setChunkSize(v2Used);
 
       // OR in all of the words from the 2nd vector
-      for (int32_t i = v2._firstChunkWithNonZero; i <= v2._lastChunkWithNonZero; i++)
-         _chunks[i] |= v2._chunks[i];
+      int32_t low = v2._firstChunkWithNonZero;
+      int32_t numChunks = v2._lastChunkWithNonZero - low + 1;
+      if (numChunks >= TR_BitVectorKernels::minBulkChunks)
+         TR_BitVectorKernels::active().orChunks(_chunks + low, v2._chunks + low, numChunks);
+      else
+         {
+         for (int32_t i = low; i <= v2._lastChunkWithNonZero; i++)
+            _chunks[i] |= v2._chunks[i];
+         }
       if (_firstChunkWithNonZero > v2._firstChunkWithNonZero)
          _firstChunkWithNonZero = v2._firstChunkWithNonZero;
       if (_lastChunkWithNonZero < v2._lastChunkWithNonZero)
@@ -544,8 +554,13 @@ class TR_BitVector
          }
 
       // AND in all of the words from the 2nd vector
-      for (i = low; i <= high; i++)
-         _chunks[i] &= v2._chunks[i];
+      if (high - low + 1 >= TR_BitVectorKernels::minBulkChunks)
+         TR_BitVectorKernels::active().andChunks(_chunks + low, v2._chunks + low, high - low + 1);
+      else
+         {
+         for (i = low; i <= high; i++)
+            _chunks[i] &= v2._chunks[i];
+         }
 
       // Reset first and last chunks with non-zero
       resetLowAndHighChunks(low, high);
@@ -570,6 +585,8 @@ class TR_BitVector
          low = _firstChunkWithNonZero;
       if (high > _lastChunkWithNonZero)
          high = _lastChunkWithNonZero;
+      if (high - low + 1 >= TR_BitVectorKernels::minBulkChunks)
+         return TR_BitVectorKernels::active().intersects(_chunks + low, v2._chunks + low, high - low + 1);
       for (int32_t i = low; i<= high; i++)
          if (_chunks[i] & v2._chunks[i])
             return true;
@@ -593,8 +610,13 @@ class TR_BitVector
          low = _firstChunkWithNonZero;
       if (high > _lastChunkWithNonZero)
          high = _lastChunkWithNonZero;
-      for (int32_t i = low; i<= high; i++)
-         _chunks[i] &= ~v2._chunks[i];
+      if (high - low + 1 >= TR_BitVectorKernels::minBulkChunks)
+         TR_BitVectorKernels::active().andNotChunks(_chunks + low, v2._chunks + low, high - low + 1);
+      else
+         {
+         for (int32_t i = low; i<= high; i++)
+            _chunks[i] &= ~v2._chunks[i];
+         }
 
       // Reset first and last chunks with non-zero
       resetLowAndHighChunks(_firstChunkWithNonZero, _lastChunkWithNonZero);
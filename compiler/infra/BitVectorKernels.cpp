@@ -0,0 +1,353 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "infra/BitVectorKernels.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "env/CPU.hpp"
+#include "env/FrontEnd.hpp"
+#include "infra/Bit.hpp"
+
+#if defined(TR_HOST_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TR_BITVECTOR_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(TR_HOST_ARM64) && defined(__ARM_NEON)
+#define TR_BITVECTOR_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+// Scalar kernels
+//
+static void scalarOrChunks(chunk_t *dst, const chunk_t *src, int32_t numChunks)
+   {
+   for (int32_t i = 0; i < numChunks; i++)
+      dst[i] |= src[i];
+   }
+
+static void scalarAndChunks(chunk_t *dst, const chunk_t *src, int32_t numChunks)
+   {
+   for (int32_t i = 0; i < numChunks; i++)
+      dst[i] &= src[i];
+   }
+
+static void scalarAndNotChunks(chunk_t *dst, const chunk_t *src, int32_t numChunks)
+   {
+   for (int32_t i = 0; i < numChunks; i++)
+      dst[i] &= ~src[i];
+   }
+
+static bool scalarIntersects(const chunk_t *a, const chunk_t *b, int32_t numChunks)
+   {
+   for (int32_t i = 0; i < numChunks; i++)
+      if (a[i] & b[i])
+         return true;
+   return false;
+   }
+
+static int32_t scalarPopulationCount(const chunk_t *a, int32_t numChunks)
+   {
+   int32_t count = 0;
+   for (int32_t i = 0; i < numChunks; i++)
+      if (a[i])
+         count += populationCount(a[i]);
+   return count;
+   }
+
+static int32_t scalarCommonPopulationCount(const chunk_t *a, const chunk_t *b, int32_t numChunks)
+   {
+   int32_t count = 0;
+   for (int32_t i = 0; i < numChunks; i++)
+      {
+      chunk_t common = a[i] & b[i];
+      if (common)
+         count += populationCount(common);
+      }
+   return count;
+   }
+
+static const TR_BitVectorKernels scalarKernels =
+   {
+   "scalar",
+   scalarOrChunks,
+   scalarAndChunks,
+   scalarAndNotChunks,
+   scalarIntersects,
+   scalarPopulationCount,
+   scalarCommonPopulationCount
+   };
+
+#if defined(TR_BITVECTOR_KERNELS_AVX2)
+
+// AVX2 kernels process 32 bytes per step; the chunks left over at the end
+// of a run go through the scalar kernels.
+//
+#define AVX2_CHUNKS_PER_STEP ((int32_t)(sizeof(__m256i) / sizeof(chunk_t)))
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+
+AVX2_FUNCTION static void avx2OrChunks(chunk_t *dst, const chunk_t *src, int32_t numChunks)
+   {
+   int32_t i = 0;
+   for (; i + AVX2_CHUNKS_PER_STEP <= numChunks; i += AVX2_CHUNKS_PER_STEP)
+      {
+      __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+      __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+      _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(d, s));
+      }
+   scalarOrChunks(dst + i, src + i, numChunks - i);
+   }
+
+AVX2_FUNCTION static void avx2AndChunks(chunk_t *dst, const chunk_t *src, int32_t numChunks)
+   {
+   int32_t i = 0;
+   for (; i + AVX2_CHUNKS_PER_STEP <= numChunks; i += AVX2_CHUNKS_PER_STEP)
+      {
+      __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+      __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+      _mm256_storeu_si256((__m256i *)(dst + i), _mm256_and_si256(d, s));
+      }
+   scalarAndChunks(dst + i, src + i, numChunks - i);
+   }
+
+AVX2_FUNCTION static void avx2AndNotChunks(chunk_t *dst, const chunk_t *src, int32_t numChunks)
+   {
+   int32_t i = 0;
+   for (; i + AVX2_CHUNKS_PER_STEP <= numChunks; i += AVX2_CHUNKS_PER_STEP)
+      {
+      __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+      __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+      // andnot complements its first operand
+      _mm256_storeu_si256((__m256i *)(dst + i), _mm256_andnot_si256(s, d));
+      }
+   scalarAndNotChunks(dst + i, src + i, numChunks - i);
+   }
+
+AVX2_FUNCTION static bool avx2Intersects(const chunk_t *a, const chunk_t *b, int32_t numChunks)
+   {
+   int32_t i = 0;
+   for (; i + AVX2_CHUNKS_PER_STEP <= numChunks; i += AVX2_CHUNKS_PER_STEP)
+      {
+      __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+      __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+      if (!_mm256_testz_si256(va, vb))
+         return true;
+      }
+   return scalarIntersects(a + i, b + i, numChunks - i);
+   }
+
+// Count bits a nibble at a time with a shuffle-based lookup table, then sum
+// the per-byte counts into 64-bit lanes.
+//
+AVX2_FUNCTION static inline __m256i avx2CountBytes(__m256i v)
+   {
+   const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+   const __m256i lowNibbles = _mm256_set1_epi8(0x0f);
+   __m256i low = _mm256_and_si256(v, lowNibbles);
+   __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibbles);
+   __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+   return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+   }
+
+AVX2_FUNCTION static inline int32_t avx2SumLanes(__m256i v)
+   {
+   uint64_t lanes[4];
+   _mm256_storeu_si256((__m256i *)lanes, v);
+   return (int32_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+   }
+
+AVX2_FUNCTION static int32_t avx2PopulationCount(const chunk_t *a, int32_t numChunks)
+   {
+   __m256i total = _mm256_setzero_si256();
+   int32_t i = 0;
+   for (; i + AVX2_CHUNKS_PER_STEP <= numChunks; i += AVX2_CHUNKS_PER_STEP)
+      total = _mm256_add_epi64(total, avx2CountBytes(_mm256_loadu_si256((const __m256i *)(a + i))));
+   return avx2SumLanes(total) + scalarPopulationCount(a + i, numChunks - i);
+   }
+
+AVX2_FUNCTION static int32_t avx2CommonPopulationCount(const chunk_t *a, const chunk_t *b, int32_t numChunks)
+   {
+   __m256i total = _mm256_setzero_si256();
+   int32_t i = 0;
+   for (; i + AVX2_CHUNKS_PER_STEP <= numChunks; i += AVX2_CHUNKS_PER_STEP)
+      {
+      __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+      __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+      total = _mm256_add_epi64(total, avx2CountBytes(_mm256_and_si256(va, vb)));
+      }
+   return avx2SumLanes(total) + scalarCommonPopulationCount(a + i, b + i, numChunks - i);
+   }
+
+static const TR_BitVectorKernels avx2Kernels =
+   {
+   "avx2",
+   avx2OrChunks,
+   avx2AndChunks,
+   avx2AndNotChunks,
+   avx2Intersects,
+   avx2PopulationCount,
+   avx2CommonPopulationCount
+   };
+
+#endif /* TR_BITVECTOR_KERNELS_AVX2 */
+
+#if defined(TR_BITVECTOR_KERNELS_NEON)
+
+// NEON kernels process 16 bytes per step; the chunks left over at the end
+// of a run go through the scalar kernels.
+//
+#define NEON_CHUNKS_PER_STEP ((int32_t)(sizeof(uint8x16_t) / sizeof(chunk_t)))
+
+static void neonOrChunks(chunk_t *dst, const chunk_t *src, int32_t numChunks)
+   {
+   int32_t i = 0;
+   for (; i + NEON_CHUNKS_PER_STEP <= numChunks; i += NEON_CHUNKS_PER_STEP)
+      {
+      uint8x16_t d = vld1q_u8((const uint8_t *)(dst + i));
+      uint8x16_t s = vld1q_u8((const uint8_t *)(src + i));
+      vst1q_u8((uint8_t *)(dst + i), vorrq_u8(d, s));
+      }
+   scalarOrChunks(dst + i, src + i, numChunks - i);
+   }
+
+static void neonAndChunks(chunk_t *dst, const chunk_t *src, int32_t numChunks)
+   {
+   int32_t i = 0;
+   for (; i + NEON_CHUNKS_PER_STEP <= numChunks; i += NEON_CHUNKS_PER_STEP)
+      {
+      uint8x16_t d = vld1q_u8((const uint8_t *)(dst + i));
+      uint8x16_t s = vld1q_u8((const uint8_t *)(src + i));
+      vst1q_u8((uint8_t *)(dst + i), vandq_u8(d, s));
+      }
+   scalarAndChunks(dst + i, src + i, numChunks - i);
+   }
+
+static void neonAndNotChunks(chunk_t *dst, const chunk_t *src, int32_t numChunks)
+   {
+   int32_t i = 0;
+   for (; i + NEON_CHUNKS_PER_STEP <= numChunks; i += NEON_CHUNKS_PER_STEP)
+      {
+      uint8x16_t d = vld1q_u8((const uint8_t *)(dst + i));
+      uint8x16_t s = vld1q_u8((const uint8_t *)(src + i));
+      vst1q_u8((uint8_t *)(dst + i), vbicq_u8(d, s));
+      }
+   scalarAndNotChunks(dst + i, src + i, numChunks - i);
+   }
+
+static bool neonIntersects(const chunk_t *a, const chunk_t *b, int32_t numChunks)
+   {
+   int32_t i = 0;
+   for (; i + NEON_CHUNKS_PER_STEP <= numChunks; i += NEON_CHUNKS_PER_STEP)
+      {
+      uint8x16_t va = vld1q_u8((const uint8_t *)(a + i));
+      uint8x16_t vb = vld1q_u8((const uint8_t *)(b + i));
+      if (vmaxvq_u8(vandq_u8(va, vb)))
+         return true;
+      }
+   return scalarIntersects(a + i, b + i, numChunks - i);
+   }
+
+static inline uint64x2_t neonCountBytes(uint64x2_t total, uint8x16_t v)
+   {
+   return vpadalq_u32(total, vpaddlq_u16(vpaddlq_u8(vcntq_u8(v))));
+   }
+
+static int32_t neonPopulationCount(const chunk_t *a, int32_t numChunks)
+   {
+   uint64x2_t total = vdupq_n_u64(0);
+   int32_t i = 0;
+   for (; i + NEON_CHUNKS_PER_STEP <= numChunks; i += NEON_CHUNKS_PER_STEP)
+      total = neonCountBytes(total, vld1q_u8((const uint8_t *)(a + i)));
+   return (int32_t)vaddvq_u64(total) + scalarPopulationCount(a + i, numChunks - i);
+   }
+
+static int32_t neonCommonPopulationCount(const chunk_t *a, const chunk_t *b, int32_t numChunks)
+   {
+   uint64x2_t total = vdupq_n_u64(0);
+   int32_t i = 0;
+   for (; i + NEON_CHUNKS_PER_STEP <= numChunks; i += NEON_CHUNKS_PER_STEP)
+      {
+      uint8x16_t va = vld1q_u8((const uint8_t *)(a + i));
+      uint8x16_t vb = vld1q_u8((const uint8_t *)(b + i));
+      total = neonCountBytes(total, vandq_u8(va, vb));
+      }
+   return (int32_t)vaddvq_u64(total) + scalarCommonPopulationCount(a + i, b + i, numChunks - i);
+   }
+
+static const TR_BitVectorKernels neonKernels =
+   {
+   "neon",
+   neonOrChunks,
+   neonAndChunks,
+   neonAndNotChunks,
+   neonIntersects,
+   neonPopulationCount,
+   neonCommonPopulationCount
+   };
+
+#endif /* TR_BITVECTOR_KERNELS_NEON */
+
+const TR_BitVectorKernels *TR_BitVectorKernels::_active = &scalarKernels;
+
+const TR_BitVectorKernels &
+TR_BitVectorKernels::scalar()
+   {
+   return scalarKernels;
+   }
+
+const TR_BitVectorKernels *
+TR_BitVectorKernels::avx2()
+   {
+#if defined(TR_BITVECTOR_KERNELS_AVX2)
+   return &avx2Kernels;
+#else
+   return NULL;
+#endif
+   }
+
+const TR_BitVectorKernels *
+TR_BitVectorKernels::neon()
+   {
+#if defined(TR_BITVECTOR_KERNELS_NEON)
+   return &neonKernels;
+#else
+   return NULL;
+#endif
+   }
+
+void
+TR_BitVectorKernels::initialize()
+   {
+   _active = &scalarKernels;
+
+   if (feGetEnv("TR_DisableSIMDBitVectorKernels"))
+      return;
+
+#if defined(TR_BITVECTOR_KERNELS_AVX2) && defined(TR_TARGET_X86)
+   if (TR::CPU::hostSupportsAVX2())
+      _active = &avx2Kernels;
+#elif defined(TR_BITVECTOR_KERNELS_NEON)
+   // Advanced SIMD is mandatory on AArch64
+   _active = &neonKernels;
+#endif
+   }
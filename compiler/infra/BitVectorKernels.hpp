@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef BITVECTORKERNELS_INCL
+#define BITVECTORKERNELS_INCL
+
+#include <stdint.h>
+
+#if defined(BITVECTOR_64BIT)
+typedef uint64_t chunk_t;
+#define BITS_IN_CHUNK 64
+#define SHIFT    6
+#else
+typedef uint32_t chunk_t;
+#define BITS_IN_CHUNK 32
+#define SHIFT    5
+#endif
+
+/**
+ * @brief Bulk operations over runs of bit vector chunks.
+ *
+ * The dense set operations of TR_BitVector and TR_ChunkedBitVector hand long
+ * runs of chunks to one of these tables.  The scalar table is always
+ * available; SIMD tables are built only for hosts and toolchains that
+ * support them, and initialize() picks the best one the host CPU can run.
+ *
+ * Every kernel accepts unaligned pointers and any chunk count, including 0.
+ */
+struct TR_BitVectorKernels
+   {
+   typedef void (*CombineFunction)(chunk_t *dst, const chunk_t *src, int32_t numChunks);
+   typedef bool (*IntersectsFunction)(const chunk_t *a, const chunk_t *b, int32_t numChunks);
+   typedef int32_t (*PopulationCountFunction)(const chunk_t *a, int32_t numChunks);
+   typedef int32_t (*CommonPopulationCountFunction)(const chunk_t *a, const chunk_t *b, int32_t numChunks);
+
+   const char *name;
+
+   CombineFunction orChunks;                           // dst |= src
+   CombineFunction andChunks;                          // dst &= src
+   CombineFunction andNotChunks;                       // dst &= ~src
+   IntersectsFunction intersects;                      // (a & b) != 0
+   PopulationCountFunction populationCount;            // bits set in a
+   CommonPopulationCountFunction commonPopulationCount; // bits set in (a & b)
+
+   /**
+    * Runs shorter than this are cheaper to process inline than through an
+    * indirect call.
+    */
+   static const int32_t minBulkChunks = 8;
+
+   static const TR_BitVectorKernels &active() { return *_active; }
+
+   static const TR_BitVectorKernels &scalar();
+
+   /**
+    * @return the AVX2 or NEON table if one was built for this host, NULL otherwise.
+    *         Building a table does not imply the host CPU can execute it.
+    */
+   static const TR_BitVectorKernels *avx2();
+   static const TR_BitVectorKernels *neon();
+
+   /**
+    * @brief Select the best kernels the host CPU can run.
+    *
+    * Setting TR_DisableSIMDBitVectorKernels in the environment forces the
+    * scalar kernels.
+    */
+   static void initialize();
+
+   /**
+    * @brief Force a specific table; used to compare implementations.
+    */
+   static void setActive(const TR_BitVectorKernels &kernels) { _active = &kernels; }
+
+   private:
+
+   static const TR_BitVectorKernels *_active;
+   };
+
+#endif
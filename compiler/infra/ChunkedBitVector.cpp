@@ -0,0 +1,501 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "infra/ChunkedBitVector.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include "compile/Compilation.hpp"
+#include "infra/Bit.hpp"
+#include "ras/Debug.hpp"
+
+// Two vectors have the same shape if they hold exactly the same set of
+// non-zero chunks, in which case their payloads can be combined pairwise.
+//
+static bool sameShape(const int32_t *indices1, const int32_t *indices2, int32_t size)
+   {
+   return indices1 == indices2 || memcmp(indices1, indices2, size * sizeof(int32_t)) == 0;
+   }
+
+int32_t TR_ChunkedBitVector::firstBitInChunk(chunk_t bits)
+   {
+   if (bits == 0)
+      return BITS_IN_CHUNK;
+#if defined(BITVECTOR_BIT_NUMBERING_MSB)
+   return leadingZeroes(bits);
+#else
+   return trailingZeroes(bits);
+#endif
+   }
+
+int32_t TR_ChunkedBitVector::lastBitInChunk(chunk_t bits)
+   {
+   TR_ASSERT(bits != 0, "Chunk must not be empty");
+#if defined(BITVECTOR_BIT_NUMBERING_MSB)
+   return (BITS_IN_CHUNK-1) - trailingZeroes(bits);
+#else
+   return (BITS_IN_CHUNK-1) - leadingZeroes(bits);
+#endif
+   }
+
+void TR_ChunkedBitVector::ensureCapacity(int32_t numChunks, bool preserve)
+   {
+   if (numChunks <= _capacity)
+      return;
+
+   int32_t newCapacity = _capacity * 2;
+   if (newCapacity < numChunks)
+      newCapacity = numChunks;
+   if (newCapacity < 4)
+      newCapacity = 4;
+
+   size_t newBytes = newCapacity * (sizeof(chunk_t) + sizeof(int32_t));
+   chunk_t *newChunks = _region != NULL ? (chunk_t *)_region->allocate(newBytes) : (chunk_t *)TR_Memory::jitPersistentAlloc(newBytes, TR_Memory::BitVector);
+   int32_t *newIndices = (int32_t *)(newChunks + newCapacity);
+
+   if (preserve && _size > 0)
+      {
+      memcpy(newChunks, _chunks, _size * sizeof(chunk_t));
+      memcpy(newIndices, _indices, _size * sizeof(int32_t));
+      }
+
+   if (_chunks)
+      {
+      if (_region != NULL)
+         _region->deallocate(_chunks, _capacity * (sizeof(chunk_t) + sizeof(int32_t)));
+      else
+         TR_Memory::jitPersistentFree(_chunks);
+      }
+
+   _chunks = newChunks;
+   _indices = newIndices;
+   _capacity = newCapacity;
+   }
+
+TR_ChunkedBitVector & TR_ChunkedBitVector::operator= (TR_BitVector &dense)
+   {
+   CS2_TR_BitVector wrapper(dense);
+   empty();
+   if (dense.isEmpty())
+      return *this;
+
+   int32_t first = wrapper.FirstOneWordIndex();
+   int32_t last = wrapper.LastOneWordIndex();
+   int32_t count = 0;
+   for (int32_t i = first; i <= last; i++)
+      {
+      if (wrapper.WordAt(i) != 0)
+         count++;
+      }
+
+   ensureCapacity(count, false);
+   for (int32_t i = first; i <= last; i++)
+      {
+      chunk_t bits = wrapper.WordAt(i);
+      if (bits != 0)
+         {
+         _chunks[_size] = bits;
+         _indices[_size] = i;
+         _size++;
+         }
+      }
+   return *this;
+   }
+
+// Perform a bitwise OR between this vector and a second vector
+// Results are in the this vector
+//
+void TR_ChunkedBitVector::operator|= (TR_ChunkedBitVector &v2)
+   {
+   if (v2._size == 0 || this == &v2)
+      return;
+   if (_size == 0)
+      {
+      *this = v2;
+      return;
+      }
+   if (_size == v2._size && sameShape(_indices, v2._indices, _size))
+      {
+      if (_size >= TR_BitVectorKernels::minBulkChunks)
+         TR_BitVectorKernels::active().orChunks(_chunks, v2._chunks, _size);
+      else
+         {
+         for (int32_t i = 0; i < _size; i++)
+            _chunks[i] |= v2._chunks[i];
+         }
+      return;
+      }
+
+   // Count the chunks in the union so that the result can be merged in place
+   int32_t i = 0, j = 0, unionSize = 0;
+   while (i < _size && j < v2._size)
+      {
+      if (_indices[i] < v2._indices[j])
+         i++;
+      else if (_indices[i] > v2._indices[j])
+         j++;
+      else
+         {
+         i++;
+         j++;
+         }
+      unionSize++;
+      }
+   unionSize += (_size - i) + (v2._size - j);
+
+   ensureCapacity(unionSize, true);
+
+   // Merge from the end so that no chunk of this vector is overwritten
+   // before it has been moved
+   i = _size - 1;
+   j = v2._size - 1;
+   for (int32_t k = unionSize - 1; j >= 0; k--)
+      {
+      if (i >= 0 && _indices[i] > v2._indices[j])
+         {
+         _indices[k] = _indices[i];
+         _chunks[k] = _chunks[i];
+         i--;
+         }
+      else if (i >= 0 && _indices[i] == v2._indices[j])
+         {
+         _indices[k] = _indices[i];
+         _chunks[k] = _chunks[i] | v2._chunks[j];
+         i--;
+         j--;
+         }
+      else
+         {
+         _indices[k] = v2._indices[j];
+         _chunks[k] = v2._chunks[j];
+         j--;
+         }
+      }
+   _size = unionSize;
+   }
+
+// Perform a bitwise AND between this vector and a second vector
+// Results are in the this vector
+//
+void TR_ChunkedBitVector::operator&= (TR_ChunkedBitVector &v2)
+   {
+   if (_size == 0 || this == &v2)
+      return;
+   if (v2._size == 0)
+      {
+      empty();
+      return;
+      }
+
+   int32_t w = 0;
+   if (_size == v2._size && sameShape(_indices, v2._indices, _size))
+      {
+      if (_size >= TR_BitVectorKernels::minBulkChunks)
+         TR_BitVectorKernels::active().andChunks(_chunks, v2._chunks, _size);
+      else
+         {
+         for (int32_t i = 0; i < _size; i++)
+            _chunks[i] &= v2._chunks[i];
+         }
+      for (int32_t i = 0; i < _size; i++)
+         {
+         if (_chunks[i] != 0)
+            {
+            _chunks[w] = _chunks[i];
+            _indices[w] = _indices[i];
+            w++;
+            }
+         }
+      _size = w;
+      return;
+      }
+
+   int32_t i = 0, j = 0;
+   while (i < _size && j < v2._size)
+      {
+      if (_indices[i] < v2._indices[j])
+         i++;
+      else if (_indices[i] > v2._indices[j])
+         j++;
+      else
+         {
+         chunk_t bits = _chunks[i] & v2._chunks[j];
+         if (bits != 0)
+            {
+            _chunks[w] = bits;
+            _indices[w] = _indices[i];
+            w++;
+            }
+         i++;
+         j++;
+         }
+      }
+   _size = w;
+   }
+
+// Perform a bitwise negation (AND-NOT) between this vector and a second vector
+// Results are in the this vector
+//
+void TR_ChunkedBitVector::operator-= (TR_ChunkedBitVector &v2)
+   {
+   if (_size == 0 || v2._size == 0)
+      return;
+   if (this == &v2)
+      {
+      empty();
+      return;
+      }
+
+   int32_t w = 0;
+   if (_size == v2._size && sameShape(_indices, v2._indices, _size))
+      {
+      if (_size >= TR_BitVectorKernels::minBulkChunks)
+         TR_BitVectorKernels::active().andNotChunks(_chunks, v2._chunks, _size);
+      else
+         {
+         for (int32_t i = 0; i < _size; i++)
+            _chunks[i] &= ~v2._chunks[i];
+         }
+      for (int32_t i = 0; i < _size; i++)
+         {
+         if (_chunks[i] != 0)
+            {
+            _chunks[w] = _chunks[i];
+            _indices[w] = _indices[i];
+            w++;
+            }
+         }
+      _size = w;
+      return;
+      }
+
+   int32_t j = 0;
+   for (int32_t i = 0; i < _size; i++)
+      {
+      while (j < v2._size && v2._indices[j] < _indices[i])
+         j++;
+      chunk_t bits = _chunks[i];
+      if (j < v2._size && v2._indices[j] == _indices[i])
+         bits &= ~v2._chunks[j];
+      if (bits != 0)
+         {
+         _chunks[w] = bits;
+         _indices[w] = _indices[i];
+         w++;
+         }
+      }
+   _size = w;
+   }
+
+void TR_ChunkedBitVector::operator|= (TR_BitVector &dense)
+   {
+   if (dense.isEmpty())
+      return;
+
+   CS2_TR_BitVector wrapper(dense);
+   int32_t last = wrapper.LastOneWordIndex();
+   int32_t pos = 0;
+   for (int32_t i = wrapper.FirstOneWordIndex(); i <= last; i++)
+      {
+      chunk_t bits = wrapper.WordAt(i);
+      if (bits == 0)
+         continue;
+      while (pos < _size && _indices[pos] < i)
+         pos++;
+      if (pos < _size && _indices[pos] == i)
+         _chunks[pos] |= bits;
+      else
+         insertChunk(pos, i, bits);
+      }
+   }
+
+void TR_ChunkedBitVector::operator-= (TR_BitVector &dense)
+   {
+   if (_size == 0 || dense.isEmpty())
+      return;
+
+   CS2_TR_BitVector wrapper(dense);
+   int32_t first = wrapper.FirstOneWordIndex();
+   int32_t last = wrapper.LastOneWordIndex();
+   int32_t w = 0;
+   for (int32_t i = 0; i < _size; i++)
+      {
+      chunk_t bits = _chunks[i];
+      if (_indices[i] >= first && _indices[i] <= last)
+         bits &= ~wrapper.WordAt(_indices[i]);
+      if (bits != 0)
+         {
+         _chunks[w] = bits;
+         _indices[w] = _indices[i];
+         w++;
+         }
+      }
+   _size = w;
+   }
+
+// Determine if any bit is set in both this vector and a second vector.
+//
+bool TR_ChunkedBitVector::intersects(TR_ChunkedBitVector &v2)
+   {
+   int32_t i = 0, j = 0;
+   while (i < _size && j < v2._size)
+      {
+      if (_indices[i] < v2._indices[j])
+         i++;
+      else if (_indices[i] > v2._indices[j])
+         j++;
+      else
+         {
+         if (_chunks[i] & v2._chunks[j])
+            return true;
+         i++;
+         j++;
+         }
+      }
+   return false;
+   }
+
+void TR_ChunkedBitVector::setAll(int64_t m, int64_t n)
+   {
+   if (n < m)
+      return;
+   TR_ASSERT(m >= 0, "assertion failure");
+
+   int32_t firstChunk = getChunkIndex(m);
+   int32_t lastChunk = getChunkIndex(n);
+   int32_t rangeChunks = lastChunk - firstChunk + 1;
+   int32_t low = findChunk(firstChunk);
+   int32_t high = findChunk(lastChunk + 1);
+   int32_t newSize = _size + rangeChunks - (high - low);
+
+   // Only the partially covered chunks at either end need their old bits
+   chunk_t oldFirst = (low < high && _indices[low] == firstChunk) ? _chunks[low] : 0;
+   chunk_t oldLast = (low < high && _indices[high-1] == lastChunk) ? _chunks[high-1] : 0;
+
+   ensureCapacity(newSize, true);
+
+   // Open up a gap for the range
+   int32_t tail = _size - high;
+   if (tail > 0 && low + rangeChunks != high)
+      {
+      memmove(_chunks + low + rangeChunks, _chunks + high, tail * sizeof(chunk_t));
+      memmove(_indices + low + rangeChunks, _indices + high, tail * sizeof(int32_t));
+      }
+
+   for (int32_t c = 0; c < rangeChunks; c++)
+      {
+      _indices[low + c] = firstChunk + c;
+      _chunks[low + c] = ~(chunk_t)0;
+      }
+
+   if (firstChunk == lastChunk)
+      {
+      _chunks[low] = getRangeMask(getIndexInChunk(m), getIndexInChunk(n)) | oldFirst;
+      }
+   else
+      {
+      _chunks[low] = getRangeMask(getIndexInChunk(m), BITS_IN_CHUNK-1) | oldFirst;
+      _chunks[low + rangeChunks - 1] = getRangeMask(0, getIndexInChunk(n)) | oldLast;
+      }
+
+   _size = newSize;
+   }
+
+void TR_ChunkedBitVector::resetAll(int64_t m, int64_t n)
+   {
+   if (n < m || _size == 0)
+      return;
+
+   int32_t firstChunk = getChunkIndex(m);
+   int32_t lastChunk = getChunkIndex(n);
+   int32_t pos = findChunk(firstChunk);
+   int32_t w = pos;
+   for (; pos < _size && _indices[pos] <= lastChunk; pos++)
+      {
+      int32_t chunkIndex = _indices[pos];
+      int32_t from = (chunkIndex == firstChunk) ? getIndexInChunk(m) : 0;
+      int32_t to = (chunkIndex == lastChunk) ? getIndexInChunk(n) : BITS_IN_CHUNK-1;
+      chunk_t bits = _chunks[pos] & ~getRangeMask(from, to);
+      if (bits != 0)
+         {
+         _chunks[w] = bits;
+         _indices[w] = chunkIndex;
+         w++;
+         }
+      }
+
+   int32_t tail = _size - pos;
+   if (tail > 0 && w != pos)
+      {
+      memmove(_chunks + w, _chunks + pos, tail * sizeof(chunk_t));
+      memmove(_indices + w, _indices + pos, tail * sizeof(int32_t));
+      }
+   _size = w + tail;
+   }
+
+bool TR_ChunkedBitVector::hasMoreThanOneElement()
+   {
+   if (_size > 1)
+      return true;
+   if (_size == 0)
+      return false;
+   return (_chunks[0] & (_chunks[0] - 1)) != 0;
+   }
+
+int32_t TR_ChunkedBitVector::elementCount()
+   {
+   if (_size >= TR_BitVectorKernels::minBulkChunks)
+      return TR_BitVectorKernels::active().populationCount(_chunks, _size);
+
+   int32_t count = 0;
+   for (int32_t i = 0; i < _size; i++)
+      count += populationCount(_chunks[i]);
+   return count;
+   }
+
+int64_t TR_ChunkedBitVector::getHighestBitPosition()
+   {
+   if (_size == 0)
+      return 0;
+   return getBitIndex(_indices[_size-1]) + lastBitInChunk(_chunks[_size-1]);
+   }
+
+uint32_t TR_ChunkedBitVector::FirstOne() const
+   {
+   TR_ASSERT(_size > 0, "FirstOne of an empty bit vector");
+   return static_cast<uint32_t>(getBitIndex(_indices[0]) + firstBitInChunk(_chunks[0]));
+   }
+
+uint32_t TR_ChunkedBitVector::LastOne() const
+   {
+   TR_ASSERT(_size > 0, "LastOne of an empty bit vector");
+   return static_cast<uint32_t>(getBitIndex(_indices[_size-1]) + lastBitInChunk(_chunks[_size-1]));
+   }
+
+void TR_ChunkedBitVector::print(TR::Compilation *comp, TR::FILE *file)
+   {
+   if (comp->getDebug())
+      {
+      if (file == NULL)
+         file = comp->getOutFile();
+      comp->getDebug()->print(file, this);
+      }
+   }
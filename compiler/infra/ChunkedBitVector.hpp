@@ -0,0 +1,434 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef CHUNKEDBITVECTOR_INCL
+#define CHUNKEDBITVECTOR_INCL
+
+#include <stdint.h>
+#include <string.h>
+#include "env/FilePointerDecl.hpp"
+#include "env/TRMemory.hpp"
+#include "infra/Assert.hpp"
+#include "infra/BitVector.hpp"
+
+class TR_ChunkedBitVectorCursor;
+namespace TR { class Compilation; }
+
+/**
+ * A compressed bit vector for use with the data flow engine on large methods.
+ *
+ * TR_BitVector allocates one chunk for every potential member of the set,
+ * so a bit vector analysis needs storage proportional to the number of
+ * blocks times the number of candidates even when most sets are nearly
+ * empty.  TR_ChunkedBitVector stores only the chunks that contain at least
+ * one set bit, as a pair of parallel arrays kept sorted by chunk index:
+ *
+ *    _indices[i]  the chunk index of the i'th non-zero chunk
+ *    _chunks[i]   the bits of that chunk (never zero)
+ *
+ * The representation is canonical, so equality is a straight comparison of
+ * the two arrays.  Set operations are linear merges over the non-zero
+ * chunks; when both operands cover the same chunks (the common case once a
+ * data flow solution stabilises) the payload arrays are combined in bulk
+ * with straight-line loops instead.
+ *
+ * The class implements the container interface used by the templated data
+ * flow analyses (see TR_BasicDFSetAnalysis), and the CS2-style cursor
+ * interface so that TR_BitVector's generic mixed-type operators can be used
+ * to convert results back to a dense TR_BitVector.
+ */
+class TR_ChunkedBitVector
+   {
+   public:
+   TR_ALLOC(TR_Memory::BitVector)
+
+   typedef TR_ChunkedBitVectorCursor Cursor;
+   typedef int32_t containerCharacteristic; // used by data flow
+   static const containerCharacteristic nullContainerCharacteristic = -1;
+
+   TR_ChunkedBitVector(TR::Region &region)
+      : _chunks(NULL), _indices(NULL), _region(&region), _size(0), _capacity(0) { }
+
+   // The number of bits is only a hint; no storage is reserved until bits
+   // are set.
+   //
+   TR_ChunkedBitVector(int64_t initBits, TR::Region &region)
+      : _chunks(NULL), _indices(NULL), _region(&region), _size(0), _capacity(0) { }
+
+   TR_ChunkedBitVector(int64_t initBits, TR_Memory * m, TR_AllocationKind allocKind = heapAlloc)
+      : _chunks(NULL), _indices(NULL), _region(NULL), _size(0), _capacity(0)
+      {
+      switch (allocKind)
+         {
+         case heapAlloc:
+            _region = &(m->heapMemoryRegion());
+            break;
+         case stackAlloc:
+            _region = &(m->currentStackRegion());
+            break;
+         case persistentAlloc:
+            _region = NULL;
+            break;
+         default:
+            TR_ASSERT(false, "Unhandled allocation type!");
+         }
+      }
+
+   TR_ChunkedBitVector(const TR_ChunkedBitVector &v2)
+      : _chunks(NULL), _indices(NULL), _region(v2._region), _size(0), _capacity(0)
+      {
+      *this = v2;
+      }
+
+   // Get the value of the nth bit. The word returned is non-zero if the bit
+   // is set and is zero if the bit is not set.
+   //
+   int32_t get(int64_t n)
+      {
+      int32_t pos = findChunk(getChunkIndex(n));
+      if (pos >= _size || _indices[pos] != getChunkIndex(n))
+         return 0;
+      return (_chunks[pos] & getBitMask(n)) != 0;
+      }
+
+   bool isSet(int64_t n) { return get(n) != 0; }
+
+   // Set the value of the nth bit.
+   //
+   void set(int64_t n)
+      {
+      TR_ASSERT(n >= 0, "assertion failure");
+      int32_t chunkIndex = getChunkIndex(n);
+      int32_t pos = findChunk(chunkIndex);
+      if (pos < _size && _indices[pos] == chunkIndex)
+         _chunks[pos] |= getBitMask(n);
+      else
+         insertChunk(pos, chunkIndex, getBitMask(n));
+      }
+
+   void setTo(int64_t n, bool value)
+      {
+      if (value)
+         set(n);
+      else
+         reset(n);
+      }
+
+   // Reset the value of the nth bit.
+   //
+   void reset(int64_t n)
+      {
+      int32_t chunkIndex = getChunkIndex(n);
+      int32_t pos = findChunk(chunkIndex);
+      if (pos >= _size || _indices[pos] != chunkIndex)
+         return;
+      _chunks[pos] &= ~getBitMask(n);
+      if (_chunks[pos] == 0)
+         removeChunk(pos);
+      }
+
+   // like reset except that it tells you if the
+   // value had been set
+   bool clear(int64_t n)
+      {
+      bool rc = get(n) != 0;
+      if (rc)
+         reset(n);
+      return rc;
+      }
+
+   void operator= (const TR_ChunkedBitVector &v2)
+      {
+      if (this == &v2)
+         return;
+      ensureCapacity(v2._size, false);
+      if (v2._size > 0)
+         {
+         memcpy(_chunks, v2._chunks, v2._size * sizeof(chunk_t));
+         memcpy(_indices, v2._indices, v2._size * sizeof(int32_t));
+         }
+      _size = v2._size;
+      }
+
+   // Conversion from a dense bit vector
+   //
+   TR_ChunkedBitVector & operator= (TR_BitVector &dense);
+
+   // Mixed operations with a dense vector, for gen and kill sets that are
+   // built up in TR_BitVector temporaries
+   //
+   void operator|= (TR_BitVector &dense);
+   void operator-= (TR_BitVector &dense);
+
+   void operator|= (TR_ChunkedBitVector &v2);
+   void operator&= (TR_ChunkedBitVector &v2);
+   void operator-= (TR_ChunkedBitVector &v2);
+   bool intersects(TR_ChunkedBitVector &v2);
+
+   bool operator== (TR_ChunkedBitVector &v2)
+      {
+      if (_size != v2._size)
+         return false;
+      if (_size == 0)
+         return true;
+      return memcmp(_indices, v2._indices, _size * sizeof(int32_t)) == 0
+          && memcmp(_chunks, v2._chunks, _size * sizeof(chunk_t)) == 0;
+      }
+
+   bool operator!= (TR_ChunkedBitVector &v2) { return !operator==(v2); }
+
+   // Set the first n elements of the set
+   //
+   void setAll(int64_t n)
+      {
+      if (n > 0)
+         setAll(0, n-1);
+      }
+
+   // Set elements m to n of the set
+   //
+   void setAll(int64_t m, int64_t n);
+
+   // Reset all elements of the set (i.e. empty the set)
+   //
+   void empty() { _size = 0; }
+
+   void resetAll(int64_t n)
+      {
+      if (n > 0)
+         resetAll(0, n-1);
+      }
+
+   // Reset all elements m to n of the set
+   //
+   void resetAll(int64_t m, int64_t n);
+
+   bool isEmpty() { return _size == 0; }
+
+   bool hasMoreThanOneElement();
+
+   // Find the number of elements in the set
+   //
+   int32_t elementCount();
+
+   int64_t getHighestBitPosition();
+
+   // Number of chunks a dense TR_BitVector would need to hold this set
+   //
+   int32_t numUsedChunks() { return _size > 0 ? _indices[_size-1] + 1 : 0; }
+
+   int32_t numNonZeroChunks() { return _size; }
+
+   int32_t chunkSize() { return sizeof(chunk_t); }
+
+   // Number of bytes of chunk storage currently reserved by this vector
+   //
+   size_t memoryUsed() { return _capacity * (sizeof(chunk_t) + sizeof(int32_t)); }
+
+   // Print the bit vector to the log file
+   //
+   void print(TR::Compilation *comp, TR::FILE *file = NULL);
+
+   // CS2-like interface used by TR_BitVector's generic operators
+   //
+   bool IsZero() const { return _size == 0; }
+   uint32_t FirstOne() const;
+   uint32_t LastOne() const;
+
+   private:
+
+   friend class TR_ChunkedBitVectorIterator;
+
+   // Find the position of the first non-zero chunk whose index is not less
+   // than the given chunk index.
+   //
+   int32_t findChunk(int32_t chunkIndex) const
+      {
+      // Bits are most often set in ascending order, so check the end first
+      if (_size == 0 || _indices[_size-1] < chunkIndex)
+         return _size;
+      int32_t low = 0;
+      int32_t high = _size - 1;
+      while (low < high)
+         {
+         int32_t mid = low + ((high - low) >> 1);
+         if (_indices[mid] < chunkIndex)
+            low = mid + 1;
+         else
+            high = mid;
+         }
+      return low;
+      }
+
+   void insertChunk(int32_t pos, int32_t chunkIndex, chunk_t bits)
+      {
+      ensureCapacity(_size + 1, true);
+      if (pos < _size)
+         {
+         memmove(_chunks + pos + 1, _chunks + pos, (_size - pos) * sizeof(chunk_t));
+         memmove(_indices + pos + 1, _indices + pos, (_size - pos) * sizeof(int32_t));
+         }
+      _chunks[pos] = bits;
+      _indices[pos] = chunkIndex;
+      _size++;
+      }
+
+   void removeChunk(int32_t pos)
+      {
+      _size--;
+      if (pos < _size)
+         {
+         memmove(_chunks + pos, _chunks + pos + 1, (_size - pos) * sizeof(chunk_t));
+         memmove(_indices + pos, _indices + pos + 1, (_size - pos) * sizeof(int32_t));
+         }
+      }
+
+   // Make sure there is room for the given number of non-zero chunks,
+   // optionally preserving the current contents.
+   //
+   void ensureCapacity(int32_t numChunks, bool preserve);
+
+   static int32_t getChunkIndex(int64_t bitIndex) { return static_cast<int32_t>(bitIndex >> SHIFT); }
+   static int32_t getIndexInChunk(int64_t bitIndex) { return static_cast<int32_t>(bitIndex & (BITS_IN_CHUNK-1)); }
+   static int64_t getBitIndex(int32_t chunkIndex) { return ((int64_t)chunkIndex) << SHIFT; }
+
+   // Bit numbering within a chunk matches TR_BitVector so that chunks can be
+   // copied between the two representations.
+   //
+#if defined(BITVECTOR_BIT_NUMBERING_MSB)
+   static chunk_t getBitMask(int64_t bitIndex) { return (chunk_t)1 << ((BITS_IN_CHUNK-1) - getIndexInChunk(bitIndex)); }
+#else
+   static chunk_t getBitMask(int64_t bitIndex) { return (chunk_t)1 << getIndexInChunk(bitIndex); }
+#endif
+
+   // Mask of the bits at positions m..n (inclusive) of a single chunk
+   //
+   static chunk_t getRangeMask(int32_t m, int32_t n)
+      {
+#if defined(BITVECTOR_BIT_NUMBERING_MSB)
+      int32_t low = (BITS_IN_CHUNK-1) - n;
+      int32_t high = (BITS_IN_CHUNK-1) - m;
+#else
+      int32_t low = m;
+      int32_t high = n;
+#endif
+      chunk_t mask = (high == BITS_IN_CHUNK-1) ? ~(chunk_t)0 : (((chunk_t)1 << (high+1)) - 1);
+      return mask & ~(((chunk_t)1 << low) - 1);
+      }
+
+   // Position in the chunk of the lowest numbered set bit, or BITS_IN_CHUNK
+   //
+   static int32_t firstBitInChunk(chunk_t bits);
+
+   // Position in the chunk of the highest numbered set bit
+   //
+   static int32_t lastBitInChunk(chunk_t bits);
+
+   chunk_t     *_chunks;
+   int32_t     *_indices;
+   TR::Region  *_region;
+   int32_t      _size;
+   int32_t      _capacity;
+   };
+
+class TR_ChunkedBitVectorIterator
+   {
+   public:
+
+   TR_ChunkedBitVectorIterator() : _bitVector(NULL), _pos(0), _remaining(0) { }
+
+   TR_ChunkedBitVectorIterator(TR_ChunkedBitVector &bv)
+      {
+      setBitVector(bv);
+      }
+
+   void setBitVector(TR_ChunkedBitVector &bv)
+      {
+      _bitVector = &bv;
+      reset();
+      }
+
+   void reset()
+      {
+      _pos = 0;
+      _remaining = _bitVector->_size > 0 ? _bitVector->_chunks[0] : 0;
+      }
+
+   bool hasMoreElements()
+      {
+      return _pos < _bitVector->_size;
+      }
+
+   int32_t getFirstElement()
+      {
+      reset();
+      return getNextElement();
+      }
+
+   // Return the next set bit. Must only be called if hasMoreElements()
+   //
+   int32_t getNextElement()
+      {
+      int32_t bit = TR_ChunkedBitVector::firstBitInChunk(_remaining);
+      int32_t element = static_cast<int32_t>(TR_ChunkedBitVector::getBitIndex(_bitVector->_indices[_pos]) + bit);
+      _remaining &= ~TR_ChunkedBitVector::getBitMask(bit);
+      if (_remaining == 0 && ++_pos < _bitVector->_size)
+         _remaining = _bitVector->_chunks[_pos];
+      return element;
+      }
+
+   private:
+
+   TR_ChunkedBitVector *_bitVector;
+   int32_t              _pos;
+   chunk_t              _remaining;
+   };
+
+class TR_ChunkedBitVectorCursor : public TR_ChunkedBitVectorIterator
+   {
+   // CS2-like iterator
+   public:
+   TR_ChunkedBitVectorCursor(const TR_ChunkedBitVector &bv) : TR_ChunkedBitVectorIterator(const_cast<TR_ChunkedBitVector &>(bv))
+      {
+      SetToFirstOne();
+      }
+
+   bool Valid() { return _valid; }
+   operator uint32_t() { return _value; }
+   bool SetToFirstOne()
+      {
+      reset();
+      return SetToNextOne();
+      }
+   bool SetToNextOne()
+      {
+      _valid = hasMoreElements();
+      if (_valid)
+         _value = getNextElement();
+      return _valid;
+      }
+
+   private:
+   uint32_t _value;
+   bool     _valid;
+   };
+
+#endif
@@ -24,6 +24,8 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
 #include "env/TRMemory.hpp"
 #include "il/AliasSetInterface.hpp"
 #include "il/ILOps.hpp"
@@ -104,6 +106,20 @@ TR_LiveOnAllPaths                   *TR_DataFlowAnalysis::asLiveOnAllPaths()
 TR_FlowSensitiveEscapeAnalysis      *TR_DataFlowAnalysis::asFlowSensitiveEscapeAnalysis()
    {return NULL;}
 
+// Dense sets for every block of a huge method mostly hold zeros; past this
+// many bits of dense storage per analysis the chunked container is used
+//
+#define CHUNKED_DATAFLOW_SETS_THRESHOLD (1 << 24)
+
+bool TR_DataFlowAnalysis::useChunkedContainers(TR::Compilation *comp, int64_t numberOfBits, int32_t numberOfBlocks)
+   {
+   if (comp->getOption(TR_DisableChunkedDataFlowSets))
+      return false;
+   if (comp->getOption(TR_EnableChunkedDataFlowSets))
+      return true;
+   return numberOfBits * numberOfBlocks >= CHUNKED_DATAFLOW_SETS_THRESHOLD;
+   }
+
 void TR_DataFlowAnalysis::addToAnalysisQueue(TR_StructureSubGraphNode *node, uint8_t changedSets)
    {
    _analysisQueue.add(node);
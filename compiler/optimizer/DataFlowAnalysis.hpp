@@ -32,6 +32,7 @@
 #include "infra/Array.hpp"
 #include "infra/Assert.hpp"
 #include "infra/BitVector.hpp"
+#include "infra/ChunkedBitVector.hpp"
 #include "infra/Flags.hpp"
 #include "infra/HashTab.hpp"
 #include "infra/Link.hpp"
@@ -185,6 +186,16 @@ class TR_DataFlowAnalysis
    virtual TR_LiveOnAllPaths *asLiveOnAllPaths();
    virtual TR_FlowSensitiveEscapeAnalysis *asFlowSensitiveEscapeAnalysis();
 
+   /**
+    * @brief Decide whether an analysis with the given number of bits per set
+    *        should run over TR_ChunkedBitVector rather than TR_BitVector.
+    *
+    * The chunked container is used when the dense sets for every block would
+    * be large, or always/never under the enableChunkedDataFlowSets and
+    * disableChunkedDataFlowSets options.
+    */
+   static bool useChunkedContainers(TR::Compilation *comp, int64_t numberOfBits, int32_t numberOfBlocks);
+
    void addToAnalysisQueue(TR_StructureSubGraphNode *, uint8_t);
    void removeHeadFromAnalysisQueue();
 
@@ -442,6 +453,17 @@ class TR_IntersectionBitVectorAnalysis : public TR_IntersectionDFSetAnalysis<TR_
       }
    };
 
+// Variant for analyses over very large candidate sets, storing only the
+// non-zero chunks of each set (see TR_ChunkedBitVector)
+//
+class TR_IntersectionChunkedBitVectorAnalysis : public TR_IntersectionDFSetAnalysis<TR_ChunkedBitVector *>
+   {
+   public:
+   typedef TR_ChunkedBitVector ContainerType;
+   TR_IntersectionChunkedBitVectorAnalysis(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, bool trace)
+      : TR_IntersectionDFSetAnalysis<TR_ChunkedBitVector *>(comp, cfg, optimizer, trace) {}
+   };
+
 // Forward union bit vector analysis
 //
 template<class Container>class TR_UnionDFSetAnalysis<Container *> : public TR_ForwardDFSetAnalysis<Container *>
@@ -477,6 +499,14 @@ class TR_UnionSingleBitContainerAnalysis : public TR_UnionDFSetAnalysis<TR_Singl
       TR_UnionDFSetAnalysis<TR_SingleBitContainer *>(comp, cfg, optimizer, trace) {}
   };
 
+class TR_UnionChunkedBitVectorAnalysis : public TR_UnionDFSetAnalysis<TR_ChunkedBitVector *>
+   {
+   public:
+   typedef TR_ChunkedBitVector ContainerType;
+   TR_UnionChunkedBitVectorAnalysis(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, bool trace) :
+      TR_UnionDFSetAnalysis<TR_ChunkedBitVector *>(comp, cfg, optimizer, trace) {}
+   };
+
 class TR_ReachingDefinitions : public TR_UnionBitVectorAnalysis
    {
    public:
@@ -496,7 +526,33 @@ class TR_ReachingDefinitions : public TR_UnionBitVectorAnalysis
 
    private:
 
-   void initializeGenAndKillSetInfoForNode(TR::Node *node, TR_BitVector &defsKilled, bool seenException, int32_t blockNum, TR::Node *parent);
+   TR_UseDefInfo *_useDefInfo;
+   TR_UseDefInfo::AuxiliaryData &_aux;
+   bool           _traceRD;
+   };
+
+// Reaching definitions over chunked sets, for methods where the dense sets
+// would be too large (see TR_DataFlowAnalysis::useChunkedContainers).
+// Computes the same solution as TR_ReachingDefinitions.
+//
+class TR_ChunkedReachingDefinitions : public TR_UnionChunkedBitVectorAnalysis
+   {
+   public:
+
+   TR_ChunkedReachingDefinitions(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, TR_UseDefInfo *, TR_UseDefInfo::AuxiliaryData &aux, bool trace);
+
+   bool traceRD() { return _traceRD; }
+
+   virtual int32_t perform();
+
+   virtual Kind getKind();
+
+   virtual int32_t getNumberOfBits();
+   virtual void analyzeBlockZeroStructure(TR_BlockStructure *);
+   virtual bool supportsGenAndKillSets();
+   virtual void initializeGenAndKillSetInfo();
+
+   private:
 
    TR_UseDefInfo *_useDefInfo;
    TR_UseDefInfo::AuxiliaryData &_aux;
@@ -582,6 +638,15 @@ class TR_BackwardIntersectionBitVectorAnalysis :
       : TR_BackwardIntersectionDFSetAnalysis<TR_BitVector *>(comp, cfg, optimizer, trace) { }
    };
 
+class TR_BackwardIntersectionChunkedBitVectorAnalysis :
+   public TR_BackwardIntersectionDFSetAnalysis<TR_ChunkedBitVector *>
+   {
+   public:
+   typedef TR_ChunkedBitVector ContainerType;
+   TR_BackwardIntersectionChunkedBitVectorAnalysis(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, bool trace)
+      : TR_BackwardIntersectionDFSetAnalysis<TR_ChunkedBitVector *>(comp, cfg, optimizer, trace) { }
+   };
+
 // Backward union bit vector analysis
 //
 template<class Container>class TR_BackwardUnionDFSetAnalysis<Container *> :
@@ -618,6 +683,15 @@ class TR_BackwardUnionSingleBitContainerAnalysis :
       : TR_BackwardUnionDFSetAnalysis<TR_SingleBitContainer *>(comp, cfg, optimizer, trace) { }
    };
 
+class TR_BackwardUnionChunkedBitVectorAnalysis :
+   public TR_BackwardUnionDFSetAnalysis<TR_ChunkedBitVector *>
+   {
+   public:
+   typedef TR_ChunkedBitVector ContainerType;
+   TR_BackwardUnionChunkedBitVectorAnalysis(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, bool trace)
+      : TR_BackwardUnionDFSetAnalysis<TR_ChunkedBitVector *>(comp, cfg, optimizer, trace) { }
+   };
+
 // First dataflow analysis in Partial Redundancy Elimination
 //
 class TR_GlobalAnticipatability
@@ -870,6 +944,29 @@ class TR_Liveness : public TR_BackwardUnionBitVectorAnalysis
    bool    _traceLiveness;
    };
 
+// Liveness over chunked sets, used by TR_Liveness for methods where the
+// dense sets would be too large (see TR_DataFlowAnalysis::useChunkedContainers).
+// The solution is copied back into TR_Liveness's dense block info.
+//
+class TR_ChunkedLiveness : public TR_BackwardUnionChunkedBitVectorAnalysis
+   {
+   public:
+
+   TR_ChunkedLiveness(TR::Compilation *comp, TR::Optimizer *optimizer, TR_Structure *, TR_LiveVariableInformation *liveVariableInfo);
+
+   virtual Kind getKind();
+
+   virtual int32_t getNumberOfBits();
+   virtual bool supportsGenAndKillSets();
+   virtual void initializeGenAndKillSetInfo();
+   virtual void analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, TR_ChunkedBitVector *);
+   virtual void analyzeTreeTopsInBlockStructure(TR_BlockStructure *);
+
+   private:
+
+   TR_LiveVariableInformation *_liveVariableInfo;
+   };
+
 // Live on all paths (LOAP) - analysis that identifies when a variable definition is
 // live on all subsequent paths.
 // Backward Intersection BitVector analysis.
@@ -418,8 +418,16 @@ TR_GlobalRegisterAllocator::perform()
          _candidatesSignExtendedInThisLoop = new (trStackMemory()) TR_BitVector(_origSymRefCount, trMemory(), stackAlloc);
          }
 
+      // Linear scan assignment takes every auto and parm as a candidate and
+      // skips the loop and if-then candidate searches, trading some register
+      // quality for compile time at low opt levels
+      //
+      bool useLinearScan = comp()->getMethodHotness() <= comp()->getOptions()->getLinearScanGRAMaxOptLevel();
+      if (useLinearScan && trace())
+         traceMsg(comp(), "Using linear scan register assignment\n");
+
       candidates->getReferencedAutoSymRefs(comp()->trMemory()->currentStackRegion());
-      if (!comp()->mayHaveLoops() || cg()->considerAllAutosAsTacticalGlobalRegisterCandidates())
+      if (useLinearScan || !comp()->mayHaveLoops() || cg()->considerAllAutosAsTacticalGlobalRegisterCandidates())
          offerAllAutosAndRegisterParmAsCandidates(cfgBlocks, numberOfBlocks);
       else
          offerAllFPAutosAndParmsAsCandidates(cfgBlocks, numberOfBlocks);
@@ -433,9 +441,12 @@ TR_GlobalRegisterAllocator::perform()
          (*_registerCandidates)[rc->getSymbolReference()->getReferenceNumber()] = rc;
          }
 
-      findIfThenRegisterCandidates();
+      if (!useLinearScan)
+         {
+         findIfThenRegisterCandidates();
 
-      findLoopAutoRegisterCandidates();
+         findLoopAutoRegisterCandidates();
+         }
 
       if (comp()->getOptions()->realTimeGC() &&
           comp()->compilationShouldBeInterrupted(GRA_AFTER_FIND_LOOP_AUTO_CONTEXT))
@@ -472,7 +483,10 @@ TR_GlobalRegisterAllocator::perform()
       //
       if (canAffordAssignment)
          {
-         globalFPAssignmentDone = _candidates->assign(cfgBlocks, numberOfBlocks, _firstGlobalRegisterNumber, _lastGlobalRegisterNumber);
+         if (useLinearScan)
+            globalFPAssignmentDone = _candidates->assignLinearScan(cfgBlocks, numberOfBlocks, _firstGlobalRegisterNumber, _lastGlobalRegisterNumber);
+         else
+            globalFPAssignmentDone = _candidates->assign(cfgBlocks, numberOfBlocks, _firstGlobalRegisterNumber, _lastGlobalRegisterNumber);
 
          if (_lastGlobalRegisterNumber > -1)
             {
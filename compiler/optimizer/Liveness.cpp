@@ -21,6 +21,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "env/StackMemoryRegion.hpp"
 #include "compile/Compilation.hpp"
 #include "control/Options.hpp"
@@ -29,6 +30,7 @@
 #include "il/Node.hpp"
 #include "infra/Assert.hpp"
 #include "infra/BitVector.hpp"
+#include "infra/ChunkedBitVector.hpp"
 #include "optimizer/DataFlowAnalysis.hpp"
 
 class TR_BlockStructure;
@@ -94,7 +96,25 @@ TR_Liveness::TR_Liveness(TR::Compilation           *comp,
    {
    TR::StackMemoryRegion stackMemoryRegion(*trMemory());
 
-   performAnalysis(rootStructure, false);
+   if (useChunkedContainers(comp, _liveVariableInfo->numLocals(), _numberOfNodes))
+      {
+      if (traceLiveness())
+         traceMsg(comp, "Using chunked bit vectors for %d locals\n", _liveVariableInfo->numLocals());
+
+      // Solve over chunked sets and expand the solution into the dense block
+      // info that clients of TR_Liveness expect
+      //
+      TR_ChunkedLiveness chunkedLiveness(comp, optimizer, rootStructure, _liveVariableInfo);
+      for (int32_t i = 0; i < _numberOfNodes; ++i)
+         {
+         if (chunkedLiveness._blockAnalysisInfo[i])
+            *_blockAnalysisInfo[i] = *chunkedLiveness._blockAnalysisInfo[i];
+         else
+            _blockAnalysisInfo[i]->empty();
+         }
+      }
+   else
+      performAnalysis(rootStructure, false);
 
    if (traceLiveness())
       {
@@ -154,3 +174,74 @@ void TR_Liveness::analyzeTreeTopsInBlockStructure(TR_BlockStructure *blockStruct
    {
    TR_ASSERT(false, "Liveness should use gen and kill sets");
    }
+
+
+TR_DataFlowAnalysis::Kind TR_ChunkedLiveness::getKind()
+   {
+   return Liveness;
+   }
+
+bool TR_ChunkedLiveness::supportsGenAndKillSets()
+   {
+   return true;
+   }
+
+int32_t TR_ChunkedLiveness::getNumberOfBits()
+   {
+   return _liveVariableInfo->numLocals();
+   }
+
+void TR_ChunkedLiveness::analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, TR_ChunkedBitVector *)
+   {
+   }
+
+TR_ChunkedLiveness::TR_ChunkedLiveness(TR::Compilation            *comp,
+                                       TR::Optimizer              *optimizer,
+                                       TR_Structure               *rootStructure,
+                                       TR_LiveVariableInformation *liveVariableInfo)
+   : TR_BackwardUnionChunkedBitVectorAnalysis(comp, comp->getFlowGraph(), optimizer, comp->getOption(TR_TraceLiveness)),
+     _liveVariableInfo(liveVariableInfo)
+   {
+   initializeBlockInfo();
+   performAnalysis(rootStructure, false);
+   }
+
+void TR_ChunkedLiveness::initializeGenAndKillSetInfo()
+   {
+   // TR_LiveVariableInformation builds dense sets; allocate the chunked sets
+   // first so that they outlive the dense ones, which are dropped as soon as
+   // they have been compressed
+   //
+   TR_ChunkedBitVector **sets[4] = { _regularGenSetInfo, _regularKillSetInfo, _exceptionGenSetInfo, _exceptionKillSetInfo };
+   for (int32_t s = 0; s < 4; ++s)
+      for (int32_t i = 0; i < _numberOfNodes; ++i)
+         allocateContainer(&sets[s][i]);
+
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   int32_t arraySize = _numberOfNodes * sizeof(TR_BitVector *);
+   TR_BitVector **denseSets[4];
+   for (int32_t s = 0; s < 4; ++s)
+      {
+      denseSets[s] = (TR_BitVector **)trMemory()->allocateStackMemory(arraySize);
+      memset(denseSets[s], 0, arraySize);
+      }
+
+   _liveVariableInfo->initializeGenAndKillSetInfo(denseSets[0], denseSets[1], denseSets[2], denseSets[3]);
+
+   for (int32_t s = 0; s < 4; ++s)
+      {
+      for (int32_t i = 0; i < _numberOfNodes; ++i)
+         {
+         if (denseSets[s][i])
+            *sets[s][i] = *denseSets[s][i];
+         else
+            sets[s][i] = NULL;
+         }
+      }
+   }
+
+void TR_ChunkedLiveness::analyzeTreeTopsInBlockStructure(TR_BlockStructure *blockStructure)
+   {
+   TR_ASSERT(false, "Liveness should use gen and kill sets");
+   }
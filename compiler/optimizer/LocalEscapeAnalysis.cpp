@@ -0,0 +1,521 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "optimizer/LocalEscapeAnalysis.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/ObjectModel.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/AutomaticSymbol.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Assert.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/TransformUtil.hpp"
+#include "ras/Debug.hpp"
+
+#define OPT_DETAILS "O^O LOCAL ESCAPE ANALYSIS: "
+
+// Allocations with more fields than this are left alone rather than
+// creating a temporary per field
+#define MAX_SCALAR_FIELDS 16
+
+// Largest array allocated on the stack, in bytes including the header
+#define MAX_STACK_ALLOCATION_SIZE 512
+
+TR_LocalEscapeAnalysis::TR_LocalEscapeAnalysis(TR::OptimizationManager *manager)
+   : TR::Optimization(manager)
+   {}
+
+int32_t
+TR_LocalEscapeAnalysis::perform()
+   {
+   if (!comp()->getMethodSymbol()->hasNews())
+      return 0;
+
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   // Find allocations stored into an auto
+   //
+   CandidateMap candidates(std::less<TR::Symbol *>(), stackMemoryRegion);
+   TR::vector<Candidate *, TR::Region&> candidateList(stackMemoryRegion);
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (!node->getOpCode().isStoreDirect() || node->getDataType() != TR::Address)
+         continue;
+
+      TR::Symbol *sym = node->getSymbol();
+      if (!sym->isAuto() || sym->isLocalObject() || sym->isInternalPointer() || candidates.find(sym) != candidates.end())
+         continue;
+
+      TR::Node *allocation = node->getFirstChild();
+      TR::ILOpCodes op = allocation->getOpCodeValue();
+      if ((op != TR::New && op != TR::newarray && op != TR::anewarray) || allocation->getReferenceCount() != 1)
+         continue;
+
+      int32_t length = -1;
+      if (op != TR::New)
+         {
+         TR::Node *size = allocation->getFirstChild();
+         if (size->getOpCodeValue() != TR::iconst || size->getInt() < 0)
+            continue;
+         length = size->getInt();
+         }
+
+      Candidate *candidate = new (stackMemoryRegion) Candidate(stackMemoryRegion);
+      candidate->_allocationTree = tt;
+      candidate->_allocation = allocation;
+      candidate->_temp = sym;
+      candidate->_length = length;
+      candidates.insert(std::make_pair(sym, candidate));
+      candidateList.push_back(candidate);
+      }
+
+   if (candidateList.empty())
+      return 0;
+
+   // Classify every reference to the autos
+   //
+   vcount_t visitCount = comp()->incVisitCount();
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      findUses(candidates, tt->getNode(), NULL, 0, visitCount);
+
+   int32_t transformed = 0;
+   for (auto c = candidateList.begin(); c != candidateList.end(); ++c)
+      {
+      Candidate &candidate = **c;
+      if (candidate._escapes)
+         continue;
+
+      if (candidate._numStores != 1)
+         {
+         if (trace())
+            traceMsg(comp(), "Allocation n%dn: #%d has %d definitions\n", candidate._allocation->getGlobalIndex(),
+               candidate._allocationTree->getNode()->getSymbolReference()->getReferenceNumber(), candidate._numStores);
+         continue;
+         }
+
+      TR::DataType elementType = TR::NoType;
+      if (collectFields(candidate))
+         {
+         if (!performTransformation(comp(), "%sReplacing allocation n%dn with %d scalars\n", OPT_DETAILS,
+               candidate._allocation->getGlobalIndex(), (int32_t)candidate._fields.size()))
+            continue;
+
+         replaceWithScalars(candidate);
+         transformed++;
+         }
+      else if (canAllocateOnStack(candidate, elementType))
+         {
+         if (!performTransformation(comp(), "%sAllocating array n%dn of %d %s elements on the stack\n", OPT_DETAILS,
+               candidate._allocation->getGlobalIndex(), candidate._length, elementType.toString()))
+            continue;
+
+         allocateOnStack(candidate, elementType);
+         transformed++;
+         }
+      }
+
+   if (transformed > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      optimizer()->setAliasSetsAreValid(false);
+      requestOpt(OMR::localDeadStoreElimination);
+      }
+
+   return transformed;
+   }
+
+const char *
+TR_LocalEscapeAnalysis::optDetailString() const throw()
+   {
+   return "O^O LOCAL ESCAPE ANALYSIS: ";
+   }
+
+TR_LocalEscapeAnalysis::Candidate *
+TR_LocalEscapeAnalysis::getCandidate(CandidateMap &candidates, TR::Node *node)
+   {
+   if (!node->getOpCode().hasSymbolReference())
+      return NULL;
+
+   auto found = candidates.find(node->getSymbol());
+   return found != candidates.end() ? found->second : NULL;
+   }
+
+void
+TR_LocalEscapeAnalysis::markEscape(Candidate *candidate, TR::Node *node, const char *reason)
+   {
+   if (!candidate->_escapes && trace())
+      traceMsg(comp(), "Allocation n%dn escapes at n%dn: %s\n", candidate->_allocation->getGlobalIndex(), node->getGlobalIndex(), reason);
+   candidate->_escapes = true;
+   }
+
+/**
+ * Checks the context of every occurrence of a node that refers to one of the
+ * candidates, and records the accesses the first time they are seen.
+ */
+void
+TR_LocalEscapeAnalysis::findUses(CandidateMap &candidates, TR::Node *node, TR::Node *parent, int32_t childIndex, vcount_t visitCount)
+   {
+   TR::ILOpCode &opCode = node->getOpCode();
+
+   // The reference checked by a null check has to stay a reference
+   //
+   if (opCode.isNullCheck() && node->getNullCheckReference()->getOpCode().isLoadVarDirect())
+      {
+      Candidate *candidate = getCandidate(candidates, node->getNullCheckReference());
+      if (candidate)
+         markEscape(candidate, node, "null checked");
+      }
+
+   if (opCode.isLoadVarDirect())
+      {
+      Candidate *candidate = getCandidate(candidates, node);
+      if (candidate)
+         {
+         bool validUse = false;
+         if (parent != NULL && childIndex == 0)
+            {
+            TR::ILOpCode &parentOpCode = parent->getOpCode();
+            if ((parentOpCode.isLoadIndirect() || parentOpCode.isStoreIndirect()) &&
+                !parentOpCode.isWrtBar() && !parentOpCode.isReadBar())
+               validUse = true;
+            else if (parent->getOpCodeValue() == TR::arraylength && candidate->_length >= 0)
+               validUse = true;
+            else if (parent->getOpCodeValue() == TR::aladd || parent->getOpCodeValue() == TR::aiadd)
+               validUse = true;  // the uses of the add are checked on their own
+            }
+
+         if (!validUse)
+            markEscape(candidate, node, parent ? parent->getOpCode().getName() : "anchored");
+         }
+      }
+   else if ((node->getOpCodeValue() == TR::aladd || node->getOpCodeValue() == TR::aiadd) &&
+            node->getFirstChild()->getOpCode().isLoadVarDirect())
+      {
+      Candidate *candidate = getCandidate(candidates, node->getFirstChild());
+      if (candidate &&
+          (parent == NULL || childIndex != 0 ||
+           !(parent->getOpCode().isLoadIndirect() || parent->getOpCode().isStoreIndirect()) ||
+           parent->getOpCode().isWrtBar() || parent->getOpCode().isReadBar()))
+         markEscape(candidate, node, "address arithmetic");
+      }
+   else if (opCode.isStoreDirect())
+      {
+      Candidate *candidate = getCandidate(candidates, node);
+      if (candidate && node->getVisitCount() != visitCount)
+         {
+         candidate->_numStores++;
+         if (node != candidate->_allocationTree->getNode())
+            markEscape(candidate, node, "redefined");
+         }
+      }
+   else if (node->getOpCodeValue() == TR::loadaddr)
+      {
+      Candidate *candidate = getCandidate(candidates, node);
+      if (candidate)
+         markEscape(candidate, node, "address taken");
+      }
+
+   if (node->getVisitCount() == visitCount)
+      return;
+   node->setVisitCount(visitCount);
+
+   if ((opCode.isLoadIndirect() || opCode.isStoreIndirect()) && !opCode.isWrtBar() && !opCode.isReadBar())
+      {
+      TR::Node *base = node->getFirstChild();
+      if (base->getOpCodeValue() == TR::aladd || base->getOpCodeValue() == TR::aiadd)
+         base = base->getFirstChild();
+
+      if (base->getOpCode().isLoadVarDirect())
+         {
+         Candidate *candidate = getCandidate(candidates, base);
+         if (candidate)
+            recordAccess(candidate, node);
+         }
+      }
+   else if (node->getOpCodeValue() == TR::arraylength && node->getFirstChild()->getOpCode().isLoadVarDirect())
+      {
+      Candidate *candidate = getCandidate(candidates, node->getFirstChild());
+      if (candidate)
+         {
+         Access access = { node, 0, true };
+         candidate->_accesses.push_back(access);
+         }
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); ++i)
+      findUses(candidates, node->getChild(i), node, i, visitCount);
+   }
+
+void
+TR_LocalEscapeAnalysis::recordAccess(Candidate *candidate, TR::Node *access)
+   {
+   TR::SymbolReference *symRef = access->getSymbolReference();
+   if (symRef->isUnresolved())
+      {
+      markEscape(candidate, access, "unresolved field");
+      return;
+      }
+
+   switch (access->getDataType())
+      {
+      case TR::Int8:
+      case TR::Int16:
+      case TR::Int32:
+      case TR::Int64:
+      case TR::Float:
+      case TR::Double:
+      case TR::Address:
+         break;
+      default:
+         markEscape(candidate, access, "unsupported field type");
+         return;
+      }
+
+   Access record = { access, symRef->getOffset(), true };
+   TR::Node *base = access->getFirstChild();
+   if (base->getOpCodeValue() == TR::aladd || base->getOpCodeValue() == TR::aiadd)
+      {
+      TR::Node *offset = base->getSecondChild();
+      if (offset->getOpCodeValue() == TR::lconst)
+         record._offset += offset->getLongInt();
+      else if (offset->getOpCodeValue() == TR::iconst)
+         record._offset += offset->getInt();
+      else
+         record._constantOffset = false;
+      }
+
+   // Accesses inside the header (e.g. a class pointer) cannot be replaced
+   //
+   uintptr_t headerSize = candidate->_length >= 0 ?
+      TR::Compiler->om.contiguousArrayHeaderSizeInBytes() : TR::Compiler->om.objectHeaderSizeInBytes();
+   if (record._constantOffset && record._offset < (int64_t)headerSize)
+      {
+      markEscape(candidate, access, "header access");
+      return;
+      }
+
+   candidate->_accesses.push_back(record);
+   }
+
+/**
+ * Collects the distinct fields accessed through the candidate, ordered by
+ * offset. Returns false if the candidate cannot be replaced by scalars.
+ */
+bool
+TR_LocalEscapeAnalysis::collectFields(Candidate &candidate)
+   {
+   for (auto a = candidate._accesses.begin(); a != candidate._accesses.end(); ++a)
+      {
+      if (a->_node->getOpCodeValue() == TR::arraylength)
+         continue;
+
+      if (!a->_constantOffset)
+         return false;
+
+      TR::DataType type = a->_node->getDataType();
+      bool found = false;
+      for (auto f = candidate._fields.begin(); f != candidate._fields.end() && !found; ++f)
+         {
+         if (f->_offset != a->_offset)
+            continue;
+         if (f->_type != type)
+            return false;  // the same bytes are accessed as different types
+         found = true;
+         }
+
+      if (found)
+         continue;
+
+      if (candidate._fields.size() == MAX_SCALAR_FIELDS)
+         return false;
+
+      // Insert in offset order
+      //
+      Field field = { a->_offset, type, NULL };
+      auto f = candidate._fields.begin();
+      while (f != candidate._fields.end() && f->_offset < a->_offset)
+         ++f;
+      candidate._fields.insert(f, field);
+      }
+
+   // Fields must not partially overlap
+   //
+   for (size_t i = 1; i < candidate._fields.size(); ++i)
+      {
+      Field &previous = candidate._fields[i - 1];
+      if (previous._offset + TR::DataType::getSize(previous._type) > candidate._fields[i]._offset)
+         return false;
+      }
+
+   return true;
+   }
+
+/**
+ * Answers whether the candidate is a primitive array whose elements are all
+ * accessed as the same type, small enough to be allocated on the stack.
+ */
+bool
+TR_LocalEscapeAnalysis::canAllocateOnStack(Candidate &candidate, TR::DataType &elementType)
+   {
+   if (candidate._allocation->getOpCodeValue() != TR::newarray)
+      return false;
+
+   elementType = TR::NoType;
+   for (auto a = candidate._accesses.begin(); a != candidate._accesses.end(); ++a)
+      {
+      if (a->_node->getOpCodeValue() == TR::arraylength)
+         continue;
+
+      TR::DataType type = a->_node->getDataType();
+      if (type == TR::Address || (elementType != TR::NoType && elementType != type))
+         return false;
+      elementType = type;
+      }
+
+   if (elementType == TR::NoType)
+      return false;
+
+   int64_t size = TR::Compiler->om.contiguousArrayHeaderSizeInBytes() +
+                  (int64_t)candidate._length * TR::DataType::getSize(elementType);
+   return size > 0 && size <= MAX_STACK_ALLOCATION_SIZE;
+   }
+
+void
+TR_LocalEscapeAnalysis::foldArrayLengths(Candidate &candidate)
+   {
+   for (auto a = candidate._accesses.begin(); a != candidate._accesses.end(); ++a)
+      {
+      TR::Node *node = a->_node;
+      if (node->getOpCodeValue() != TR::arraylength)
+         continue;
+
+      node->getFirstChild()->recursivelyDecReferenceCount();
+      node->setNumChildren(0);
+      TR::Node::recreate(node, TR::iconst);
+      node->setInt(candidate._length);
+      }
+   }
+
+void
+TR_LocalEscapeAnalysis::replaceWithScalars(Candidate &candidate)
+   {
+   TR::Node *origin = candidate._allocation;
+
+   // Each field starts out zeroed, as in a freshly allocated object
+   //
+   for (auto f = candidate._fields.begin(); f != candidate._fields.end(); ++f)
+      {
+      f->_symRef = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), f->_type);
+      TR::Node *zero = TR::Node::createConstZeroValue(origin, f->_type);
+      candidate._allocationTree->insertBefore(TR::TreeTop::create(comp(), TR::Node::createStore(f->_symRef, zero)));
+
+      if (trace())
+         traceMsg(comp(), "   field at offset %lld of type %s is #%d\n", (long long)f->_offset, f->_type.toString(),
+            f->_symRef->getReferenceNumber());
+      }
+
+   for (auto a = candidate._accesses.begin(); a != candidate._accesses.end(); ++a)
+      {
+      TR::Node *node = a->_node;
+      if (node->getOpCodeValue() == TR::arraylength)
+         continue;
+
+      TR::SymbolReference *fieldSymRef = NULL;
+      for (auto f = candidate._fields.begin(); f != candidate._fields.end(); ++f)
+         {
+         if (f->_offset == a->_offset)
+            fieldSymRef = f->_symRef;
+         }
+      TR_ASSERT(fieldSymRef, "no scalar for the access at offset %lld", (long long)a->_offset);
+
+      TR::DataType type = node->getDataType();
+      TR::Node *address = node->getFirstChild();
+      if (node->getOpCode().isStore())
+         {
+         TR::Node *value = node->getSecondChild();
+         node->setChild(0, value);
+         node->setChild(1, NULL);
+         node->setNumChildren(1);
+         TR::Node::recreateWithSymRef(node, comp()->il.opCodeForDirectStore(type), fieldSymRef);
+         }
+      else
+         {
+         node->setNumChildren(0);
+         TR::Node::recreateWithSymRef(node, comp()->il.opCodeForDirectLoad(type), fieldSymRef);
+         }
+      address->recursivelyDecReferenceCount();
+      }
+
+   foldArrayLengths(candidate);
+   TR::TransformUtil::removeTree(comp(), candidate._allocationTree);
+   }
+
+void
+TR_LocalEscapeAnalysis::allocateOnStack(Candidate &candidate, TR::DataType elementType)
+   {
+   TR::Node *allocation = candidate._allocation;
+   int32_t size = TR::Compiler->om.contiguousArrayHeaderSizeInBytes() + candidate._length * TR::DataType::getSize(elementType);
+
+   TR::Node *arrayType = allocation->getSecondChild();
+   TR::SymbolReference *localSymRef = comp()->getSymRefTab()->createLocalPrimArray(size, comp()->getMethodSymbol(),
+      arrayType->getOpCode().isLoadConst() ? arrayType->getInt() : 0);
+
+   // The array reference now points into the frame, so it must not be
+   // reported to the GC
+   //
+   candidate._temp->setNotCollected();
+
+   allocation->getFirstChild()->recursivelyDecReferenceCount();
+   allocation->getSecondChild()->recursivelyDecReferenceCount();
+   allocation->setNumChildren(0);
+   TR::Node::recreateWithSymRef(allocation, TR::loadaddr, localSymRef);
+
+   TR::Node *length = comp()->target().is64Bit() ?
+      TR::Node::lconst(allocation, size) : TR::Node::iconst(allocation, size);
+   TR::Node *arrayset = TR::Node::create(TR::arrayset, 3,
+      TR::Node::createWithSymRef(allocation, TR::loadaddr, 0, localSymRef),
+      TR::Node::bconst(allocation, 0),
+      length);
+   arrayset->setSymbolReference(comp()->getSymRefTab()->findOrCreateArraySetSymbol());
+   candidate._allocationTree->insertBefore(TR::TreeTop::create(comp(), TR::Node::create(TR::treetop, 1, arrayset)));
+
+   foldArrayLengths(candidate);
+   }
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef LOCALESCAPEANALYSIS_INCL
+#define LOCALESCAPEANALYSIS_INCL
+
+#include <stdint.h>
+#include <map>
+#include "env/TRMemory.hpp"
+#include "il/DataTypes.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+namespace TR { class Node; }
+namespace TR { class Symbol; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/*
+ * Class TR_LocalEscapeAnalysis
+ * ============================
+ *
+ * Language neutral escape analysis for allocations whose reference never
+ * leaves the method. It is the default implementation of the escapeAnalysis
+ * optimization; a front end with knowledge of its object layout can register
+ * its own in place of this one.
+ *
+ * A candidate is a new, newarray or anewarray (with a constant length) whose
+ * result is stored into an auto that has no other definition and whose
+ * address is never taken. The allocation does not escape when every load of
+ * that auto is only used
+ *
+ *    - as the base of an indirect load or store (not a write barrier),
+ *    - as the base of an aladd/aiadd that is the address of such an access, or
+ *    - under an arraylength.
+ *
+ * Storing the reference anywhere, passing it to a call, comparing it or
+ * null checking it makes the allocation escape.
+ *
+ * A non-escaping allocation whose accesses are all at constant offsets past
+ * the object (or array) header reported by TR::ObjectModel, and do not
+ * partially overlap, is replaced by one temporary per field. The temporaries
+ * are zeroed where the allocation was, which keeps the semantics of an
+ * allocation executed repeatedly in a loop: only the most recent object is
+ * reachable through the auto.
+ *
+ * A non-escaping primitive newarray that is indexed at variable offsets is
+ * instead allocated on the stack as a local object of the size implied by
+ * its constant length and the element type of its accesses, and zeroed with
+ * an arrayset. The array header is never read once arraylength is folded to
+ * the constant length, so it is left uninitialized.
+ */
+class TR_LocalEscapeAnalysis : public TR::Optimization
+   {
+   public:
+   TR_LocalEscapeAnalysis(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_LocalEscapeAnalysis(manager);
+      }
+
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   struct Access
+      {
+      TR::Node     *_node;      // the indirect load or store, or the arraylength
+      int64_t       _offset;    // byte offset from the object reference
+      bool          _constantOffset;
+      };
+
+   struct Field
+      {
+      int64_t              _offset;
+      TR::DataType         _type;
+      TR::SymbolReference *_symRef;
+      };
+
+   struct Candidate
+      {
+      Candidate(TR::Region &region)
+         : _allocationTree(NULL), _allocation(NULL), _temp(NULL), _length(-1), _numStores(0),
+           _escapes(false), _accesses(region), _fields(region)
+         {}
+
+      TR::TreeTop   *_allocationTree;
+      TR::Node      *_allocation;
+      TR::Symbol    *_temp;
+      int32_t        _length;    // number of elements, or -1 for new
+      int32_t        _numStores;
+      bool           _escapes;
+      TR::vector<Access, TR::Region&> _accesses;
+      TR::vector<Field, TR::Region&>  _fields;
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Symbol * const, Candidate *>, TR::Region&> CandidateMapAlloc;
+   typedef std::map<TR::Symbol *, Candidate *, std::less<TR::Symbol *>, CandidateMapAlloc> CandidateMap;
+
+   Candidate *getCandidate(CandidateMap &candidates, TR::Node *node);
+   void findUses(CandidateMap &candidates, TR::Node *node, TR::Node *parent, int32_t childIndex, vcount_t visitCount);
+   void recordAccess(Candidate *candidate, TR::Node *access);
+   void markEscape(Candidate *candidate, TR::Node *node, const char *reason);
+
+   bool collectFields(Candidate &candidate);
+   bool canAllocateOnStack(Candidate &candidate, TR::DataType &elementType);
+   void replaceWithScalars(Candidate &candidate);
+   void allocateOnStack(Candidate &candidate, TR::DataType elementType);
+   void foldArrayLengths(Candidate &candidate);
+   };
+
+#endif
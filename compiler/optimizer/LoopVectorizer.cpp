@@ -0,0 +1,867 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/LoopVectorizer.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Assert.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/Checklist.hpp"
+#include "optimizer/InductionVariable.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/Structure.hpp"
+#include "optimizer/TransformUtil.hpp"
+#include "ras/Debug.hpp"
+
+#define OPT_DETAILS "O^O LOOP VECTORIZATION: "
+
+// Vector IL opcodes operate on 128-bit registers
+#define VECTOR_SIZE_IN_BYTES 16
+
+// Every pair of accesses to distinct bases costs a runtime test in the guard
+#define MAX_ALIAS_CHECKS 8
+
+TR_LoopVectorizer::TR_LoopVectorizer(TR::OptimizationManager *manager)
+   : TR::Optimization(manager)
+   {}
+
+int32_t
+TR_LoopVectorizer::perform()
+   {
+   if (comp()->getOption(TR_DisableAutoSIMD) ||
+       !cg()->getSupportsAutoSIMD() ||
+       !comp()->target().is64Bit())
+      return 0;
+
+   TR_Structure *rootStructure = comp()->getFlowGraph()->getStructure();
+   if (!rootStructure)
+      return 0;
+
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   TR::vector<TR_RegionStructure *, TR::Region&> loops(stackMemoryRegion);
+   collectInnermostLoops(rootStructure, loops);
+
+   // Analyze every loop before touching the CFG so that the structure used by
+   // the analysis stays valid
+   //
+   TR::vector<CandidateLoop *, TR::Region&> candidates(stackMemoryRegion);
+   for (auto loop = loops.begin(); loop != loops.end(); ++loop)
+      {
+      CandidateLoop *candidate = new (stackMemoryRegion) CandidateLoop(stackMemoryRegion);
+      candidate->_loop = *loop;
+      if (analyzeLoop(*candidate))
+         candidates.push_back(candidate);
+      }
+
+   bool transformed = false;
+   for (auto candidate = candidates.begin(); candidate != candidates.end(); ++candidate)
+      {
+      if (!performTransformation(comp(), "%sVectorizing loop %d (block_%d) with %d lanes of %s\n", OPT_DETAILS,
+            (*candidate)->_loop->getNumber(), (*candidate)->_body->getNumber(),
+            (*candidate)->_vectorLength, (*candidate)->_elementType.toString()))
+         continue;
+
+      // The CFG edges added below are not reflected in the structure
+      //
+      if (!transformed)
+         comp()->getFlowGraph()->setStructure(NULL);
+
+      transformLoop(**candidate);
+      transformed = true;
+      }
+
+   if (transformed)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      }
+
+   return transformed ? 1 : 0;
+   }
+
+const char *
+TR_LoopVectorizer::optDetailString() const throw()
+   {
+   return "O^O LOOP VECTORIZATION: ";
+   }
+
+void
+TR_LoopVectorizer::collectInnermostLoops(TR_Structure *str, TR::vector<TR_RegionStructure *, TR::Region&> &loops)
+   {
+   TR_RegionStructure *region = str->asRegion();
+   if (!region)
+      return;
+
+   TR_RegionStructure::Cursor si(*region);
+   for (TR_StructureSubGraphNode *node = si.getCurrent(); node; node = si.getNext())
+      collectInnermostLoops(node->getStructure(), loops);
+
+   // Loops that contain other loops are rejected by the single block test
+   //
+   if (region->isNaturalLoop())
+      loops.push_back(region);
+   }
+
+bool
+TR_LoopVectorizer::analyzeLoop(CandidateLoop &candidate)
+   {
+   if (trace())
+      traceMsg(comp(), "Analyzing loop %d\n", candidate._loop->getNumber());
+
+   if (!analyzeControlFlow(candidate))
+      {
+      if (trace())
+         traceMsg(comp(), "   not a counted single block loop\n");
+      return false;
+      }
+
+   if (!analyzeBody(candidate))
+      {
+      if (trace())
+         traceMsg(comp(), "   body of block_%d cannot be vectorized\n", candidate._body->getNumber());
+      return false;
+      }
+
+   if (!analyzeDependences(candidate))
+      {
+      if (trace())
+         traceMsg(comp(), "   loop carried dependence within one vector\n");
+      return false;
+      }
+
+   if (trace())
+      traceMsg(comp(), "   candidate: %d lanes of %s, %d loads, %d stores, %d reductions, %d alias checks\n",
+         candidate._vectorLength, candidate._elementType.toString(), (int32_t)candidate._loads.size(),
+         (int32_t)candidate._stores.size(), (int32_t)candidate._reductions.size(), (int32_t)candidate._aliasChecks.size());
+
+   return true;
+   }
+
+/**
+ * The loop must consist of one block B with a single predecessor P outside the
+ * loop and must end with
+ *
+ *    istore iv (iadd (iload iv) (iconst 1))
+ *    ificmplt --> B
+ *       iv + 1 (or a fresh load of iv)
+ *       invariant bound
+ *
+ * falling through to the loop exit.
+ */
+bool
+TR_LoopVectorizer::analyzeControlFlow(CandidateLoop &candidate)
+   {
+   TR_RegionStructure *loop = candidate._loop;
+   TR_RegionStructure::Cursor si(*loop);
+   TR_StructureSubGraphNode *subNode = si.getCurrent();
+   if (!subNode || si.getNext() || !subNode->getStructure()->asBlock())
+      return false;
+
+   TR::Block *body = loop->getEntryBlock();
+   if (body->isCold() ||
+       !body->getExceptionPredecessors().empty() ||
+       !body->getExceptionSuccessors().empty())
+      return false;
+
+   TR_PrimaryInductionVariable *piv = loop->getPrimaryInductionVariable();
+   if (!piv || piv->getIncrement() != 1 || piv->getBranchBlock() != body)
+      return false;
+
+   TR::SymbolReference *ivSymRef = piv->getSymRef();
+   TR::Symbol *ivSymbol = ivSymRef->getSymbol();
+   if (ivSymbol->getDataType() != TR::Int32 || !ivSymbol->isAutoOrParm())
+      return false;
+
+   TR::Block *preheader = NULL;
+   for (auto edge = body->getPredecessors().begin(); edge != body->getPredecessors().end(); ++edge)
+      {
+      TR::Block *pred = toBlock((*edge)->getFrom());
+      if (pred == body)
+         continue;
+      if (preheader)
+         return false;
+      preheader = pred;
+      }
+
+   TR::Block *prevBlock = body->getPrevBlock();
+   if (!preheader || !preheader->getEntry() || !prevBlock)
+      return false;
+
+   // The guard is placed in front of the loop, so the preheader must either
+   // fall into the loop or reach it with a goto that can be redirected
+   //
+   TR::Node *preheaderLast = preheader->getLastRealTreeTop()->getNode();
+   if (preheaderLast->getOpCodeValue() != TR::Goto &&
+       (preheader != prevBlock ||
+        preheaderLast->getOpCode().isJumpWithMultipleTargets() ||
+        (preheaderLast->getOpCode().isBranch() && preheaderLast->getBranchDestination() == body->getEntry())))
+      return false;
+
+   TR::Block *exit = body->getNextBlock();
+   if (!exit || body->getSuccessors().size() != 2)
+      return false;
+
+   for (auto edge = body->getSuccessors().begin(); edge != body->getSuccessors().end(); ++edge)
+      {
+      TR::Block *succ = toBlock((*edge)->getTo());
+      if (succ != body && succ != exit)
+         return false;
+      }
+
+   TR::TreeTop *branchTree = body->getLastRealTreeTop();
+   TR::Node *branch = branchTree->getNode();
+   if (branch->getOpCodeValue() != TR::ificmplt || branch->getBranchDestination() != body->getEntry())
+      return false;
+
+   TR::TreeTop *ivStoreTree = branchTree->getPrevRealTreeTop();
+   TR::Node *ivStore = ivStoreTree->getNode();
+   if (ivStore->getOpCodeValue() != TR::istore || ivStore->getSymbol() != ivSymbol)
+      return false;
+
+   TR::Node *increment = ivStore->getFirstChild();
+   if (increment->getOpCodeValue() != TR::iadd ||
+       !increment->getFirstChild()->getOpCode().isLoadVarDirect() ||
+       increment->getFirstChild()->getSymbol() != ivSymbol ||
+       increment->getSecondChild()->getOpCodeValue() != TR::iconst ||
+       increment->getSecondChild()->getInt() != 1)
+      return false;
+
+   // A load of the induction variable that was already evaluated earlier in
+   // the block would hold the old value
+   //
+   TR::Node *tested = branch->getFirstChild();
+   if (tested != increment &&
+       !(tested->getOpCodeValue() == TR::iload && tested->getSymbol() == ivSymbol && tested->getReferenceCount() == 1))
+      return false;
+
+   candidate._body = body;
+   candidate._preheader = preheader;
+   candidate._exit = exit;
+   candidate._ivStoreTree = ivStoreTree;
+   candidate._inductionVariable = ivSymRef;
+
+   for (TR::TreeTop *tt = body->getFirstRealTreeTop(); tt != branchTree; tt = tt->getNextTreeTop())
+      {
+      if (tt->getNode()->getOpCode().isStoreDirect())
+         candidate._storedSymbols.push_back(tt->getNode()->getSymbol());
+      }
+
+   TR::Node *bound = branch->getSecondChild();
+   if (!isLoopInvariant(candidate, bound))
+      return false;
+
+   candidate._bound = bound;
+   return true;
+   }
+
+bool
+TR_LoopVectorizer::analyzeBody(CandidateLoop &candidate)
+   {
+   TR::NodeChecklist visited(comp());
+
+   for (TR::TreeTop *tt = candidate._body->getFirstRealTreeTop(); tt != candidate._ivStoreTree; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      TR::ILOpCode &op = node->getOpCode();
+
+      if (op.isStoreIndirect())
+         {
+         MemoryAccess access;
+         if (op.isWrtBar() ||
+             !setElementType(candidate, node->getDataType()) ||
+             !analyzeAddress(candidate, node, access) ||
+             !isVectorizableExpression(candidate, node->getSecondChild(), visited))
+            return false;
+
+         candidate._stores.push_back(access);
+         }
+      else if (op.isStoreDirect())
+         {
+         if (!analyzeReduction(candidate, node, visited))
+            return false;
+         }
+      else if (node->getOpCodeValue() == TR::treetop)
+         {
+         // Anchored loads of temps have no effect on the vector loop
+         //
+         TR::Node *child = node->getFirstChild();
+         if (!child->getOpCode().isLoadVarDirect() && !child->getOpCode().isLoadConst() &&
+             !isVectorizableExpression(candidate, child, visited))
+            return false;
+         }
+      else
+         {
+         return false;
+         }
+      }
+
+   if (candidate._stores.empty() && candidate._reductions.empty())
+      return false;
+
+   TR::DataType type = candidate._elementType;
+   if (!supportsVectorOp(TR::vloadi, type) || !supportsVectorOp(TR::vstorei, type))
+      return false;
+
+   candidate._vectorLength = VECTOR_SIZE_IN_BYTES / TR::DataType::getSize(type);
+   return true;
+   }
+
+/**
+ * A reduction is a store of the form acc = acc + expr where acc is a temp
+ * that is not referenced anywhere else in the loop.
+ */
+bool
+TR_LoopVectorizer::analyzeReduction(CandidateLoop &candidate, TR::Node *store, TR::NodeChecklist &visited)
+   {
+   TR::Symbol *accumulator = store->getSymbol();
+   TR::DataType type = store->getDataType();
+   TR::Node *value = store->getFirstChild();
+
+   if (!accumulator->isAutoOrParm() ||
+       accumulator == candidate._inductionVariable->getSymbol() ||
+       !setElementType(candidate, type))
+      return false;
+
+   // Summing lanes separately reassociates the floating point additions
+   //
+   if (type.isFloatingPoint() && !comp()->getOption(TR_IgnoreIEEERestrictions))
+      return false;
+
+   if (!value->getOpCode().isAdd() || value->getReferenceCount() != 1 || !supportsVectorOp(TR::vadd, type))
+      return false;
+
+   TR::Node *accumulatorLoad = value->getFirstChild();
+   TR::Node *addend = value->getSecondChild();
+   if (!accumulatorLoad->getOpCode().isLoadVarDirect() || accumulatorLoad->getSymbol() != accumulator)
+      std::swap(accumulatorLoad, addend);
+
+   if (!accumulatorLoad->getOpCode().isLoadVarDirect() ||
+       accumulatorLoad->getSymbol() != accumulator ||
+       accumulatorLoad->getReferenceCount() != 1)
+      return false;
+
+   TR::NodeChecklist counted(comp());
+   int32_t references = 0;
+   for (TR::TreeTop *tt = candidate._body->getFirstRealTreeTop(); tt != candidate._body->getExit(); tt = tt->getNextTreeTop())
+      references += countReferences(tt->getNode(), accumulator, counted);
+
+   if (references != 2 || !isVectorizableExpression(candidate, addend, visited))
+      return false;
+
+   Reduction reduction;
+   reduction._store = store;
+   reduction._addend = addend;
+   reduction._partialSums = NULL;
+   candidate._reductions.push_back(reduction);
+   return true;
+   }
+
+bool
+TR_LoopVectorizer::isVectorizableExpression(CandidateLoop &candidate, TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return true;
+
+   TR::DataType type = candidate._elementType;
+   if (node->getDataType() != type)
+      return false;
+
+   TR::ILOpCode &op = node->getOpCode();
+   if (op.isLoadIndirect())
+      {
+      MemoryAccess access;
+      if (!analyzeAddress(candidate, node, access))
+         return false;
+      candidate._loads.push_back(access);
+      }
+   else if (isLoopInvariant(candidate, node))
+      {
+      if (!supportsVectorOp(TR::vsplats, type))
+         return false;
+      }
+   else if (op.isAdd() || op.isSub() || op.isMul() || op.isAnd() || op.isOr() || op.isXor() ||
+            (op.isDiv() && type.isFloatingPoint()))
+      {
+      if (node->getNumChildren() != 2 ||
+          !supportsVectorOp(TR::ILOpCode::convertScalarToVector(node->getOpCodeValue()), type) ||
+          !isVectorizableExpression(candidate, node->getFirstChild(), visited) ||
+          !isVectorizableExpression(candidate, node->getSecondChild(), visited))
+         return false;
+      }
+   else
+      {
+      return false;
+      }
+
+   visited.add(node);
+   return true;
+   }
+
+/**
+ * Accepts an address of the form aladd(base, index) where base is loop
+ * invariant and index is a linear function of the induction variable whose
+ * scale is the element size, so that consecutive iterations touch consecutive
+ * elements.
+ */
+bool
+TR_LoopVectorizer::analyzeAddress(CandidateLoop &candidate, TR::Node *memRef, MemoryAccess &access)
+   {
+   TR::SymbolReference *symRef = memRef->getSymbolReference();
+   TR::Symbol *sym = symRef->getSymbol();
+   if (symRef->isUnresolved() || sym->isVolatile())
+      return false;
+
+   if (!(sym->isArrayShadowSymbol() && symRef->getOffset() == 0) && !sym->isNamedShadowSymbol())
+      return false;
+
+   TR::Node *address = memRef->getFirstChild();
+   if (address->getOpCodeValue() != TR::aladd)
+      return false;
+
+   TR::Node *base = address->getFirstChild();
+   int64_t scale = 0;
+   int64_t offset = 0;
+   if (!isLoopInvariant(candidate, base) ||
+       !getLinearIndex(candidate, address->getSecondChild(), scale, offset) ||
+       scale != TR::DataType::getSize(candidate._elementType))
+      return false;
+
+   access._node = memRef;
+   access._base = base;
+   access._offset = offset + symRef->getOffset();
+   return true;
+   }
+
+bool
+TR_LoopVectorizer::getLinearIndex(CandidateLoop &candidate, TR::Node *index, int64_t &scale, int64_t &offset)
+   {
+   if (index->getDataType() != TR::Int32 && index->getDataType() != TR::Int64)
+      return false;
+
+   TR::ILOpCode &op = index->getOpCode();
+   if (op.isLoadVarDirect() && index->getSymbol() == candidate._inductionVariable->getSymbol())
+      {
+      scale = 1;
+      offset = 0;
+      return true;
+      }
+
+   if (index->getOpCodeValue() == TR::i2l)
+      return getLinearIndex(candidate, index->getFirstChild(), scale, offset);
+
+   if (index->getNumChildren() != 2)
+      return false;
+
+   TR::Node *variable = index->getFirstChild();
+   TR::Node *constant = index->getSecondChild();
+   if ((op.isAdd() || op.isMul()) && variable->getOpCode().isLoadConst())
+      std::swap(variable, constant);
+
+   if (!constant->getOpCode().isLoadConst() || !getLinearIndex(candidate, variable, scale, offset))
+      return false;
+
+   int64_t value = constant->get64bitIntegralValue();
+   if (op.isAdd())
+      {
+      offset += value;
+      }
+   else if (op.isSub())
+      {
+      offset -= value;
+      }
+   else if (op.isMul())
+      {
+      scale *= value;
+      offset *= value;
+      }
+   else if (op.isLeftShift() && value >= 0 && value < 32)
+      {
+      scale <<= value;
+      offset <<= value;
+      }
+   else
+      {
+      return false;
+      }
+
+   return true;
+   }
+
+bool
+TR_LoopVectorizer::isLoopInvariant(CandidateLoop &candidate, TR::Node *node)
+   {
+   TR::ILOpCode &op = node->getOpCode();
+   if (op.isLoadConst() || node->getOpCodeValue() == TR::loadaddr)
+      return true;
+
+   if (op.isLoadVarDirect() && node->getSymbol()->isAutoOrParm())
+      return !isStoredInLoop(candidate, node->getSymbol());
+
+   return false;
+   }
+
+bool
+TR_LoopVectorizer::isStoredInLoop(CandidateLoop &candidate, TR::Symbol *symbol)
+   {
+   for (auto stored = candidate._storedSymbols.begin(); stored != candidate._storedSymbols.end(); ++stored)
+      {
+      if (*stored == symbol)
+         return true;
+      }
+   return false;
+   }
+
+bool
+TR_LoopVectorizer::isSameBase(TR::Node *first, TR::Node *second)
+   {
+   if (first == second)
+      return true;
+
+   return first->getOpCodeValue() == second->getOpCodeValue() &&
+          first->getOpCode().hasSymbolReference() &&
+          first->getSymbol() == second->getSymbol();
+   }
+
+/**
+ * A store conflicts with another access when the two are less than a vector
+ * apart but not at the same address: the scalar loop would then read or
+ * overwrite a value produced by a different iteration of the same vector.
+ * Accesses off the same base are resolved here, the others are left to the
+ * runtime test emitted in the guard.
+ */
+bool
+TR_LoopVectorizer::analyzeDependences(CandidateLoop &candidate)
+   {
+   for (auto store = candidate._stores.begin(); store != candidate._stores.end(); ++store)
+      {
+      for (int32_t pass = 0; pass < 2; ++pass)
+         {
+         MemoryAccessVector &others = pass == 0 ? candidate._stores : candidate._loads;
+         for (auto other = others.begin(); other != others.end(); ++other)
+            {
+            if (pass == 0 && other <= store)
+               continue;
+
+            if (isSameBase(store->_base, other->_base))
+               {
+               int64_t distance = store->_offset - other->_offset;
+               if (distance != 0 && distance > -VECTOR_SIZE_IN_BYTES && distance < VECTOR_SIZE_IN_BYTES)
+                  return false;
+               }
+            else
+               {
+               candidate._aliasChecks.push_back(std::make_pair(&*store, &*other));
+               }
+            }
+         }
+      }
+
+   return candidate._aliasChecks.size() <= MAX_ALIAS_CHECKS;
+   }
+
+bool
+TR_LoopVectorizer::setElementType(CandidateLoop &candidate, TR::DataType type)
+   {
+   if (candidate._elementType == TR::NoType)
+      candidate._elementType = type;
+   return candidate._elementType == type;
+   }
+
+bool
+TR_LoopVectorizer::supportsVectorOp(TR::ILOpCodes op, TR::DataType type)
+   {
+   if (op == TR::BadILOp)
+      return false;
+
+   TR::ILOpCode opCode;
+   opCode.setOpCodeValue(op);
+   return cg()->getSupportsOpCodeForAutoSIMD(opCode, type);
+   }
+
+int32_t
+TR_LoopVectorizer::countReferences(TR::Node *node, TR::Symbol *symbol, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return 0;
+   visited.add(node);
+
+   int32_t count = (node->getOpCode().hasSymbolReference() && node->getSymbol() == symbol) ? 1 : 0;
+   for (int32_t i = 0; i < node->getNumChildren(); ++i)
+      count += countReferences(node->getChild(i), symbol, visited);
+   return count;
+   }
+
+/**
+ * Inserts the guard G, the vector loop V and the reduction block R between
+ * the preheader P and the scalar loop B:
+ *
+ *    P -> G -> V -> R -> B -> exit
+ *         |    ^|   |    ^
+ *         |    +-   +--> exit
+ *         +------------> B
+ */
+void
+TR_LoopVectorizer::transformLoop(CandidateLoop &candidate)
+   {
+   TR::CFG *cfg = comp()->getFlowGraph();
+   TR::SymbolReferenceTable *symRefTab = comp()->getSymRefTab();
+   TR::Block *body = candidate._body;
+   TR::Node *origin = body->getEntry()->getNode();
+   TR::SymbolReference *iv = candidate._inductionVariable;
+   TR::DataType type = candidate._elementType;
+   int32_t vectorLength = candidate._vectorLength;
+   int32_t elementSize = TR::DataType::getSize(type);
+   TR::SymbolReference *vectorShadow = symRefTab->findOrCreateArrayShadowSymbolRef(type.scalarToVector(), NULL);
+   TR::SymbolReference *elementShadow = symRefTab->findOrCreateArrayShadowSymbolRef(type, NULL);
+
+   TR::Block *guard = TR::Block::createEmptyBlock(origin, comp(), candidate._preheader->getFrequency());
+   TR::Block *vectorLoop = TR::Block::createEmptyBlock(origin, comp(), body->getFrequency());
+   TR::Block *reduction = TR::Block::createEmptyBlock(origin, comp(), candidate._preheader->getFrequency());
+
+   // Guard: clear the partial sums, then take the scalar loop if fewer than
+   // VL iterations are left or if any store may overlap another access
+   //
+   for (auto r = candidate._reductions.begin(); r != candidate._reductions.end(); ++r)
+      {
+      r->_partialSums = symRefTab->createLocalPrimArray(VECTOR_SIZE_IN_BYTES, comp()->getMethodSymbol(), 8);
+      r->_partialSums->setStackAllocatedArrayAccess();
+
+      TR::Node *zero = TR::Node::create(origin, TR::vsplats, 1, TR::Node::createConstZeroValue(origin, type));
+      TR::Node *partialSums = TR::Node::createWithSymRef(origin, TR::loadaddr, 0, r->_partialSums);
+      guard->append(TR::TreeTop::create(comp(), TR::Node::createWithSymRef(TR::vstorei, 2, partialSums, zero, 0, vectorShadow)));
+      }
+
+   TR::Node *lastLane = TR::Node::create(origin, TR::ladd, 2,
+      TR::Node::create(origin, TR::i2l, 1, TR::Node::createLoad(origin, iv)),
+      TR::Node::lconst(origin, vectorLength - 1));
+   TR::Node *scalarOnly = TR::Node::create(origin, TR::lcmpge, 2,
+      lastLane,
+      TR::Node::create(origin, TR::i2l, 1, candidate._bound->duplicateTree()));
+
+   TR::Node *conflicts = createRuntimeChecks(candidate, origin);
+   if (conflicts)
+      scalarOnly = TR::Node::create(origin, TR::ior, 2, scalarOnly, conflicts);
+
+   guard->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::ificmpne, scalarOnly, TR::Node::iconst(origin, 0), body->getEntry())));
+
+   // Vector loop: one vector tree for every tree of the scalar body
+   //
+   NodeMap vectorNodes(std::less<TR::Node *>(), trMemory()->currentStackRegion());
+   for (TR::TreeTop *tt = body->getFirstRealTreeTop(); tt != candidate._ivStoreTree; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      TR::Node *vectorNode = NULL;
+
+      if (node->getOpCode().isStoreIndirect())
+         {
+         TR::Node *value = vectorize(candidate, node->getSecondChild(), vectorNodes);
+         vectorNode = createVectorMemRef(node, value);
+         }
+      else if (node->getOpCode().isStoreDirect())
+         {
+         Reduction *r = NULL;
+         for (auto it = candidate._reductions.begin(); it != candidate._reductions.end() && !r; ++it)
+            {
+            if (it->_store == node)
+               r = &*it;
+            }
+         TR_ASSERT(r, "store n%dn in a vectorized loop must be a reduction", node->getGlobalIndex());
+
+         TR::Node *sums = TR::Node::createWithSymRef(origin, TR::vloadi, 1,
+            TR::Node::createWithSymRef(origin, TR::loadaddr, 0, r->_partialSums), vectorShadow);
+         TR::Node *sum = TR::Node::create(origin, TR::vadd, 2, sums, vectorize(candidate, r->_addend, vectorNodes));
+         TR::Node *partialSums = TR::Node::createWithSymRef(origin, TR::loadaddr, 0, r->_partialSums);
+         vectorNode = TR::Node::createWithSymRef(TR::vstorei, 2, partialSums, sum, 0, vectorShadow);
+         }
+      else
+         {
+         TR::Node *child = node->getFirstChild();
+         if (child->getOpCode().isLoadVarDirect() || child->getOpCode().isLoadConst())
+            continue;
+         vectorNode = TR::Node::create(origin, TR::treetop, 1, vectorize(candidate, child, vectorNodes));
+         }
+
+      vectorLoop->append(TR::TreeTop::create(comp(), vectorNode));
+      }
+
+   TR::Node *nextIV = TR::Node::create(origin, TR::iadd, 2,
+      TR::Node::createLoad(origin, iv),
+      TR::Node::iconst(origin, vectorLength));
+   vectorLoop->append(TR::TreeTop::create(comp(), TR::Node::createStore(iv, nextIV)));
+
+   lastLane = TR::Node::create(origin, TR::ladd, 2,
+      TR::Node::create(origin, TR::i2l, 1, TR::Node::createLoad(origin, iv)),
+      TR::Node::lconst(origin, vectorLength - 1));
+   vectorLoop->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::iflcmplt, lastLane,
+         TR::Node::create(origin, TR::i2l, 1, candidate._bound->duplicateTree()),
+         vectorLoop->getEntry())));
+
+   // Reduction: fold the lanes into the accumulators and leave the loop if no
+   // iteration is left for the scalar loop
+   //
+   for (auto r = candidate._reductions.begin(); r != candidate._reductions.end(); ++r)
+      {
+      TR::SymbolReference *accumulator = r->_store->getSymbolReference();
+      TR::Node *sum = TR::Node::createLoad(origin, accumulator);
+      for (int32_t lane = 0; lane < vectorLength; ++lane)
+         {
+         TR::Node *laneAddress = TR::Node::create(origin, TR::aladd, 2,
+            TR::Node::createWithSymRef(origin, TR::loadaddr, 0, r->_partialSums),
+            TR::Node::lconst(origin, lane * elementSize));
+         TR::Node *laneValue = TR::Node::createWithSymRef(origin, TR::ILOpCode::indirectLoadOpCode(type), 1, laneAddress, elementShadow);
+         sum = TR::Node::create(origin, TR::ILOpCode::addOpCode(type, true), 2, sum, laneValue);
+         }
+      reduction->append(TR::TreeTop::create(comp(), TR::Node::createStore(accumulator, sum)));
+      }
+
+   reduction->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::ificmpge, TR::Node::createLoad(origin, iv), candidate._bound->duplicateTree(),
+         candidate._exit->getEntry())));
+
+   // Insert G, V and R in front of the scalar loop
+   //
+   body->getPrevBlock()->getExit()->join(guard->getEntry());
+   guard->getExit()->join(vectorLoop->getEntry());
+   vectorLoop->getExit()->join(reduction->getEntry());
+   reduction->getExit()->join(body->getEntry());
+
+   cfg->addNode(guard);
+   cfg->addNode(vectorLoop);
+   cfg->addNode(reduction);
+
+   TR::Node *preheaderLast = candidate._preheader->getLastRealTreeTop()->getNode();
+   if (preheaderLast->getOpCodeValue() == TR::Goto)
+      preheaderLast->setBranchDestination(guard->getEntry());
+
+   cfg->addEdge(candidate._preheader, guard);
+   cfg->addEdge(guard, vectorLoop);
+   cfg->addEdge(guard, body);
+   cfg->addEdge(vectorLoop, vectorLoop);
+   cfg->addEdge(vectorLoop, reduction);
+   cfg->addEdge(reduction, candidate._exit);
+   cfg->addEdge(reduction, body);
+   cfg->removeEdge(candidate._preheader, body);
+
+   if (trace())
+      traceMsg(comp(), "Vectorized loop %d: guard block_%d, vector loop block_%d, reduction block_%d\n",
+         candidate._loop->getNumber(), guard->getNumber(), vectorLoop->getNumber(), reduction->getNumber());
+   }
+
+/**
+ * Returns a node that is non-zero when the store and the access of any alias
+ * check pair start less than a vector apart, or NULL when there is no pair to
+ * test. Both addresses advance by the same stride, so the distance between
+ * them is that of their starting addresses.
+ */
+TR::Node *
+TR_LoopVectorizer::createRuntimeChecks(CandidateLoop &candidate, TR::Node *origin)
+   {
+   TR::Node *result = NULL;
+   for (auto check = candidate._aliasChecks.begin(); check != candidate._aliasChecks.end(); ++check)
+      {
+      TR::Node *start[2];
+      MemoryAccess *accesses[2] = { check->first, check->second };
+      for (int32_t i = 0; i < 2; ++i)
+         {
+         start[i] = TR::Node::create(origin, TR::ladd, 2,
+            TR::Node::create(origin, TR::a2l, 1, accesses[i]->_base->duplicateTree()),
+            TR::Node::lconst(origin, accesses[i]->_offset));
+         }
+
+      // 0 < |distance| < VECTOR_SIZE_IN_BYTES
+      //
+      TR::Node *distance = TR::Node::create(origin, TR::lsub, 2, start[0], start[1]);
+      TR::Node *near = TR::Node::create(origin, TR::lucmplt, 2,
+         TR::Node::create(origin, TR::ladd, 2, distance, TR::Node::lconst(origin, VECTOR_SIZE_IN_BYTES - 1)),
+         TR::Node::lconst(origin, 2 * VECTOR_SIZE_IN_BYTES - 1));
+      TR::Node *overlaps = TR::Node::create(origin, TR::iand, 2,
+         near,
+         TR::Node::create(origin, TR::lcmpne, 2, distance, TR::Node::lconst(origin, 0)));
+
+      result = result ? TR::Node::create(origin, TR::ior, 2, result, overlaps) : overlaps;
+      }
+   return result;
+   }
+
+TR::Node *
+TR_LoopVectorizer::vectorize(CandidateLoop &candidate, TR::Node *node, NodeMap &vectorNodes)
+   {
+   auto existing = vectorNodes.find(node);
+   if (existing != vectorNodes.end())
+      return existing->second;
+
+   TR::Node *vectorNode = NULL;
+   if (node->getOpCode().isLoadIndirect())
+      {
+      vectorNode = createVectorMemRef(node, NULL);
+      }
+   else if (isLoopInvariant(candidate, node))
+      {
+      vectorNode = TR::Node::create(node, TR::vsplats, 1, node->duplicateTree());
+      }
+   else
+      {
+      TR::Node *first = vectorize(candidate, node->getFirstChild(), vectorNodes);
+      TR::Node *second = vectorize(candidate, node->getSecondChild(), vectorNodes);
+      vectorNode = TR::Node::create(node, TR::ILOpCode::convertScalarToVector(node->getOpCodeValue()), 2, first, second);
+      }
+
+   vectorNodes.insert(std::make_pair(node, vectorNode));
+   return vectorNode;
+   }
+
+/**
+ * Creates the vector load, or the vector store of value, covering the VL
+ * elements starting at the address of the scalar memory reference.
+ */
+TR::Node *
+TR_LoopVectorizer::createVectorMemRef(TR::Node *scalar, TR::Node *value)
+   {
+   TR::Node *address = scalar->getFirstChild()->duplicateTree();
+   TR::SymbolReference *symRef = TR::TransformUtil::createVectorShadowSymbolRef(comp(), scalar->getSymbolReference());
+   if (value)
+      return TR::Node::createWithSymRef(TR::vstorei, 2, address, value, 0, symRef);
+   return TR::Node::createWithSymRef(scalar, TR::vloadi, 1, address, symRef);
+   }
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef LOOPVECTORIZER_INCL
+#define LOOPVECTORIZER_INCL
+
+#include <stdint.h>
+#include <map>
+#include "env/TRMemory.hpp"
+#include "il/DataTypes.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_RegionStructure;
+class TR_Structure;
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class NodeChecklist; }
+namespace TR { class Symbol; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/*
+ * Class TR_LoopVectorizer
+ * =======================
+ *
+ * Loop vectorization rewrites counted, single block inner loops that
+ * perform element-wise arithmetic on contiguous memory into loops over
+ * the 128-bit vector IL opcodes (vloadi, vstorei, vadd, ...). Consider:
+ *
+ * do
+ *    {
+ *    c[i] = a[i] * b[i] + k;
+ *    sum = sum + a[i];
+ *    i = i + 1;
+ *    }
+ * while (i < n);
+ *
+ * The loop is left in place as the scalar remainder and three blocks are
+ * inserted in front of it:
+ *
+ *  - a guard that initializes the vector partial sums and branches to the
+ *    scalar loop when fewer than VL iterations remain or when a store may
+ *    overlap another access within one vector length (runtime alias test),
+ *  - the vector loop, executing VL iterations per trip,
+ *  - a reduction block folding the partial sums back into the scalar
+ *    accumulators and exiting the loop once every iteration has been done,
+ *    falling into the scalar loop for the remainder otherwise.
+ *
+ * The primary induction variable found by induction variable analysis must
+ * be an Int32 temp incremented by one just before the backedge, every
+ * memory access must be an array or named shadow of one element type whose
+ * address is a loop invariant base plus the induction variable scaled by
+ * the element size, and every operation must be supported by the code
+ * generator for that element type (getSupportsOpCodeForAutoSIMD).
+ * Floating point reductions reassociate the sum, so they are only done
+ * under ignoreIEEERestrictions.
+ */
+class TR_LoopVectorizer : public TR::Optimization
+   {
+   public:
+   TR_LoopVectorizer(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_LoopVectorizer(manager);
+      }
+
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   struct MemoryAccess
+      {
+      TR::Node *_node;   // indirect load or store
+      TR::Node *_base;   // loop invariant base address
+      int64_t   _offset; // byte offset from _base when the induction variable is zero
+      };
+
+   struct Reduction
+      {
+      TR::Node            *_store;        // acc = acc + addend
+      TR::Node            *_addend;
+      TR::SymbolReference *_partialSums;  // VL lane accumulators, created at transformation time
+      };
+
+   typedef TR::vector<MemoryAccess, TR::Region&> MemoryAccessVector;
+   typedef TR::vector<Reduction, TR::Region&> ReductionVector;
+   typedef TR::vector<std::pair<MemoryAccess *, MemoryAccess *>, TR::Region&> AliasCheckVector;
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, TR::Node *>, TR::Region&> NodeMapAlloc;
+   typedef std::map<TR::Node *, TR::Node *, std::less<TR::Node *>, NodeMapAlloc> NodeMap;
+
+   struct CandidateLoop
+      {
+      CandidateLoop(TR::Region &region)
+         : _loop(NULL), _body(NULL), _preheader(NULL), _exit(NULL), _ivStoreTree(NULL),
+           _inductionVariable(NULL), _bound(NULL), _elementType(TR::NoType), _vectorLength(0),
+           _loads(region), _stores(region), _reductions(region), _aliasChecks(region),
+           _storedSymbols(region)
+         {}
+
+      TR_RegionStructure   *_loop;
+      TR::Block            *_body;
+      TR::Block            *_preheader;
+      TR::Block            *_exit;
+      TR::TreeTop          *_ivStoreTree;
+      TR::SymbolReference  *_inductionVariable;
+      TR::Node             *_bound;
+      TR::DataType          _elementType;
+      int32_t               _vectorLength;
+      MemoryAccessVector    _loads;
+      MemoryAccessVector    _stores;
+      ReductionVector       _reductions;
+      AliasCheckVector      _aliasChecks;
+      TR::vector<TR::Symbol *, TR::Region&> _storedSymbols;
+      };
+
+   void collectInnermostLoops(TR_Structure *str, TR::vector<TR_RegionStructure *, TR::Region&> &loops);
+
+   bool analyzeLoop(CandidateLoop &candidate);
+   bool analyzeControlFlow(CandidateLoop &candidate);
+   bool analyzeBody(CandidateLoop &candidate);
+   bool analyzeReduction(CandidateLoop &candidate, TR::Node *store, TR::NodeChecklist &visited);
+   bool isVectorizableExpression(CandidateLoop &candidate, TR::Node *node, TR::NodeChecklist &visited);
+   bool analyzeAddress(CandidateLoop &candidate, TR::Node *memRef, MemoryAccess &access);
+   bool getLinearIndex(CandidateLoop &candidate, TR::Node *index, int64_t &scale, int64_t &offset);
+   bool isLoopInvariant(CandidateLoop &candidate, TR::Node *node);
+   bool isStoredInLoop(CandidateLoop &candidate, TR::Symbol *symbol);
+   bool isSameBase(TR::Node *first, TR::Node *second);
+   bool analyzeDependences(CandidateLoop &candidate);
+   bool setElementType(CandidateLoop &candidate, TR::DataType type);
+   bool supportsVectorOp(TR::ILOpCodes op, TR::DataType type);
+   int32_t countReferences(TR::Node *node, TR::Symbol *symbol, TR::NodeChecklist &visited);
+
+   void transformLoop(CandidateLoop &candidate);
+   TR::Node *createRuntimeChecks(CandidateLoop &candidate, TR::Node *origin);
+   TR::Node *vectorize(CandidateLoop &candidate, TR::Node *node, NodeMap &vectorNodes);
+   TR::Node *createVectorMemRef(TR::Node *scalar, TR::Node *value);
+   };
+
+#endif
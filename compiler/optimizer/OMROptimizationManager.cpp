@@ -129,6 +129,12 @@ OMR::OptimizationManager::OptimizationManager(TR::Optimizer *o, OptimizationFact
       case OMR::generalLoopUnroller:
          _flags.set(requiresStructure | checkStructure | dumpStructure);
          break;
+      case OMR::loopVectorization:
+         _flags.set(requiresStructure | checkStructure | dumpStructure);
+         break;
+      case OMR::valueNumberCSE:
+         _flags.set(requiresStructure | requiresLocalsUseDefInfo | requiresLocalsValueNumbering | canAddSymbolReference);
+         break;
       case OMR::redundantAsyncCheckRemoval:
          _flags.set(requiresStructure);
          break;
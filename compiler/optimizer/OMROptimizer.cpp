@@ -73,6 +73,7 @@
 #include "optimizer/StructuralAnalysis.hpp"
 #include "optimizer/UseDefInfo.hpp"
 #include "optimizer/ValueNumberInfo.hpp"
+#include "optimizer/ValueNumberCSE.hpp"
 #include "optimizer/AsyncCheckInsertion.hpp"
 #include "optimizer/DeadStoreElimination.hpp"
 #include "optimizer/DeadTreesElimination.hpp"
@@ -84,15 +85,18 @@
 #include "optimizer/GeneralLoopUnroller.hpp"
 #include "optimizer/LocalCSE.hpp"
 #include "optimizer/LocalDeadStoreElimination.hpp"
+#include "optimizer/LocalEscapeAnalysis.hpp"
 #include "optimizer/LocalLiveRangeReducer.hpp"
 #include "optimizer/LocalOpts.hpp"
 #include "optimizer/LocalReordering.hpp"
 #include "optimizer/LoopCanonicalizer.hpp"
 #include "optimizer/LoopReducer.hpp"
 #include "optimizer/LoopReplicator.hpp"
+#include "optimizer/LoopVectorizer.hpp"
 #include "optimizer/LoopVersioner.hpp"
 #include "optimizer/OrderBlocks.hpp"
 #include "optimizer/RedundantAsyncCheckRemoval.hpp"
+#include "optimizer/SLPVectorizer.hpp"
 #include "optimizer/Simplifier.hpp"
 #include "optimizer/VirtualGuardCoalescer.hpp"
 #include "optimizer/VirtualGuardHeadMerger.hpp"
@@ -575,6 +579,7 @@ static const OptimizationStrategy omrWarmStrategyOpts[] =
    //{ localValuePropagation               },
    { treeSimplification                   },
    { localCSE                             },
+   { valueNumberCSE,           IfMoreThanOneBlock }, // common expressions across blocks without the cost of PRE
    { localDeadStoreElimination            },
    { globalDeadStoreGroup                 },
    { endOpts },
@@ -590,6 +595,7 @@ static const OptimizationStrategy omrHotStrategyOpts[] =
    { OMR::loopReplicator,                                    }, // tail-duplication in loops
    { OMR::blockSplitter,                                     }, // treeSimplification + blockSplitter + VP => opportunity for EA
    { OMR::arrayPrivatizationGroup,                           }, // must preceed escape analysis
+   { OMR::escapeAnalysis,                 OMR::IfEAOpportunities }, // scalarize or stack-allocate non-escaping news
    { OMR::veryExpensiveGlobalValuePropagationGroup           },
    { OMR::globalDeadStoreGroup,                              },
    { OMR::globalCopyPropagation,                             },
@@ -600,10 +606,13 @@ static const OptimizationStrategy omrHotStrategyOpts[] =
    { OMR::inductionVariableAnalysis,                         },
    { OMR::loopSpecializerGroup,                              },
    { OMR::inductionVariableAnalysis,                         },
+   { OMR::loopVectorization,                                 }, // vectorize counted loops, before unrolling the remainder
+   { OMR::inductionVariableAnalysis,                         },
    { OMR::generalLoopUnroller,                               }, // unroll Loops
    { OMR::blockSplitter,            OMR::MarkLastRun         },
    { OMR::blockManipulationGroup                             },
    { OMR::lateLocalGroup                                     },
+   { OMR::slpVectorization,                                  }, // pack isomorphic stores left by unrolling
    { OMR::redundantAsyncCheckRemoval                         }, // optimize async check placement
 #ifdef J9_PROJECT_SPECIFIC
    { OMR::recompilationModifier,                             }, // do before GRA to avoid commoning of longs afterwards
@@ -772,6 +781,14 @@ OMR::Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *metho
       new (comp->allocator()) TR::OptimizationManager(self(), TR_ExpressionsSimplification::create, OMR::expressionsSimplification);
    _opts[OMR::generalLoopUnroller] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_GeneralLoopUnroller::create, OMR::generalLoopUnroller);
+   _opts[OMR::loopVectorization] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopVectorizer::create, OMR::loopVectorization);
+   _opts[OMR::slpVectorization] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_SLPVectorizer::create, OMR::slpVectorization);
+   _opts[OMR::valueNumberCSE] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_ValueNumberCSE::create, OMR::valueNumberCSE);
+   _opts[OMR::escapeAnalysis] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_LocalEscapeAnalysis::create, OMR::escapeAnalysis);
    _opts[OMR::globalCopyPropagation] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_CopyPropagation::create, OMR::globalCopyPropagation);
    _opts[OMR::globalDeadStoreElimination] =
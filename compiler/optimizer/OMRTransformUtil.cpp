@@ -22,6 +22,9 @@
 #include "optimizer/TransformUtil.hpp"
 #include "compile/Compilation.hpp"
 #include "codegen/CodeGenerator.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
 #include "il/Node.hpp"
 #include "il/Node_inlines.hpp"
 #include "il/SymbolReference.hpp"
@@ -370,6 +373,23 @@ OMR::TransformUtil::removeTree(TR::Compilation *comp, TR::TreeTop * tt)
    comp->getJittedMethodSymbol()->removeTree(tt);
    }
 
+TR::SymbolReference *
+OMR::TransformUtil::createVectorShadowSymbolRef(TR::Compilation *comp, TR::SymbolReference *scalarSymRef)
+   {
+   TR::Symbol *scalarSym = scalarSymRef->getSymbol();
+   TR::DataType vectorType = scalarSym->getDataType().scalarToVector();
+   if (scalarSym->isArrayShadowSymbol())
+      return comp->getSymRefTab()->findOrCreateArrayShadowSymbolRef(vectorType, NULL);
+
+   TR_ASSERT(scalarSym->isNamedShadowSymbol(), "expected an array or named shadow");
+   TR::Symbol *sym = TR::Symbol::createNamedShadow(comp->trHeapMemory(), vectorType, TR::DataType::getSize(vectorType),
+                                                   const_cast<char *>(scalarSym->getName()));
+   TR::SymbolReference *symRef = new (comp->trHeapMemory()) TR::SymbolReference(comp->getSymRefTab(), sym,
+                                                                                comp->getMethodSymbol()->getResolvedMethodIndex(), -1);
+   symRef->setOffset(scalarSymRef->getOffset());
+   return symRef;
+   }
+
 void
 OMR::TransformUtil::transformCallNodeToPassThrough(TR::Optimization* opt, TR::Node* node, TR::TreeTop * anchorTree, TR::Node* child)
    {
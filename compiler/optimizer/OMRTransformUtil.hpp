@@ -98,6 +98,21 @@ class OMR_EXTENSIBLE TransformUtil
 
    static void removeTree(TR::Compilation *, TR::TreeTop * tt);
 
+   /**
+    * \brief
+    *    Returns a symbol reference through which a vector of the elements accessed
+    *    by a scalar indirect load or store can be loaded or stored.
+    *
+    * \parm scalarSymRef
+    *    The array or named shadow of the scalar memory reference.
+    *
+    * \note
+    *    Array shadows map to the vector array shadow of the element type, which
+    *    aliases the scalar array shadow. Named shadows get a new named shadow with
+    *    the same name and offset.
+    */
+   static TR::SymbolReference *createVectorShadowSymbolRef(TR::Compilation *comp, TR::SymbolReference *scalarSymRef);
+
    /**
     * \brief
     *    This function serves as a tool to transform a call node to a TR::PassThrough node with one child in place
@@ -38,6 +38,7 @@
 #include "il/TreeTop_inlines.hpp"
 #include "infra/BitVector.hpp"
 #include "infra/Cfg.hpp"
+#include "infra/ChunkedBitVector.hpp"
 #include "optimizer/DataFlowAnalysis.hpp"
 #include "optimizer/UseDefInfo.hpp"
 
@@ -45,43 +46,28 @@ class TR_BlockStructure;
 class TR_Structure;
 namespace TR { class Optimizer; }
 
-TR_DataFlowAnalysis::Kind TR_ReachingDefinitions::getKind()
-   {
-   return ReachingDefinitions;
-   }
-
-bool TR_ReachingDefinitions::supportsGenAndKillSets()
-   {
-   return true;
-   }
-
-
-TR_ReachingDefinitions::TR_ReachingDefinitions(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, TR_UseDefInfo *useDefInfo, TR_UseDefInfo::AuxiliaryData &aux, bool trace)
-   : TR_UnionBitVectorAnalysis(comp, cfg, optimizer, trace),
-     _useDefInfo(useDefInfo),
-     _aux(aux)
+// The dense and chunked analyses share their rules; only the container
+// type of the sets differs.
+//
+template <class Analysis>
+static int32_t performReachingDefinitions(Analysis *rd, TR::CFG *cfg)
    {
-   _traceRD = comp->getOption(TR_TraceUseDefs);
-   }
-
-int32_t TR_ReachingDefinitions::perform()
-   {
-   LexicalTimer tlex("reachingDefs_perform", comp()->phaseTimer());
-   if (traceRD())
-      traceMsg(comp(), "Starting ReachingDefinitions\n");
+   LexicalTimer tlex("reachingDefs_perform", rd->comp()->phaseTimer());
+   if (rd->traceRD())
+      traceMsg(rd->comp(), "Starting ReachingDefinitions\n");
 
    // Allocate the block info, allowing the bit vectors to be allocated on the fly
    //
-   initializeBlockInfo(false);
+   rd->initializeBlockInfo(false);
 
    {
-   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+   TR::StackMemoryRegion stackMemoryRegion(*rd->trMemory());
 
-   TR_Structure *rootStructure = _cfg->getStructure();
-   performAnalysis(rootStructure, false);
+   TR_Structure *rootStructure = cfg->getStructure();
+   rd->performAnalysis(rootStructure, false);
 
-   if (traceRD())
-      traceMsg(comp(), "\nEnding ReachingDefinitions\n");
+   if (rd->traceRD())
+      traceMsg(rd->comp(), "\nEnding ReachingDefinitions\n");
 
    } // scope of the stack memory region
 
@@ -89,104 +75,37 @@ int32_t TR_ReachingDefinitions::perform()
    }
 
 
-int32_t TR_ReachingDefinitions::getNumberOfBits()
-   {
-   return _useDefInfo->getNumExpandedDefNodes();
-   }
-
-
-void TR_ReachingDefinitions::analyzeBlockZeroStructure(TR_BlockStructure *blockStructure)
+template <class Analysis>
+static void analyzeBlockZeroStructure(Analysis *rd, TR_UseDefInfo *useDefInfo)
    {
    // Initialize the analysis info by making the initial parameter and field
    // definitions reach the method entry
    //
-   if (_useDefInfo->getNumExpandedDefsOnEntry())
-      _regularInfo->setAll(_useDefInfo->getNumExpandedDefsOnEntry());
-   if (!_blockAnalysisInfo[0])
-      allocateBlockInfoContainer(&_blockAnalysisInfo[0], _regularInfo);
-   copyFromInto(_regularInfo, _blockAnalysisInfo[0]);
+   if (useDefInfo->getNumExpandedDefsOnEntry())
+      rd->_regularInfo->setAll(useDefInfo->getNumExpandedDefsOnEntry());
+   if (!rd->_blockAnalysisInfo[0])
+      rd->allocateBlockInfoContainer(&rd->_blockAnalysisInfo[0], rd->_regularInfo);
+   TR_DataFlowAnalysis::copyFromInto(rd->_regularInfo, rd->_blockAnalysisInfo[0]);
    }
 
 
-
-
-void TR_ReachingDefinitions::initializeGenAndKillSetInfo()
-   {
-   // For each block in the CFG build the gen and kill set for this analysis.
-   // Go in treetop order, which guarantees that we see the correct (i.e. first)
-   // evaluation point for each node.
-   //
-   TR::Block *block;
-   int32_t   blockNum = 0;
-   bool      seenException = false;
-   TR_BitVector defsKilled(getNumberOfBits(), trMemory()->currentStackRegion());
-
-   comp()->incVisitCount();
-   for (TR::TreeTop *treeTop = comp()->getStartTree(); treeTop; treeTop = treeTop->getNextTreeTop())
-      {
-      TR::Node *node = treeTop->getNode();
-
-      if (node->getOpCodeValue() == TR::BBStart)
-         {
-         block = node->getBlock();
-         blockNum = block->getNumber();
-         seenException  = false;
-         if (traceRD())
-            traceMsg(comp(), "\nNow generating gen and kill information for block_%d\n", blockNum);
-         continue;
-         }
-
-#if DEBUG
-      if (node->getOpCodeValue() == TR::BBEnd && traceRD())
-         {
-         traceMsg(comp(), "  Block %d:\n", blockNum);
-         traceMsg(comp(), "     Gen set ");
-         if (_regularGenSetInfo[blockNum])
-            _regularGenSetInfo[blockNum]->print(comp());
-         else
-            traceMsg(comp(), "{}");
-         traceMsg(comp(), "\n     Kill set ");
-         if (_regularKillSetInfo[blockNum])
-            _regularKillSetInfo[blockNum]->print(comp());
-         else
-            traceMsg(comp(), "{}");
-         traceMsg(comp(), "\n     Exception Gen set ");
-         if (_exceptionGenSetInfo[blockNum])
-            _exceptionGenSetInfo[blockNum]->print(comp());
-         else
-            traceMsg(comp(), "{}");
-         traceMsg(comp(), "\n     Exception Kill set ");
-         if (_exceptionKillSetInfo[blockNum])
-            _exceptionKillSetInfo[blockNum]->print(comp());
-         else
-            traceMsg(comp(), "{}");
-         continue;
-         }
-#endif
-
-      initializeGenAndKillSetInfoForNode(node, defsKilled, seenException, blockNum, NULL);
-
-      if (!seenException && treeHasChecks(treeTop))
-         seenException = true;
-      }
-   }
-
-
-void TR_ReachingDefinitions::initializeGenAndKillSetInfoForNode(TR::Node *node, TR_BitVector &defsKilled, bool seenException, int32_t blockNum, TR::Node *parent)
+template <class Analysis>
+static void initializeGenAndKillSetInfoForNode(Analysis *rd, TR_UseDefInfo *useDefInfo, TR_UseDefInfo::AuxiliaryData &aux,
+                                              TR::Node *node, TR_BitVector &defsKilled, bool seenException, int32_t blockNum, TR::Node *parent)
    {
    // Update gen and kill info for nodes in this subtree
    //
    int32_t i;
 
-   if (node->getVisitCount() == comp()->getVisitCount())
+   if (node->getVisitCount() == rd->comp()->getVisitCount())
       return;
-   node->setVisitCount(comp()->getVisitCount());
+   node->setVisitCount(rd->comp()->getVisitCount());
 
    // Process the children first
    //
    for (i = node->getNumChildren()-1; i >= 0; --i)
       {
-      initializeGenAndKillSetInfoForNode(node->getChild(i), defsKilled, seenException, blockNum, node);
+      initializeGenAndKillSetInfoForNode(rd, useDefInfo, aux, node->getChild(i), defsKilled, seenException, blockNum, node);
       }
 
    bool irrelevantStore = false;
@@ -213,13 +132,13 @@ void TR_ReachingDefinitions::initializeGenAndKillSetInfoForNode(TR::Node *node,
    uint16_t symIndex;
    uint32_t num_aliases;
 
-   if (_useDefInfo->_useDefForRegs &&
+   if (useDefInfo->_useDefForRegs &&
         (opCode.isLoadReg() ||
        opCode.isStoreReg()))
       {
       sym = NULL;
       symRef = NULL;
-      symIndex = _useDefInfo->getNumSymbols() + node->getGlobalRegisterNumber();
+      symIndex = useDefInfo->getNumSymbols() + node->getGlobalRegisterNumber();
       num_aliases = 1;
       }
    else
@@ -227,7 +146,7 @@ void TR_ReachingDefinitions::initializeGenAndKillSetInfoForNode(TR::Node *node,
       symRef = node->getSymbolReference();
       sym = symRef->getSymbol();
       symIndex = symRef->getSymbol()->getLocalIndex();
-      num_aliases = _useDefInfo->getNumAliases(symRef, _aux);
+      num_aliases = useDefInfo->getNumAliases(symRef, aux);
       }
 
 
@@ -243,7 +162,7 @@ void TR_ReachingDefinitions::initializeGenAndKillSetInfoForNode(TR::Node *node,
       if (node->getOpCode().isCall())
          foundDefsToKill = false;
       }
-   else if (irrelevantStore || _useDefInfo->isExpandedDefIndex(nodeIndex))
+   else if (irrelevantStore || useDefInfo->isExpandedDefIndex(nodeIndex))
       {
       // DefOnly node defines all symbols it is aliased with
       // UseDef node(load) defines only the symbol itself
@@ -252,35 +171,35 @@ void TR_ReachingDefinitions::initializeGenAndKillSetInfoForNode(TR::Node *node,
       if (!irrelevantStore)
          {
          numDefNodes = num_aliases;
-         numDefNodes = _useDefInfo->isExpandedUseDefIndex(nodeIndex) ? 1 : numDefNodes;
+         numDefNodes = useDefInfo->isExpandedUseDefIndex(nodeIndex) ? 1 : numDefNodes;
 
-         if (!_useDefInfo->getDefsForSymbolIsZero(symIndex, _aux) &&
+         if (!useDefInfo->getDefsForSymbolIsZero(symIndex, aux) &&
              (!sym ||
              (!sym->isShadow() &&
              !sym->isMethod())))
             {
             foundDefsToKill = true;
                // defsKilled ORed with defsForSymbol(symIndex);
-           _useDefInfo->getDefsForSymbol(defsKilled, symIndex, _aux);
+           useDefInfo->getDefsForSymbol(defsKilled, symIndex, aux);
             }
          if (node->getOpCode().isStoreIndirect())
             {
-            int32_t memSymIndex = _useDefInfo->getMemorySymbolIndex(node);
+            int32_t memSymIndex = useDefInfo->getMemorySymbolIndex(node);
             if (memSymIndex != -1 &&
-                !_useDefInfo->getDefsForSymbolIsZero(memSymIndex, _aux))
+                !useDefInfo->getDefsForSymbolIsZero(memSymIndex, aux))
                {
                foundDefsToKill = true;
                // defsKilled ORed with defsForSymbol(symIndex);
-               _useDefInfo->getDefsForSymbol(defsKilled, memSymIndex, _aux);
+               useDefInfo->getDefsForSymbol(defsKilled, memSymIndex, aux);
                }
             }
          }
-      else if (!_useDefInfo->getDefsForSymbolIsZero(symIndex, _aux))
+      else if (!useDefInfo->getDefsForSymbolIsZero(symIndex, aux))
          {
          numDefNodes = 1;
          foundDefsToKill = true;
          // defsKilled ORed with defsForSymbol(symIndex);
-         _useDefInfo->getDefsForSymbol(defsKilled, symIndex, _aux);
+         useDefInfo->getDefsForSymbol(defsKilled, symIndex, aux);
          }
       }
    else
@@ -290,37 +209,186 @@ void TR_ReachingDefinitions::initializeGenAndKillSetInfoForNode(TR::Node *node,
 
    if (foundDefsToKill)
       {
-      if (_regularKillSetInfo[blockNum] == NULL)
-         allocateContainer(&_regularKillSetInfo[blockNum]);
-      *_regularKillSetInfo[blockNum] |= defsKilled;
+      if (rd->_regularKillSetInfo[blockNum] == NULL)
+         rd->allocateContainer(&rd->_regularKillSetInfo[blockNum]);
+      *rd->_regularKillSetInfo[blockNum] |= defsKilled;
       if (!seenException)
          {
-         if (_exceptionKillSetInfo[blockNum] == NULL)
-            allocateContainer(&_exceptionKillSetInfo[blockNum]);
-         *_exceptionKillSetInfo[blockNum] |= defsKilled;
+         if (rd->_exceptionKillSetInfo[blockNum] == NULL)
+            rd->allocateContainer(&rd->_exceptionKillSetInfo[blockNum]);
+         *rd->_exceptionKillSetInfo[blockNum] |= defsKilled;
          }
       }
-   if (_regularGenSetInfo[blockNum] == NULL)
-     allocateContainer(&_regularGenSetInfo[blockNum]);
+   if (rd->_regularGenSetInfo[blockNum] == NULL)
+     rd->allocateContainer(&rd->_regularGenSetInfo[blockNum]);
    else if (foundDefsToKill)
-      *_regularGenSetInfo[blockNum] -= defsKilled;
+      *rd->_regularGenSetInfo[blockNum] -= defsKilled;
 
-   if (_exceptionGenSetInfo[blockNum] == NULL)
-      allocateContainer(&_exceptionGenSetInfo[blockNum]);
+   if (rd->_exceptionGenSetInfo[blockNum] == NULL)
+      rd->allocateContainer(&rd->_exceptionGenSetInfo[blockNum]);
    else if (foundDefsToKill && !seenException)
-      *_exceptionGenSetInfo[blockNum] -= defsKilled;
+      *rd->_exceptionGenSetInfo[blockNum] -= defsKilled;
 
    if (!irrelevantStore)
       {
       for (i = 0; i < numDefNodes; ++i)
          {
-         _regularGenSetInfo[blockNum]->set(nodeIndex+i);
-         _exceptionGenSetInfo[blockNum]->set(nodeIndex+i);
+         rd->_regularGenSetInfo[blockNum]->set(nodeIndex+i);
+         rd->_exceptionGenSetInfo[blockNum]->set(nodeIndex+i);
          }
       }
    else // fake up the method entry def as the def index to "gen" to avoid a use without a def completely
       {
-      _regularGenSetInfo[blockNum]->set(sym->getLocalIndex());
-      _exceptionGenSetInfo[blockNum]->set(sym->getLocalIndex());
+      rd->_regularGenSetInfo[blockNum]->set(sym->getLocalIndex());
+      rd->_exceptionGenSetInfo[blockNum]->set(sym->getLocalIndex());
+      }
+   }
+
+
+template <class Analysis>
+static void initializeGenAndKillSetInfo(Analysis *rd, TR_UseDefInfo *useDefInfo, TR_UseDefInfo::AuxiliaryData &aux)
+   {
+   // For each block in the CFG build the gen and kill set for this analysis.
+   // Go in treetop order, which guarantees that we see the correct (i.e. first)
+   // evaluation point for each node.
+   //
+   TR::Block *block;
+   int32_t   blockNum = 0;
+   bool      seenException = false;
+   TR_BitVector defsKilled(rd->getNumberOfBits(), rd->trMemory()->currentStackRegion());
+
+   rd->comp()->incVisitCount();
+   for (TR::TreeTop *treeTop = rd->comp()->getStartTree(); treeTop; treeTop = treeTop->getNextTreeTop())
+      {
+      TR::Node *node = treeTop->getNode();
+
+      if (node->getOpCodeValue() == TR::BBStart)
+         {
+         block = node->getBlock();
+         blockNum = block->getNumber();
+         seenException  = false;
+         if (rd->traceRD())
+            traceMsg(rd->comp(), "\nNow generating gen and kill information for block_%d\n", blockNum);
+         continue;
+         }
+
+#if DEBUG
+      if (node->getOpCodeValue() == TR::BBEnd && rd->traceRD())
+         {
+         traceMsg(rd->comp(), "  Block %d:\n", blockNum);
+         traceMsg(rd->comp(), "     Gen set ");
+         if (rd->_regularGenSetInfo[blockNum])
+            rd->_regularGenSetInfo[blockNum]->print(rd->comp());
+         else
+            traceMsg(rd->comp(), "{}");
+         traceMsg(rd->comp(), "\n     Kill set ");
+         if (rd->_regularKillSetInfo[blockNum])
+            rd->_regularKillSetInfo[blockNum]->print(rd->comp());
+         else
+            traceMsg(rd->comp(), "{}");
+         traceMsg(rd->comp(), "\n     Exception Gen set ");
+         if (rd->_exceptionGenSetInfo[blockNum])
+            rd->_exceptionGenSetInfo[blockNum]->print(rd->comp());
+         else
+            traceMsg(rd->comp(), "{}");
+         traceMsg(rd->comp(), "\n     Exception Kill set ");
+         if (rd->_exceptionKillSetInfo[blockNum])
+            rd->_exceptionKillSetInfo[blockNum]->print(rd->comp());
+         else
+            traceMsg(rd->comp(), "{}");
+         continue;
+         }
+#endif
+
+      initializeGenAndKillSetInfoForNode(rd, useDefInfo, aux, node, defsKilled, seenException, blockNum, NULL);
+
+      if (!seenException && rd->treeHasChecks(treeTop))
+         seenException = true;
       }
    }
+
+
+TR_DataFlowAnalysis::Kind TR_ReachingDefinitions::getKind()
+   {
+   return ReachingDefinitions;
+   }
+
+bool TR_ReachingDefinitions::supportsGenAndKillSets()
+   {
+   return true;
+   }
+
+
+TR_ReachingDefinitions::TR_ReachingDefinitions(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, TR_UseDefInfo *useDefInfo, TR_UseDefInfo::AuxiliaryData &aux, bool trace)
+   : TR_UnionBitVectorAnalysis(comp, cfg, optimizer, trace),
+     _useDefInfo(useDefInfo),
+     _aux(aux)
+   {
+   _traceRD = comp->getOption(TR_TraceUseDefs);
+   }
+
+int32_t TR_ReachingDefinitions::perform()
+   {
+   return performReachingDefinitions(this, _cfg);
+   }
+
+
+int32_t TR_ReachingDefinitions::getNumberOfBits()
+   {
+   return _useDefInfo->getNumExpandedDefNodes();
+   }
+
+
+void TR_ReachingDefinitions::analyzeBlockZeroStructure(TR_BlockStructure *blockStructure)
+   {
+   ::analyzeBlockZeroStructure(this, _useDefInfo);
+   }
+
+
+void TR_ReachingDefinitions::initializeGenAndKillSetInfo()
+   {
+   ::initializeGenAndKillSetInfo(this, _useDefInfo, _aux);
+   }
+
+
+TR_DataFlowAnalysis::Kind TR_ChunkedReachingDefinitions::getKind()
+   {
+   return ReachingDefinitions;
+   }
+
+bool TR_ChunkedReachingDefinitions::supportsGenAndKillSets()
+   {
+   return true;
+   }
+
+
+TR_ChunkedReachingDefinitions::TR_ChunkedReachingDefinitions(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, TR_UseDefInfo *useDefInfo, TR_UseDefInfo::AuxiliaryData &aux, bool trace)
+   : TR_UnionChunkedBitVectorAnalysis(comp, cfg, optimizer, trace),
+     _useDefInfo(useDefInfo),
+     _aux(aux)
+   {
+   _traceRD = comp->getOption(TR_TraceUseDefs);
+   }
+
+int32_t TR_ChunkedReachingDefinitions::perform()
+   {
+   return performReachingDefinitions(this, _cfg);
+   }
+
+
+int32_t TR_ChunkedReachingDefinitions::getNumberOfBits()
+   {
+   return _useDefInfo->getNumExpandedDefNodes();
+   }
+
+
+void TR_ChunkedReachingDefinitions::analyzeBlockZeroStructure(TR_BlockStructure *blockStructure)
+   {
+   ::analyzeBlockZeroStructure(this, _useDefInfo);
+   }
+
+
+void TR_ChunkedReachingDefinitions::initializeGenAndKillSetInfo()
+   {
+   ::initializeGenAndKillSetInfo(this, _useDefInfo, _aux);
+   }
@@ -3516,6 +3516,359 @@ TR_RegisterCandidates::assign(TR::Block ** cfgBlocks, int32_t numberOfBlocks, in
    }
 
 
+namespace
+{
+struct LiveInterval
+   {
+   TR_RegisterCandidate *_candidate;
+   int32_t               _start;    // tree order position of the first block the candidate is live in
+   int32_t               _end;      // tree order position of the last block the candidate is live in
+   int32_t               _firstRegister;
+   int32_t               _lastRegister;
+   int32_t               _register; // -1 while the candidate stays in memory
+   bool                  _spansCall;
+   };
+
+bool startsBefore(const LiveInterval *a, const LiveInterval *b)
+   {
+   return a->_start < b->_start || (a->_start == b->_start && a->_candidate->getWeight() > b->_candidate->getWeight());
+   }
+
+bool isHeavier(const LiveInterval *a, const LiveInterval *b)
+   {
+   return a->_candidate->getWeight() > b->_candidate->getWeight();
+   }
+}
+
+/**
+ * Linear scan alternative to assign() for low optimization levels.
+ *
+ * The live range of a candidate is the span, in tree order, of the blocks it
+ * is live on entry to or on exit from according to liveness. Live ranges are
+ * visited by increasing start and take the first free global register of
+ * their kind; when none is free, the lightest of the active ranges and the
+ * current one stays in memory. There is no register pressure simulation and
+ * no trimming of live ranges, which is where assign() spends its time.
+ *
+ * Candidates needing a register pair, or live in a catch block, are left in
+ * memory.
+ */
+bool
+TR_RegisterCandidates::assignLinearScan(TR::Block ** cfgBlocks, int32_t numberOfBlocks, int32_t & lowestNumber, int32_t & highestNumber)
+   {
+   LexicalTimer t("assignLinearScan", comp()->phaseTimer());
+   bool trace = comp()->getOptions()->trace(OMR::tacticalGlobalRegisterAllocator);
+   TR::CodeGenerator * cg = comp()->cg();
+   TR::Region &region = comp()->trMemory()->currentStackRegion();
+
+   bool globalFPAssignmentDone = false;
+   highestNumber = -1;
+   lowestNumber = INT_MAX;
+
+   if (_candidates.getFirst() == NULL)
+      return globalFPAssignmentDone;
+
+   // Collect the per block information the live ranges are built from
+   //
+   int32_t *position = (int32_t *)trMemory()->allocateStackMemory(numberOfBlocks * sizeof(int32_t));
+   int32_t *blockStructureWeight = (int32_t *)trMemory()->allocateStackMemory(numberOfBlocks * sizeof(int32_t));
+   int32_t *maxGPRsLiveOnExit = (int32_t *)trMemory()->allocateStackMemory(numberOfBlocks * sizeof(int32_t));
+   int32_t *maxFPRsLiveOnExit = (int32_t *)trMemory()->allocateStackMemory(numberOfBlocks * sizeof(int32_t));
+   int32_t *maxVRFsLiveOnExit = (int32_t *)trMemory()->allocateStackMemory(numberOfBlocks * sizeof(int32_t));
+   memset(blockStructureWeight, 0, numberOfBlocks * sizeof(int32_t));
+
+   TR_BitVector callBlocks(numberOfBlocks, trMemory(), stackAlloc, growable);
+   TR_BitVector catchBlockLiveLocals(comp()->getSymRefCount(), trMemory(), stackAlloc, growable);
+   bool catchBlockLiveLocalsExist = false;
+
+   int32_t nextPosition = 0;
+   for (TR::Block * b = comp()->getStartBlock(); b; b = b->getNextBlock())
+      {
+      int32_t blockNumber = b->getNumber();
+      position[blockNumber] = nextPosition++;
+
+      if (b->getStructureOf())
+         comp()->getOptimizer()->getStaticFrequency(b, &blockStructureWeight[blockNumber]);
+
+      TR::Node * lastNode = b->getLastRealTreeTop()->getNode();
+      maxGPRsLiveOnExit[blockNumber] = cg->getMaximumNumberOfGPRsAllowedAcrossEdge(b);
+      maxFPRsLiveOnExit[blockNumber] = cg->getMaximumNumberOfFPRsAllowedAcrossEdge(lastNode);
+      maxVRFsLiveOnExit[blockNumber] = cg->getMaximumNumberOfVRFsAllowedAcrossEdge(lastNode);
+
+      if (!b->getExceptionPredecessors().empty() && cg->getLiveLocals() && b->getLiveLocals())
+         {
+         catchBlockLiveLocalsExist = true;
+         catchBlockLiveLocals |= *b->getLiveLocals();
+         }
+
+      for (TR::TreeTop * tt = b->getEntry(); tt != b->getExit(); tt = tt->getNextTreeTop())
+         {
+         TR::Node * node = tt->getNode();
+         if (node->getNumChildren() > 0 && node->getOpCode().isTreeTop() && !node->getOpCode().isCall())
+            node = node->getFirstChild();
+         if (node->getOpCode().isCall() || node->getOpCode().isResolveCheck())
+            {
+            callBlocks.set(blockNumber);
+            break;
+            }
+         }
+      }
+
+   collectCfgProperties(cfgBlocks, numberOfBlocks);
+
+   TR_BitVector referencedBlocks(numberOfBlocks, trMemory(), stackAlloc, growable);
+   TR_Array<int32_t> totalGPRCount(trMemory(), numberOfBlocks, true, stackAlloc);
+   TR_Array<int32_t> totalFPRCount(trMemory(), numberOfBlocks, true, stackAlloc);
+   TR_Array<int32_t> totalVRFCount(trMemory(), numberOfBlocks, true, stackAlloc);
+   for (int32_t i = 0; i < numberOfBlocks; ++i)
+      {
+      totalGPRCount[i] = 0;
+      totalFPRCount[i] = 0;
+      totalVRFCount[i] = 0;
+      }
+
+   // Registers the code generator reserves in some blocks
+   //
+   int32_t numberOfGlobalRegisters = cg->getNumberOfGlobalRegisters();
+   _liveOnEntryUsage.init(trMemory(), numberOfGlobalRegisters, true, stackAlloc);
+   _liveOnExitUsage.init(trMemory(), numberOfGlobalRegisters, true, stackAlloc);
+   for (int32_t i = _liveOnEntryUsage.internalSize() - 1; i >= 0; --i)
+      {
+      _liveOnEntryUsage[i].init(numberOfBlocks, trMemory(), stackAlloc, growable);
+      _liveOnExitUsage[i].init(numberOfBlocks, trMemory(), stackAlloc, growable);
+      }
+   cg->setUnavailableRegistersUsage(_liveOnEntryUsage, _liveOnExitUsage);
+
+   TR_BitVector *vmThreadRegisters = cg->getGlobalRegisters(TR_vmThreadSpill, comp()->getMethodSymbol()->getLinkageConvention());
+   TR_BitVector *volatileRegisters = cg->getGlobalRegisters(TR_volatileSpill, comp()->getMethodSymbol()->getLinkageConvention());
+
+   // Build the live ranges
+   //
+   TR::vector<LiveInterval *, TR::Region&> intervals(region);
+   TR_BitVector liveBlocks(numberOfBlocks, trMemory(), stackAlloc, growable);
+   for (TR_RegisterCandidate * rc = _candidates.getFirst(); rc; rc = rc->getNext())
+      {
+      TR::SymbolReference * symRef = rc->getSymbolReference();
+      TR::Symbol * symbol = symRef->getSymbol();
+      TR::DataType dt = rc->getDataType();
+      bool isFloat = (dt == TR::Float || dt == TR::Double);
+      bool isVector = dt.isVector();
+
+      if ((rc->getType().isInt64() && cg->getDisableLongGRA()) ||
+          dt == TR::Aggregate ||
+          !symbol->isAutoOrParm() ||
+          symbol->holdsMonitoredObject() ||
+          aliasesPreventAllocation(comp(), symRef) ||
+          (isVector && !cg->hasGlobalVRF()) ||
+          (isFloat && cg->getDisableFloatingPointGRA()) ||
+          rc->rcNeeds2Regs(comp()))
+         {
+         if (trace)
+            traceMsg(comp(), "Leaving candidate #%d in memory\n", symRef->getReferenceNumber());
+         continue;
+         }
+
+      if ((catchBlockLiveLocalsExist && symbol->isAuto() && catchBlockLiveLocals.get(symbol->getAutoSymbol()->getLiveLocalIndex())) ||
+          ((!catchBlockLiveLocalsExist || !symbol->isAuto()) && !symRef->getUseonlyAliases().isZero(comp())))
+         {
+         if (trace)
+            traceMsg(comp(), "Leaving candidate #%d in memory, it is live across an exception edge\n", symRef->getReferenceNumber());
+         continue;
+         }
+
+      rc->setWeight(cfgBlocks, blockStructureWeight, comp(), totalGPRCount, totalFPRCount, totalVRFCount, &referencedBlocks, _startOfExtendedBBForBB,
+                    _firstBlock, _isExtensionOfPreviousBlock);
+
+      liveBlocks = rc->getBlocksLiveOnEntry();
+      liveBlocks |= rc->getBlocksLiveOnExit();
+      if (liveBlocks.isEmpty())
+         continue;
+
+      LiveInterval *interval = new (region) LiveInterval;
+      interval->_candidate = rc;
+      interval->_start = INT_MAX;
+      interval->_end = -1;
+      interval->_register = -1;
+      interval->_spansCall = liveBlocks.intersects(callBlocks);
+
+      TR_BitVectorIterator bvi(liveBlocks);
+      while (bvi.hasMoreElements())
+         {
+         int32_t blockPosition = position[bvi.getNextElement()];
+         interval->_start = std::min(interval->_start, blockPosition);
+         interval->_end = std::max(interval->_end, blockPosition);
+         }
+
+      if (isFloat)
+         {
+         interval->_firstRegister = cg->getFirstGlobalFPR();
+         interval->_lastRegister = cg->getLastGlobalFPR();
+         }
+      else if (isVector)
+         {
+         interval->_firstRegister = cg->getFirstGlobalVRF();
+         interval->_lastRegister = cg->getLastGlobalVRF();
+         }
+      else
+         {
+         interval->_firstRegister = cg->getFirstGlobalGPR();
+         interval->_lastRegister = cg->getLastGlobalGPR();
+         }
+
+      if (trace)
+         traceMsg(comp(), "Candidate #%d (weight %d) live from %d to %d\n",
+            symRef->getReferenceNumber(), rc->getWeight(), interval->_start, interval->_end);
+
+      intervals.push_back(interval);
+      }
+
+   std::sort(intervals.begin(), intervals.end(), startsBefore);
+
+   // Scan the live ranges by increasing start
+   //
+   LiveInterval **occupant = (LiveInterval **)trMemory()->allocateStackMemory(numberOfGlobalRegisters * sizeof(LiveInterval *));
+   memset(occupant, 0, numberOfGlobalRegisters * sizeof(LiveInterval *));
+   TR_BitVector availableRegisters(numberOfGlobalRegisters, trMemory(), stackAlloc);
+
+   for (auto itr = intervals.begin(); itr != intervals.end(); ++itr)
+      {
+      LiveInterval *interval = *itr;
+      TR_RegisterCandidate *rc = interval->_candidate;
+
+      availableRegisters.empty();
+      for (int32_t i = interval->_firstRegister; i <= interval->_lastRegister; ++i)
+         {
+         if (occupant[i] && occupant[i]->_end < interval->_start)
+            occupant[i] = NULL;
+
+         if (!_liveOnEntryUsage[i].intersects(rc->getBlocksLiveOnEntry()) &&
+             !_liveOnExitUsage[i].intersects(rc->getBlocksLiveOnExit()))
+            availableRegisters.set(i);
+         }
+      if (vmThreadRegisters)
+         availableRegisters -= *vmThreadRegisters;
+      cg->removeUnavailableRegisters(rc, cfgBlocks, availableRegisters);
+
+      int32_t registerNumber = -1;
+      LiveInterval *lightest = NULL;
+      TR_BitVectorIterator bvi(availableRegisters);
+      while (bvi.hasMoreElements())
+         {
+         int32_t i = bvi.getNextElement();
+         if (occupant[i])
+            {
+            if (!lightest || isHeavier(lightest, occupant[i]))
+               lightest = occupant[i];
+            continue;
+            }
+
+         // Ranges spanning a call prefer registers preserved across calls
+         //
+         if (registerNumber == -1 ||
+             (interval->_spansCall && volatileRegisters &&
+              volatileRegisters->isSet(registerNumber) && !volatileRegisters->isSet(i)))
+            registerNumber = i;
+         }
+
+      if (registerNumber == -1 && lightest && isHeavier(interval, lightest))
+         {
+         if (trace)
+            traceMsg(comp(), "Candidate #%d takes register %d from candidate #%d\n", rc->getSymbolReference()->getReferenceNumber(),
+               lightest->_register, lightest->_candidate->getSymbolReference()->getReferenceNumber());
+         registerNumber = lightest->_register;
+         lightest->_register = -1;
+         }
+
+      if (registerNumber != -1)
+         {
+         interval->_register = registerNumber;
+         occupant[registerNumber] = interval;
+         }
+      }
+
+   // Commit the assignments, heaviest first, within the limits on registers
+   // live across each edge
+   //
+   std::sort(intervals.begin(), intervals.end(), isHeavier);
+
+   TR_Array<int32_t> numberOfGPRsLiveOnExit(trMemory(), numberOfBlocks, true, stackAlloc);
+   TR_Array<int32_t> numberOfFPRsLiveOnExit(trMemory(), numberOfBlocks, true, stackAlloc);
+   TR_Array<int32_t> numberOfVRFsLiveOnExit(trMemory(), numberOfBlocks, true, stackAlloc);
+   for (int32_t i = 0; i < numberOfBlocks; ++i)
+      {
+      numberOfGPRsLiveOnExit[i] = 0;
+      numberOfFPRsLiveOnExit[i] = 0;
+      numberOfVRFsLiveOnExit[i] = 0;
+      }
+
+   _candidates.setFirst(0);
+   _candidateForSymRefs->clear();
+
+   for (auto itr = intervals.begin(); itr != intervals.end(); ++itr)
+      {
+      LiveInterval *interval = *itr;
+      TR_RegisterCandidate *rc = interval->_candidate;
+      int32_t registerNumber = interval->_register;
+      if (registerNumber == -1)
+         continue;
+
+      TR::DataType dt = rc->getDataType();
+      bool isFloat = (dt == TR::Float || dt == TR::Double);
+      bool isVector = dt.isVector();
+      TR_Array<int32_t> &liveOnExitCount = isFloat ? numberOfFPRsLiveOnExit : (isVector ? numberOfVRFsLiveOnExit : numberOfGPRsLiveOnExit);
+      int32_t *maxLiveOnExit = isFloat ? maxFPRsLiveOnExit : (isVector ? maxVRFsLiveOnExit : maxGPRsLiveOnExit);
+
+      bool fits = true;
+      TR_BitVectorIterator bvi(rc->getBlocksLiveOnExit());
+      while (fits && bvi.hasMoreElements())
+         {
+         int32_t blockNumber = bvi.getNextElement();
+         if (liveOnExitCount[blockNumber] >= maxLiveOnExit[blockNumber])
+            fits = false;
+         }
+
+      if (!fits)
+         {
+         if (trace)
+            traceMsg(comp(), "Leaving candidate #%d in memory, too many registers live across an edge\n", rc->getSymbolReference()->getReferenceNumber());
+         continue;
+         }
+
+      if (!performTransformation(comp(), "%s assign auto #%d to reg %d (%s) by linear scan\n", OPT_DETAILS,
+            rc->getSymbolReference()->getReferenceNumber(), registerNumber,
+            comp()->getDebug() ? comp()->getDebug()->getGlobalRegisterName(registerNumber) : "?"))
+         continue;
+
+      bvi.setBitVector(rc->getBlocksLiveOnExit());
+      while (bvi.hasMoreElements())
+         {
+         int32_t blockNumber = bvi.getNextElement();
+         liveOnExitCount[blockNumber]++;
+         cfgBlocks[blockNumber]->getGlobalRegisters(comp())[registerNumber].setRegisterCandidateOnExit(rc);
+         }
+
+      bvi.setBitVector(rc->getBlocksLiveOnEntry());
+      while (bvi.hasMoreElements())
+         cfgBlocks[bvi.getNextElement()]->getGlobalRegisters(comp())[registerNumber].setRegisterCandidateOnEntry(rc);
+
+      _liveOnEntryUsage[registerNumber] |= rc->getBlocksLiveOnEntry();
+      _liveOnExitUsage[registerNumber] |= rc->getBlocksLiveOnExit();
+
+      if (isFloat)
+         globalFPAssignmentDone = true;
+
+      _candidates.add(rc);
+      (*_candidateForSymRefs)[GET_INDEX_FOR_CANDIDATE_FOR_SYMREF(rc->getSymbolReference())] = rc;
+      rc->setGlobalRegisterNumber(registerNumber);
+      rc->setIs8BitGlobalGPR(cg->is8BitGlobalGPR(registerNumber));
+
+      highestNumber = std::max(highestNumber, registerNumber);
+      lowestNumber = std::min(lowestNumber, registerNumber);
+      }
+
+   return globalFPAssignmentDone;
+   }
+
 void  ComputeOverlaps(TR::Node *node,
                       TR::Compilation *comp,
                       TR_RegisterCandidates::Coordinates &overlaps,
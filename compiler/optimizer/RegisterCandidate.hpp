@@ -335,6 +335,7 @@ public:
       }
 
    bool assign(TR::Block **, int32_t, int32_t &, int32_t &);
+   bool assignLinearScan(TR::Block **, int32_t, int32_t &, int32_t &);
    void computeAvailableRegisters(TR_RegisterCandidate *, int32_t, int32_t, TR::Block **, TR_BitVector *);
 
    static int32_t getWeightForType(TR_RegisterCandidateTypes type)
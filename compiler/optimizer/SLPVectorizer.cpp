@@ -0,0 +1,600 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/SLPVectorizer.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Assert.hpp"
+#include "infra/Checklist.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/TransformUtil.hpp"
+#include "ras/Debug.hpp"
+
+#define OPT_DETAILS "O^O SLP VECTORIZATION: "
+
+// Vector IL opcodes operate on 128-bit registers
+#define VECTOR_SIZE_IN_BYTES 16
+
+TR_SLPVectorizer::TR_SLPVectorizer(TR::OptimizationManager *manager)
+   : TR::Optimization(manager)
+   {}
+
+int32_t
+TR_SLPVectorizer::perform()
+   {
+   if (comp()->getOption(TR_DisableAutoSIMD) ||
+       !cg()->getSupportsAutoSIMD() ||
+       !comp()->target().is64Bit())
+      return 0;
+
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   int32_t groupsPacked = 0;
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      TR::TreeTop *vectorTree = packStores(tt, stackMemoryRegion);
+      if (vectorTree)
+         {
+         tt = vectorTree;
+         groupsPacked++;
+         }
+      }
+
+   return groupsPacked;
+   }
+
+const char *
+TR_SLPVectorizer::optDetailString() const throw()
+   {
+   return "O^O SLP VECTORIZATION: ";
+   }
+
+/**
+ * Tries to pack the group of VL stores starting at \p first.
+ *
+ * \return the tree of the vector store that replaced the group, or NULL when
+ *         the trees were left alone.
+ */
+TR::TreeTop *
+TR_SLPVectorizer::packStores(TR::TreeTop *first, TR::Region &region)
+   {
+   TR::Node *store = first->getNode();
+   if (!store->getOpCode().isStoreIndirect() || store->getOpCode().isWrtBar())
+      return NULL;
+
+   TR::DataType type = store->getDataType();
+   if (type != TR::Int32 && type != TR::Int64 && type != TR::Float && type != TR::Double)
+      return NULL;
+
+   if (!supportsVectorOp(TR::vstorei, type) || !supportsVectorOp(TR::vloadi, type))
+      return NULL;
+
+   int32_t lanes = VECTOR_SIZE_IN_BYTES / TR::DataType::getSize(type);
+   TR::Node **stores = new (region) TR::Node *[lanes];
+   TR::TreeTop *tt = first;
+   for (int32_t lane = 0; lane < lanes; ++lane, tt = tt->getNextTreeTop())
+      {
+      if (!tt || tt->getNode()->getOpCodeValue() != store->getOpCodeValue())
+         return NULL;
+      stores[lane] = tt->getNode();
+      }
+
+   Group group(region, type, lanes);
+   for (int32_t lane = 0; lane < lanes; ++lane)
+      countGroupReferences(group, stores[lane]);
+
+   Address storeAddress;
+   if (!areAdjacent(group, stores, storeAddress))
+      return NULL;
+
+   TR::Node **values = new (region) TR::Node *[lanes];
+   for (int32_t lane = 0; lane < lanes; ++lane)
+      values[lane] = stores[lane]->getSecondChild();
+
+   if (!analyzePack(group, values))
+      {
+      if (trace())
+         traceMsg(comp(), "Stores starting at n%dn are adjacent but their values are not isomorphic\n", store->getGlobalIndex());
+      return NULL;
+      }
+
+   if (!analyzeDependences(group, stores, storeAddress))
+      {
+      if (trace())
+         traceMsg(comp(), "Stores starting at n%dn may overlap one of the packed loads\n", store->getGlobalIndex());
+      return NULL;
+      }
+
+   group._scalarCost += lanes;
+   group._vectorCost += 1;
+
+   if (trace())
+      traceMsg(comp(), "Group of %d stores starting at n%dn: scalar cost %d, vector cost %d\n",
+         lanes, store->getGlobalIndex(), group._scalarCost, group._vectorCost);
+
+   if (group._vectorCost >= group._scalarCost)
+      return NULL;
+
+   if (!performTransformation(comp(), "%sPacking %d %s stores starting at n%dn\n", OPT_DETAILS,
+         lanes, TR::DataType::getName(type), store->getGlobalIndex()))
+      return NULL;
+
+   TR::Node *vectorStore = TR::Node::createWithSymRef(TR::vstorei, 2, store->getFirstChild(), buildVector(group, values), 0,
+      TR::TransformUtil::createVectorShadowSymbolRef(comp(), store->getSymbolReference()));
+   TR::TreeTop *vectorTree = TR::TreeTop::create(comp(), vectorStore);
+   first->insertBefore(vectorTree);
+
+   // Anything the scalar trees computed that is still referenced after the
+   // group and is not evaluated by the vector tree has to be anchored there
+   //
+   TR::NodeChecklist evaluated(comp());
+   TR::NodeChecklist visited(comp());
+   anchorExternalReferences(group, vectorStore, evaluated, evaluated, NULL);
+   for (int32_t lane = 0; lane < lanes; ++lane)
+      anchorExternalReferences(group, stores[lane], evaluated, visited, vectorTree);
+
+   tt = first;
+   for (int32_t lane = 0; lane < lanes; ++lane)
+      {
+      TR::TreeTop *next = tt->getNextTreeTop();
+      tt->unlink(true);
+      tt = next;
+      }
+
+   return vectorTree;
+   }
+
+/**
+ * Counts the references to every node under \p node coming from within the
+ * group, visiting the children of each node only once.
+ */
+void
+TR_SLPVectorizer::countGroupReferences(Group &group, TR::Node *node)
+   {
+   for (int32_t i = 0; i < node->getNumChildren(); ++i)
+      {
+      TR::Node *child = node->getChild(i);
+      int32_t &count = group._groupReferences[child];
+      if (count++ == 0)
+         countGroupReferences(group, child);
+      }
+   }
+
+bool
+TR_SLPVectorizer::isOnlyReferencedInGroup(Group &group, TR::Node *node)
+   {
+   ReferenceCountMap::iterator entry = group._groupReferences.find(node);
+   return entry != group._groupReferences.end() && entry->second == node->getReferenceCount();
+   }
+
+/**
+ * Whether \p first and \p second are known to produce the same value when
+ * evaluated anywhere within the group.
+ */
+bool
+TR_SLPVectorizer::isSameValue(Group &group, TR::Node *first, TR::Node *second)
+   {
+   if (first == second)
+      return true;
+
+   if (first->getOpCodeValue() != second->getOpCodeValue() ||
+       first->getNumChildren() != second->getNumChildren())
+      return false;
+
+   TR::ILOpCode &op = first->getOpCode();
+   if (op.isLoadConst())
+      {
+      switch (first->getDataType())
+         {
+         case TR::Float:
+            return first->getFloatBits() == second->getFloatBits();
+         case TR::Double:
+            return first->getDoubleBits() == second->getDoubleBits();
+         case TR::Address:
+            return first->getAddress() == second->getAddress();
+         default:
+            return first->getDataType().isIntegral() &&
+                   first->get64bitIntegralValue() == second->get64bitIntegralValue();
+         }
+      }
+
+   // The group only stores through shadows, so autos and parms cannot change
+   // between two of its trees
+   //
+   if (op.isLoadVarDirect())
+      return first->getSymbol() == second->getSymbol() &&
+             first->getSymbol()->isAutoOrParm() &&
+             isOnlyReferencedInGroup(group, first) &&
+             isOnlyReferencedInGroup(group, second);
+
+   if ((op.isArithmetic() || op.isConversion()) && !op.isDiv() && !op.isRem() &&
+       !op.isLoad() && !op.isStore() && !op.isCall())
+      {
+      for (int32_t i = 0; i < first->getNumChildren(); ++i)
+         {
+         if (!isSameValue(group, first->getChild(i), second->getChild(i)))
+            return false;
+         }
+      return true;
+      }
+
+   return false;
+   }
+
+/**
+ * Splits the address of the indirect load or store \p memRef into
+ * base + index * scale + offset.
+ */
+bool
+TR_SLPVectorizer::decomposeAddress(Group &group, TR::Node *memRef, Address &address)
+   {
+   TR::SymbolReference *symRef = memRef->getSymbolReference();
+   TR::Symbol *symbol = symRef->getSymbol();
+   if (symRef->isUnresolved() || symbol->isVolatile() || memRef->getDataType() != group._type)
+      return false;
+
+   if (!(symbol->isArrayShadowSymbol() && symRef->getOffset() == 0) && !symbol->isNamedShadowSymbol())
+      return false;
+
+   TR::Node *addr = memRef->getFirstChild();
+   address._offset = symRef->getOffset();
+   if (addr->getOpCodeValue() != TR::aladd)
+      {
+      address._base = addr;
+      address._index = NULL;
+      address._scale = 0;
+      return true;
+      }
+
+   int64_t offset = 0;
+   address._base = addr->getFirstChild();
+   if (!decomposeIndex(addr->getSecondChild(), address._index, address._scale, offset))
+      return false;
+
+   address._offset += offset;
+   return true;
+   }
+
+/**
+ * Splits the integral expression \p index into variable * scale + offset,
+ * where \p variable is the part that could not be folded further and is
+ * NULL when the whole expression is constant.
+ */
+bool
+TR_SLPVectorizer::decomposeIndex(TR::Node *index, TR::Node *&variable, int64_t &scale, int64_t &offset)
+   {
+   TR::ILOpCode &op = index->getOpCode();
+   if (op.isLoadConst())
+      {
+      if (!index->getDataType().isIntegral())
+         return false;
+      variable = NULL;
+      scale = 0;
+      offset = index->get64bitIntegralValue();
+      return true;
+      }
+
+   if (index->getOpCodeValue() == TR::i2l)
+      return decomposeIndex(index->getFirstChild(), variable, scale, offset);
+
+   if (index->getNumChildren() == 2 &&
+       (index->getDataType() == TR::Int32 || index->getDataType() == TR::Int64) &&
+       index->getSecondChild()->getOpCode().isLoadConst())
+      {
+      int64_t constant = index->getSecondChild()->get64bitIntegralValue();
+      if (op.isAdd() || op.isSub() || op.isMul() || op.isLeftShift())
+         {
+         if (!decomposeIndex(index->getFirstChild(), variable, scale, offset))
+            return false;
+
+         if (op.isAdd())
+            offset += constant;
+         else if (op.isSub())
+            offset -= constant;
+         else
+            {
+            int64_t factor = op.isMul() ? constant : ((int64_t)1 << (constant & 63));
+            scale *= factor;
+            offset *= factor;
+            }
+         return true;
+         }
+      }
+
+   variable = index;
+   scale = 1;
+   offset = 0;
+   return true;
+   }
+
+/**
+ * Whether the indirect loads or stores in \p memRefs access adjacent
+ * elements, lane 0 at the lowest address. The address of lane 0 is
+ * returned in \p first.
+ */
+bool
+TR_SLPVectorizer::areAdjacent(Group &group, TR::Node **memRefs, Address &first)
+   {
+   int32_t elementSize = TR::DataType::getSize(group._type);
+   for (int32_t lane = 0; lane < group._lanes; ++lane)
+      {
+      Address address;
+      if (!decomposeAddress(group, memRefs[lane], address))
+         return false;
+
+      if (lane == 0)
+         {
+         first = address;
+         continue;
+         }
+
+      if (!isSameValue(group, first._base, address._base) ||
+          (first._index == NULL) != (address._index == NULL))
+         return false;
+
+      if (first._index &&
+          (first._scale != address._scale || !isSameValue(group, first._index, address._index)))
+         return false;
+
+      if (address._offset != first._offset + lane * elementSize)
+         return false;
+      }
+
+   return true;
+   }
+
+/**
+ * Decides how the lanes of \p lanes, one scalar node per lane, are turned
+ * into a single vector node and accumulates the cost of doing so.
+ */
+bool
+TR_SLPVectorizer::analyzePack(Group &group, TR::Node **lanes)
+   {
+   TR::Node *lead = lanes[0];
+   PackMap::iterator existing = group._packs.find(lead);
+   if (existing != group._packs.end())
+      {
+      for (int32_t lane = 1; lane < group._lanes; ++lane)
+         {
+         if (existing->second->_lanes[lane] != lanes[lane])
+            return false;
+         }
+      return true;
+      }
+
+   if (lead->getDataType() != group._type)
+      return false;
+
+   Pack *pack = new (group._region) Pack;
+   pack->_lanes = new (group._region) TR::Node *[group._lanes];
+   pack->_vector = NULL;
+
+   bool isSplat = true;
+   for (int32_t lane = 0; lane < group._lanes; ++lane)
+      {
+      pack->_lanes[lane] = lanes[lane];
+      if (!isSameValue(group, lead, lanes[lane]))
+         isSplat = false;
+      }
+
+   TR::ILOpCode &op = lead->getOpCode();
+   if (isSplat)
+      {
+      if (!supportsVectorOp(TR::vsplats, group._type))
+         return false;
+      pack->_kind = SplatPack;
+      group._vectorCost += 1;
+      }
+   else if (op.isLoadIndirect())
+      {
+      for (int32_t lane = 0; lane < group._lanes; ++lane)
+         {
+         if (lanes[lane]->getOpCodeValue() != lead->getOpCodeValue() || !isOnlyReferencedInGroup(group, lanes[lane]))
+            return false;
+         }
+
+      if (!areAdjacent(group, lanes, pack->_address))
+         return false;
+
+      pack->_kind = LoadPack;
+      group._loadPacks.push_back(pack);
+      group._scalarCost += group._lanes;
+      group._vectorCost += 1;
+      }
+   else if (lead->getNumChildren() == 2 &&
+            (op.isAdd() || op.isSub() || op.isMul() || op.isAnd() || op.isOr() || op.isXor() ||
+             (op.isDiv() && group._type.isFloatingPoint())))
+      {
+      for (int32_t lane = 0; lane < group._lanes; ++lane)
+         {
+         if (lanes[lane]->getOpCodeValue() != lead->getOpCodeValue() || !isOnlyReferencedInGroup(group, lanes[lane]))
+            return false;
+         }
+
+      if (!supportsVectorOp(TR::ILOpCode::convertScalarToVector(lead->getOpCodeValue()), group._type))
+         return false;
+
+      TR::Node **operands = new (group._region) TR::Node *[group._lanes];
+      for (int32_t i = 0; i < 2; ++i)
+         {
+         for (int32_t lane = 0; lane < group._lanes; ++lane)
+            operands[lane] = lanes[lane]->getChild(i);
+         if (!analyzePack(group, operands))
+            return false;
+         }
+
+      pack->_kind = OperationPack;
+      group._scalarCost += group._lanes;
+      group._vectorCost += 1;
+      }
+   else
+      {
+      if (trace())
+         traceMsg(comp(), "Cannot pack n%dn %s\n", lead->getGlobalIndex(), lead->getOpCode().getName());
+      return false;
+      }
+
+   group._packs[lead] = pack;
+   return true;
+   }
+
+/**
+ * Packing hoists every load of the group above every store of the group, so
+ * no packed load may read an element stored by an earlier lane.
+ */
+bool
+TR_SLPVectorizer::analyzeDependences(Group &group, TR::Node **stores, Address &storeAddress)
+   {
+   for (auto pack = group._loadPacks.begin(); pack != group._loadPacks.end(); ++pack)
+      {
+      Address &loadAddress = (*pack)->_address;
+      if (isSameValue(group, loadAddress._base, storeAddress._base) &&
+          (loadAddress._index == NULL) == (storeAddress._index == NULL) &&
+          (loadAddress._index == NULL ||
+           (loadAddress._scale == storeAddress._scale && isSameValue(group, loadAddress._index, storeAddress._index))))
+         {
+         int64_t distance = storeAddress._offset - loadAddress._offset;
+         if (distance != 0 && distance > -VECTOR_SIZE_IN_BYTES && distance < VECTOR_SIZE_IN_BYTES)
+            return false;
+         continue;
+         }
+
+      for (int32_t storeLane = 0; storeLane < group._lanes; ++storeLane)
+         {
+         TR::SymbolReference *storeSymRef = stores[storeLane]->getSymbolReference();
+         for (int32_t loadLane = 0; loadLane < group._lanes; ++loadLane)
+            {
+            TR::SymbolReference *loadSymRef = (*pack)->_lanes[loadLane]->getSymbolReference();
+            if (storeSymRef->getSymbol() == loadSymRef->getSymbol() ||
+                storeSymRef->getUseDefAliases().contains(loadSymRef, comp()))
+               return false;
+            }
+         }
+      }
+
+   return true;
+   }
+
+bool
+TR_SLPVectorizer::supportsVectorOp(TR::ILOpCodes op, TR::DataType type)
+   {
+   if (op == TR::BadILOp)
+      return false;
+
+   TR::ILOpCode opCode;
+   opCode.setOpCodeValue(op);
+   return cg()->getSupportsOpCodeForAutoSIMD(opCode, type);
+   }
+
+/**
+ * Creates the vector node for the pack led by \p lanes[0]. Packs shared by
+ * several operations are only built once.
+ */
+TR::Node *
+TR_SLPVectorizer::buildVector(Group &group, TR::Node **lanes)
+   {
+   Pack *pack = group._packs[lanes[0]];
+   TR_ASSERT(pack, "n%dn was not analyzed", lanes[0]->getGlobalIndex());
+   if (pack->_vector)
+      return pack->_vector;
+
+   TR::Node *lead = pack->_lanes[0];
+   switch (pack->_kind)
+      {
+      case SplatPack:
+         pack->_vector = TR::Node::create(lead, TR::vsplats, 1, lead);
+         break;
+      case LoadPack:
+         pack->_vector = TR::Node::createWithSymRef(lead, TR::vloadi, 1, lead->getFirstChild(),
+            TR::TransformUtil::createVectorShadowSymbolRef(comp(), lead->getSymbolReference()));
+         break;
+      case OperationPack:
+         {
+         TR::Node *operands[2];
+         TR::Node **operandLanes = new (group._region) TR::Node *[group._lanes];
+         for (int32_t i = 0; i < 2; ++i)
+            {
+            for (int32_t lane = 0; lane < group._lanes; ++lane)
+               operandLanes[lane] = pack->_lanes[lane]->getChild(i);
+            operands[i] = buildVector(group, operandLanes);
+            }
+         pack->_vector = TR::Node::create(lead, TR::ILOpCode::convertScalarToVector(lead->getOpCodeValue()), 2,
+            operands[0], operands[1]);
+         break;
+         }
+      }
+
+   return pack->_vector;
+   }
+
+/**
+ * Walks the scalar trees of the group and anchors every node that is
+ * referenced from outside of the group and that the vector tree does not
+ * evaluate. Without an \p insertionPoint, records the nodes under \p node
+ * as \p evaluated instead.
+ */
+void
+TR_SLPVectorizer::anchorExternalReferences(Group &group, TR::Node *node, TR::NodeChecklist &evaluated, TR::NodeChecklist &visited, TR::TreeTop *insertionPoint)
+   {
+   for (int32_t i = 0; i < node->getNumChildren(); ++i)
+      {
+      TR::Node *child = node->getChild(i);
+      if (visited.contains(child))
+         continue;
+      visited.add(child);
+
+      if (!insertionPoint)
+         {
+         evaluated.add(child);
+         anchorExternalReferences(group, child, evaluated, visited, insertionPoint);
+         continue;
+         }
+
+      if (evaluated.contains(child))
+         continue;
+
+      if (!isOnlyReferencedInGroup(group, child))
+         {
+         if (trace())
+            traceMsg(comp(), "Anchoring n%dn, it is referenced after the group\n", child->getGlobalIndex());
+         insertionPoint->insertBefore(TR::TreeTop::create(comp(), TR::Node::create(TR::treetop, 1, child)));
+         continue;
+         }
+
+      anchorExternalReferences(group, child, evaluated, visited, insertionPoint);
+      }
+   }
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SLPVECTORIZER_INCL
+#define SLPVECTORIZER_INCL
+
+#include <stdint.h>
+#include <map>
+#include "env/TRMemory.hpp"
+#include "il/DataTypes.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+namespace TR { class Node; }
+namespace TR { class NodeChecklist; }
+namespace TR { class TreeTop; }
+
+/*
+ * Class TR_SLPVectorizer
+ * ======================
+ *
+ * Superword level parallelism packs groups of isomorphic scalar trees that
+ * operate on adjacent memory into the 128-bit vector IL opcodes. Straight
+ * line code such as
+ *
+ *    c[0] = a[0] + b[0] * k;
+ *    c[1] = a[1] + b[1] * k;
+ *    c[2] = a[2] + b[2] * k;
+ *    c[3] = a[3] + b[3] * k;
+ *
+ * which typically comes out of an unrolled loop, becomes
+ *
+ *    vstorei c[0] (vadd (vloadi a[0]) (vmul (vloadi b[0]) (vsplats k)))
+ *
+ * A group is formed by VL consecutive indirect stores of one element type
+ * whose addresses are base + index * scale + offset with the same base and
+ * index and offsets one element apart in tree order. The stored values are
+ * then packed lane by lane: loads of adjacent elements become a vector load,
+ * the same operation in every lane becomes the vector operation and a value
+ * common to all lanes is splatted. Every packed node must only be referenced
+ * from within the group.
+ *
+ * Packing moves all of the loads in front of all of the stores of the group,
+ * so a load that may alias one of the stores is only allowed when it is off
+ * the same base and index and either reads the exact elements being stored
+ * or does not overlap them at all.
+ *
+ * The cost model counts one unit per scalar load, operation and store that
+ * disappears and one unit per vector node created (including splats); the
+ * group is only packed when the vector form is strictly cheaper.
+ */
+class TR_SLPVectorizer : public TR::Optimization
+   {
+   public:
+   TR_SLPVectorizer(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_SLPVectorizer(manager);
+      }
+
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   struct Address
+      {
+      TR::Node *_base;
+      TR::Node *_index;    // NULL for a constant address offset
+      int64_t   _scale;
+      int64_t   _offset;   // byte offset, including the symbol reference offset
+      };
+
+   enum PackKind
+      {
+      SplatPack,
+      LoadPack,
+      OperationPack
+      };
+
+   struct Pack
+      {
+      PackKind   _kind;
+      TR::Node **_lanes;
+      Address    _address;  // of lane 0, for load packs
+      TR::Node  *_vector;
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, int32_t>, TR::Region&> ReferenceCountMapAlloc;
+   typedef std::map<TR::Node *, int32_t, std::less<TR::Node *>, ReferenceCountMapAlloc> ReferenceCountMap;
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, Pack *>, TR::Region&> PackMapAlloc;
+   typedef std::map<TR::Node *, Pack *, std::less<TR::Node *>, PackMapAlloc> PackMap;
+
+   struct Group
+      {
+      Group(TR::Region &region, TR::DataType type, int32_t lanes)
+         : _region(region), _type(type), _lanes(lanes),
+           _groupReferences(std::less<TR::Node *>(), region), _packs(std::less<TR::Node *>(), region),
+           _loadPacks(region), _scalarCost(0), _vectorCost(0)
+         {}
+
+      TR::Region          &_region;
+      TR::DataType         _type;
+      int32_t              _lanes;
+      ReferenceCountMap    _groupReferences;
+      PackMap              _packs;      // keyed by the lane 0 node
+      TR::vector<Pack *, TR::Region&> _loadPacks;
+      int32_t              _scalarCost;
+      int32_t              _vectorCost;
+      };
+
+   TR::TreeTop *packStores(TR::TreeTop *first, TR::Region &region);
+
+   void countGroupReferences(Group &group, TR::Node *node);
+   bool isOnlyReferencedInGroup(Group &group, TR::Node *node);
+   bool isSameValue(Group &group, TR::Node *first, TR::Node *second);
+   bool decomposeAddress(Group &group, TR::Node *memRef, Address &address);
+   bool decomposeIndex(TR::Node *index, TR::Node *&variable, int64_t &scale, int64_t &offset);
+   bool areAdjacent(Group &group, TR::Node **memRefs, Address &first);
+   bool analyzePack(Group &group, TR::Node **lanes);
+   bool analyzeDependences(Group &group, TR::Node **stores, Address &storeAddress);
+   bool supportsVectorOp(TR::ILOpCodes op, TR::DataType type);
+
+   TR::Node *buildVector(Group &group, TR::Node **lanes);
+   void anchorExternalReferences(Group &group, TR::Node *node, TR::NodeChecklist &evaluated, TR::NodeChecklist &visited, TR::TreeTop *insertionPoint);
+   };
+
+#endif
@@ -387,6 +387,12 @@ bool TR_UseDefInfo::performAnalysis(AuxiliaryData &aux)
    if (_numNonTrivialSymbols > 0)
       {
       bool succeeded = true;
+      if (TR_DataFlowAnalysis::useChunkedContainers(comp(), getNumExpandedDefNodes(), _cfg->getNextNodeNumber()))
+         {
+         TR_ChunkedReachingDefinitions rd(comp(), _cfg, optimizer(), this, aux, trace());
+         succeeded = _runReachingDefinitions(rd, aux);
+         }
+      else
          {
          TR_ReachingDefinitions rd(comp(), _cfg, optimizer(), this, aux, trace());
          succeeded = _runReachingDefinitions(rd, aux);
@@ -432,6 +438,43 @@ bool TR_UseDefInfo::_runReachingDefinitions(TR_ReachingDefinitions& reachingDefi
    return succeeded;
    }
 
+bool TR_UseDefInfo::_runReachingDefinitions(TR_ChunkedReachingDefinitions& reachingDefinitions,
+                                            AuxiliaryData &aux)
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*comp()->trMemory());
+
+   reachingDefinitions.perform();
+
+   bool succeeded = reachingDefinitions._blockAnalysisInfo != NULL;
+   if (!succeeded)
+      {
+      invalidateUseDefInfo();
+      if (trace())
+         traceMsg(comp(), "Method too complex to perform reaching defs, use/def info not built\n");
+      }
+   else
+      {
+      // Use def info is built from dense sets, so expand the chunked solution
+      // for each block
+      //
+      int32_t numberOfNodes = _cfg->getNextNodeNumber();
+      TR::Region &stackRegion = comp()->trMemory()->currentStackRegion();
+      TR_BitVector **blockInfo = (TR_BitVector **)stackRegion.allocate(numberOfNodes * sizeof(TR_BitVector *));
+      for (int32_t i = 0; i < numberOfNodes; i++)
+         {
+         TR_ChunkedBitVector *chunked = reachingDefinitions._blockAnalysisInfo[i];
+         blockInfo[i] = new (stackRegion) TR_BitVector(getNumExpandedDefNodes(), stackRegion);
+         if (chunked)
+            *blockInfo[i] = *chunked;
+         }
+
+      LexicalTimer tlex2("useDefInfo_buildUseDefs", comp()->phaseTimer());
+      processReachingDefinition(blockInfo, aux);
+      }
+
+   return succeeded;
+   }
+
 void TR_UseDefInfo::setVolatileSymbolsIndexAndRecurse(TR::BitVector &volatileSymbols, int32_t symRefNum)
    {
    TR::SymbolReference* symRef = comp()->getSymRefTab()->getSymRef(symRefNum);
@@ -27,6 +27,7 @@
 #include "compile/Compilation.hpp"
 #include "cs2/bitvectr.h"
 #include "cs2/sparsrbit.h"
+#include "env/RecyclingRegion.hpp"
 #include "env/TRMemory.hpp"
 #include "il/Node.hpp"
 #include "il/Symbol.hpp"
@@ -36,6 +37,7 @@
 #include "infra/vector.hpp"
 #include "infra/TRlist.hpp"
 
+class TR_ChunkedReachingDefinitions;
 class TR_ReachingDefinitions;
 class TR_ValueNumberInfo;
 namespace TR { class Block; }
@@ -62,7 +64,7 @@ namespace OMR { class Optimizer; }
  */
 class TR_UseDefInfo
    {
-   TR::Region _region;
+   TR::RecyclingRegion _region;
    public:
 
    static void *operator new(size_t size, TR::Allocator a)
@@ -116,7 +118,7 @@ class TR_UseDefInfo
              _doneTrivialNode(_region),
              _isTrivialNode(_region)
             {}
-      TR::Region _region;
+      TR::RecyclingRegion _region;
 
       // BitVector for temporary work. Used in buildUseDefs.
       TR_BitVector _workBitVector;
@@ -185,6 +187,7 @@ class TR_UseDefInfo
    virtual void processReachingDefinition(void* vblockInfo, AuxiliaryData &aux);
    private:
    bool _runReachingDefinitions(TR_ReachingDefinitions &reachingDefinitions, AuxiliaryData &aux);
+   bool _runReachingDefinitions(TR_ChunkedReachingDefinitions &reachingDefinitions, AuxiliaryData &aux);
 
    protected:
    TR::Compilation *comp() { return _compilation; }
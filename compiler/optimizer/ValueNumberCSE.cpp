@@ -0,0 +1,504 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "optimizer/ValueNumberCSE.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Cfg.hpp"
+#include "optimizer/Dominators.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/ValueNumberInfo.hpp"
+#include "ras/Debug.hpp"
+
+#define OPT_DETAILS "O^O VALUE NUMBER CSE: "
+
+// Largest expression, in nodes, that is compared against the available one
+#define MAX_EXPRESSION_SIZE 32
+
+TR_ValueNumberCSE::TR_ValueNumberCSE(TR::OptimizationManager *manager)
+   : TR::Optimization(manager),
+     _valueNumberInfo(NULL),
+     _visitCount(0),
+     _clock(0),
+     _barrier(0),
+     _loadTimes(NULL),
+     _storeTimes(NULL),
+     _available(NULL),
+     _storeTimesLog(NULL),
+     _availableLog(NULL),
+     _region(NULL),
+     _transformed(false)
+   {}
+
+int32_t
+TR_ValueNumberCSE::perform()
+   {
+   _valueNumberInfo = optimizer()->getValueNumberInfo();
+   if (!_valueNumberInfo)
+      {
+      if (trace())
+         traceMsg(comp(), "Value number info is not available\n");
+      return 0;
+      }
+
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+   _region = &stackMemoryRegion;
+   _clock = 0;
+   _barrier = 0;
+   _transformed = false;
+
+   TR::vector<int32_t, TR::Region&> loadTimes(_valueNumberInfo->getNumberOfNodes(), -1, stackMemoryRegion);
+   TR::vector<int32_t, TR::Region&> storeTimes(comp()->getSymRefTab()->getNumSymRefs(), -1, stackMemoryRegion);
+   TR::vector<AvailableExpression *, TR::Region&> available(_valueNumberInfo->getNumberOfValues(), NULL, stackMemoryRegion);
+   TR::vector<std::pair<int32_t, int32_t>, TR::Region&> storeTimesLog(stackMemoryRegion);
+   TR::vector<std::pair<int32_t, AvailableExpression *>, TR::Region&> availableLog(stackMemoryRegion);
+   _loadTimes = &loadTimes;
+   _storeTimes = &storeTimes;
+   _available = &available;
+   _storeTimesLog = &storeTimesLog;
+   _availableLog = &availableLog;
+
+   findCandidateSymbols(stackMemoryRegion);
+
+   // Build the dominator tree as lists of children
+   //
+   TR::CFG *cfg = comp()->getFlowGraph();
+   TR_Dominators dominators(comp());
+   TR::vector<TR::Block *, TR::Region&> firstChild(cfg->getNextNodeNumber(), NULL, stackMemoryRegion);
+   TR::vector<TR::Block *, TR::Region&> nextSibling(cfg->getNextNodeNumber(), NULL, stackMemoryRegion);
+   for (TR::CFGNode *node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      TR::Block *dominator = dominators.getDominator(block);
+      if (!dominator || dominator == block)
+         continue;
+      nextSibling[block->getNumber()] = firstChild[dominator->getNumber()];
+      firstChild[dominator->getNumber()] = block;
+      }
+
+   // Walk the dominator tree in preorder, undoing the effects of a subtree
+   // on the way back up
+   //
+   _visitCount = comp()->incVisitCount();
+   TR::vector<Scope, TR::Region&> scopes(stackMemoryRegion);
+   TR::Block *start = toBlock(cfg->getStart());
+   Scope startScope = { start, firstChild[start->getNumber()], _barrier, 0, 0 };
+   scopes.push_back(startScope);
+   while (!scopes.empty())
+      {
+      Scope &scope = scopes.back();
+      TR::Block *child = scope._nextChild;
+      if (!child)
+         {
+         while (storeTimesLog.size() > scope._storeTimesMark)
+            {
+            storeTimes[storeTimesLog.back().first] = storeTimesLog.back().second;
+            storeTimesLog.pop_back();
+            }
+         while (availableLog.size() > scope._availableMark)
+            {
+            available[availableLog.back().first] = availableLog.back().second;
+            availableLog.pop_back();
+            }
+         _barrier = scope._barrier;
+         scopes.pop_back();
+         continue;
+         }
+
+      scope._nextChild = nextSibling[child->getNumber()];
+      Scope childScope = { child, firstChild[child->getNumber()], _barrier, storeTimesLog.size(), availableLog.size() };
+      scopes.push_back(childScope);
+
+      // The state at the end of the dominator only carries over to a block
+      // entered directly from it
+      //
+      if (child->getPredecessors().size() != 1 || !child->getExceptionPredecessors().empty())
+         _barrier = ++_clock;
+
+      processBlock(child);
+      }
+
+   if (_transformed)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      }
+
+   _region = NULL;
+   return 1;
+   }
+
+const char *
+TR_ValueNumberCSE::optDetailString() const throw()
+   {
+   return "O^O VALUE NUMBER CSE: ";
+   }
+
+void
+TR_ValueNumberCSE::findCandidateSymbols(TR::Region &region)
+   {
+   typedef TR::typed_allocator<std::pair<TR::Symbol * const, TR::SymbolReference *>, TR::Region&> SymbolMapAlloc;
+   typedef std::map<TR::Symbol *, TR::SymbolReference *, std::less<TR::Symbol *>, SymbolMapAlloc> SymbolMap;
+
+   // A symbol is a candidate if it is only ever accessed directly through
+   // a single symbol reference. Symbols whose address is taken are mapped
+   // to NULL.
+   //
+   SymbolMap symbols(std::less<TR::Symbol *>(), region);
+   TR::vector<TR::Node *, TR::Region&> stack(region);
+   vcount_t visitCount = comp()->incVisitCount();
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      stack.push_back(tt->getNode());
+      while (!stack.empty())
+         {
+         TR::Node *node = stack.back();
+         stack.pop_back();
+         if (node->getVisitCount() == visitCount)
+            continue;
+         node->setVisitCount(visitCount);
+         for (int32_t i = 0; i < node->getNumChildren(); i++)
+            stack.push_back(node->getChild(i));
+
+         if (!node->getOpCode().hasSymbolReference())
+            continue;
+
+         TR::SymbolReference *symRef = node->getSymbolReference();
+         TR::Symbol *symbol = symRef->getSymbol();
+         if (!symbol->isAutoOrParm())
+            continue;
+
+         if (node->getOpCode().isLoadVarDirect() || node->getOpCode().isStoreDirect())
+            {
+            SymbolMap::iterator entry = symbols.find(symbol);
+            if (entry == symbols.end())
+               symbols.insert(std::make_pair(symbol, symRef));
+            else if (entry->second != symRef)
+               entry->second = NULL;
+            }
+         else
+            {
+            symbols[symbol] = NULL;
+            }
+         }
+      }
+
+   for (SymbolMap::iterator entry = symbols.begin(); entry != symbols.end(); ++entry)
+      {
+      TR::SymbolReference *symRef = entry->second;
+      if (!symRef)
+         continue;
+      TR::DataType type = symRef->getSymbol()->getDataType();
+      if (type.isIntegral() || type.isFloatingPoint())
+         (*_storeTimes)[symRef->getReferenceNumber()] = 0;
+      }
+   }
+
+void
+TR_ValueNumberCSE::processBlock(TR::Block *block)
+   {
+   if (!block->getEntry())
+      return;
+
+   for (TR::TreeTop *tt = block->getEntry()->getNextTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      processNode(node, tt);
+
+      if (node->getOpCode().isStoreDirect() && isCandidateSymbol(node->getSymbolReference()))
+         {
+         int32_t symRefNumber = node->getSymbolReference()->getReferenceNumber();
+         _storeTimesLog->push_back(std::make_pair(symRefNumber, (*_storeTimes)[symRefNumber]));
+         (*_storeTimes)[symRefNumber] = ++_clock;
+         }
+      }
+   }
+
+void
+TR_ValueNumberCSE::processNode(TR::Node *node, TR::TreeTop *treeTop)
+   {
+   if (node->getVisitCount() == _visitCount)
+      return;
+
+   if (isCandidateOperation(node) && replaceRedundantExpression(node, treeTop))
+      return;
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      processNode(node->getChild(i), treeTop);
+
+   node->setVisitCount(_visitCount);
+   setTime(node);
+
+   int32_t budget = MAX_EXPRESSION_SIZE;
+   if (isCandidateOperation(node) && isWorthCommoning(node) && isUnchanged(node, budget))
+      makeAvailable(node, treeTop);
+   }
+
+void
+TR_ValueNumberCSE::markEvaluated(TR::Node *node)
+   {
+   if (node->getVisitCount() == _visitCount)
+      return;
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      markEvaluated(node->getChild(i));
+   node->setVisitCount(_visitCount);
+   setTime(node);
+   }
+
+void
+TR_ValueNumberCSE::setTime(TR::Node *node)
+   {
+   if (isCandidateLoad(node) && node->getGlobalIndex() < _valueNumberInfo->getNumberOfNodes())
+      (*_loadTimes)[node->getGlobalIndex()] = _clock;
+   }
+
+void
+TR_ValueNumberCSE::makeAvailable(TR::Node *node, TR::TreeTop *treeTop)
+   {
+   if (node->getGlobalIndex() >= _valueNumberInfo->getNumberOfNodes())
+      return;
+   int32_t valueNumber = _valueNumberInfo->getValueNumber(node);
+   if (valueNumber < 0 || valueNumber >= _valueNumberInfo->getNumberOfValues())
+      return;
+
+   // Keep an older expression that is still available: it dominates this one
+   //
+   AvailableExpression *previous = (*_available)[valueNumber];
+   int32_t budget = MAX_EXPRESSION_SIZE;
+   if (previous && isUnchanged(previous->_node, budget))
+      return;
+
+   AvailableExpression *expression = new (*_region) AvailableExpression;
+   expression->_node = node;
+   expression->_treeTop = treeTop;
+   expression->_temp = NULL;
+   _availableLog->push_back(std::make_pair(valueNumber, previous));
+   (*_available)[valueNumber] = expression;
+   }
+
+bool
+TR_ValueNumberCSE::replaceRedundantExpression(TR::Node *node, TR::TreeTop *treeTop)
+   {
+   if (node->getGlobalIndex() >= _valueNumberInfo->getNumberOfNodes())
+      return false;
+   int32_t valueNumber = _valueNumberInfo->getValueNumber(node);
+   if (valueNumber < 0 || valueNumber >= _valueNumberInfo->getNumberOfValues())
+      return false;
+
+   // An expression in the same tree would be loaded from the temporary
+   // before it is stored; local CSE takes care of those
+   //
+   AvailableExpression *expression = (*_available)[valueNumber];
+   if (!expression || expression->_treeTop == treeTop)
+      return false;
+
+   int32_t budget = MAX_EXPRESSION_SIZE;
+   int32_t availableBudget = MAX_EXPRESSION_SIZE;
+   if (!isUnchanged(node, budget) ||
+       !isUnchanged(expression->_node, availableBudget) ||
+       !isSameExpression(expression->_node, node))
+      return false;
+
+   if (!performTransformation(comp(), "%sReplacing n%dn with the value of n%dn\n", OPT_DETAILS,
+         node->getGlobalIndex(), expression->_node->getGlobalIndex()))
+      return false;
+
+   if (!expression->_temp)
+      {
+      TR::Node *available = expression->_node;
+      expression->_temp = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), available->getDataType());
+      TR::TreeTop *storeTree = TR::TreeTop::create(comp(), TR::Node::createStore(expression->_temp, available));
+
+      // The store can only follow the tree if control does too
+      //
+      TR::Node *availableTree = expression->_treeTop->getNode();
+      if (availableTree->getOpCodeValue() == TR::treetop || availableTree->getOpCode().isCheck())
+         availableTree = availableTree->getFirstChild();
+      TR::ILOpCode &op = availableTree->getOpCode();
+      if (op.isBranch() || op.isJumpWithMultipleTargets() || op.isReturn() || op.getOpCodeValue() == TR::athrow)
+         expression->_treeTop->insertBefore(storeTree);
+      else
+         expression->_treeTop->insertAfter(storeTree);
+
+      if (trace())
+         traceMsg(comp(), "Storing n%dn into temp #%d\n", available->getGlobalIndex(), expression->_temp->getReferenceNumber());
+      }
+
+   anchorChildren(node, treeTop);
+   node->removeAllChildren();
+   TR::Node::recreateWithSymRef(node, comp()->il.opCodeForDirectLoad(node->getDataType()), expression->_temp);
+   node->setVisitCount(_visitCount);
+   _transformed = true;
+   return true;
+   }
+
+void
+TR_ValueNumberCSE::anchorChildren(TR::Node *node, TR::TreeTop *treeTop)
+   {
+   // Children that are first evaluated here and referenced again later must
+   // still be evaluated here
+   //
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      TR::Node *child = node->getChild(i);
+      if (child->getVisitCount() == _visitCount)
+         continue;
+
+      if (child->getReferenceCount() > 1)
+         {
+         treeTop->insertBefore(TR::TreeTop::create(comp(), TR::Node::create(TR::treetop, 1, child)));
+         markEvaluated(child);
+         }
+      else
+         {
+         anchorChildren(child, treeTop);
+         }
+      }
+   }
+
+bool
+TR_ValueNumberCSE::isCandidateSymbol(TR::SymbolReference *symRef)
+   {
+   size_t symRefNumber = symRef->getReferenceNumber();
+   return symRefNumber < _storeTimes->size() && (*_storeTimes)[symRefNumber] >= 0;
+   }
+
+bool
+TR_ValueNumberCSE::isCandidateLoad(TR::Node *node)
+   {
+   return node->getOpCode().isLoadVarDirect() && isCandidateSymbol(node->getSymbolReference());
+   }
+
+bool
+TR_ValueNumberCSE::isCandidateOperation(TR::Node *node)
+   {
+   TR::ILOpCode &op = node->getOpCode();
+   if (node->getNumChildren() == 0 ||
+       op.hasSymbolReference() ||
+       op.isTreeTop() ||
+       op.isLoad() ||
+       op.isStore() ||
+       op.isBranch())
+      return false;
+
+   TR::DataType type = node->getDataType();
+   if (!type.isIntegral() && !type.isFloatingPoint())
+      return false;
+
+   return op.isAdd() || op.isSub() || op.isMul() || op.isNeg() || op.isAbs() ||
+          op.isAnd() || op.isOr() || op.isXor() || op.isShift() || op.isRotate() ||
+          op.isConversion() || op.isBooleanCompare();
+   }
+
+bool
+TR_ValueNumberCSE::isWorthCommoning(TR::Node *node)
+   {
+   if (node->getOpCode().isMul())
+      return true;
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (node->getChild(i)->getNumChildren() > 0)
+         return true;
+      }
+   return false;
+   }
+
+bool
+TR_ValueNumberCSE::isUnchanged(TR::Node *node, int32_t &budget)
+   {
+   if (--budget < 0)
+      return false;
+
+   if (node->getOpCode().isLoadConst())
+      {
+      TR::DataType type = node->getDataType();
+      return type.isIntegral() || type == TR::Float || type == TR::Double;
+      }
+
+   if (isCandidateLoad(node))
+      {
+      // A load that has not been evaluated yet will see the current value
+      //
+      if (node->getVisitCount() != _visitCount)
+         return true;
+      if (node->getGlobalIndex() >= _valueNumberInfo->getNumberOfNodes())
+         return false;
+      int32_t time = (*_loadTimes)[node->getGlobalIndex()];
+      return time >= _barrier && (*_storeTimes)[node->getSymbolReference()->getReferenceNumber()] <= time;
+      }
+
+   if (!isCandidateOperation(node))
+      return false;
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!isUnchanged(node->getChild(i), budget))
+         return false;
+      }
+   return true;
+   }
+
+bool
+TR_ValueNumberCSE::isSameExpression(TR::Node *node, TR::Node *other)
+   {
+   if (node == other)
+      return true;
+   if (node->getOpCodeValue() != other->getOpCodeValue() ||
+       node->getNumChildren() != other->getNumChildren())
+      return false;
+
+   if (node->getOpCode().isLoadConst())
+      {
+      if (node->getDataType() == TR::Float)
+         return node->getFloatBits() == other->getFloatBits();
+      if (node->getDataType() == TR::Double)
+         return node->getDoubleBits() == other->getDoubleBits();
+      return node->get64bitIntegralValue() == other->get64bitIntegralValue();
+      }
+
+   if (node->getOpCode().hasSymbolReference())
+      return node->getSymbolReference() == other->getSymbolReference();
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!isSameExpression(node->getChild(i), other->getChild(i)))
+         return false;
+      }
+   return true;
+   }
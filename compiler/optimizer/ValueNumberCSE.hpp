@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef VALUENUMBERCSE_INCL
+#define VALUENUMBERCSE_INCL
+
+#include <stdint.h>
+#include <utility>
+#include "env/TRMemory.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_ValueNumberInfo;
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/*
+ * Class TR_ValueNumberCSE
+ * =======================
+ *
+ * Global common subexpression elimination over the dominator tree. It is a
+ * cheap alternative to partial redundancy elimination for methods where
+ * building PRE's bit vector analyses is too expensive: only fully redundant
+ * expressions are removed, in a single walk of the trees.
+ *
+ * Expressions are hashed by the value numbers of TR_ValueNumberInfo, so two
+ * expressions that compute the same operations on the same values share a
+ * table slot no matter which block they are in. The table is scoped to the
+ * dominator tree: an expression recorded in a block is visible in the blocks
+ * it dominates and is forgotten when the walk leaves its subtree.
+ *
+ * Candidates are arithmetic, logical, shift, conversion and compare trees
+ * whose leaves are constants or loads of autos and parms that never have
+ * their address taken. Value numbers only say that two such trees are built
+ * from the same definitions, not that no definition was executed between
+ * them, so a table hit is only used when
+ *
+ *    - the two trees are structurally identical,
+ *    - no store to any symbol loaded by the available tree has been seen
+ *      since that symbol was loaded, and
+ *    - no join point (a block with several predecessors or an exception
+ *      predecessor) lies on the dominator tree path between them.
+ *
+ * The dominated occurrence is then replaced by a load of a temporary that is
+ * stored right after the treetop that evaluated the available occurrence.
+ * Expressions are only commoned if they contain a multiply or at least two
+ * operations, since a store and a load of the temporary cost about as much
+ * as a single cheap operation.
+ */
+class TR_ValueNumberCSE : public TR::Optimization
+   {
+   public:
+   TR_ValueNumberCSE(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_ValueNumberCSE(manager);
+      }
+
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   struct AvailableExpression
+      {
+      TR::Node            *_node;
+      TR::TreeTop         *_treeTop;   // the treetop that evaluates _node
+      TR::SymbolReference *_temp;      // created on the first redundant occurrence
+      };
+
+   // A block on the dominator tree path being walked, with the state to
+   // restore when the walk leaves its subtree
+   struct Scope
+      {
+      TR::Block *_block;
+      TR::Block *_nextChild;
+      int32_t    _barrier;
+      size_t     _storeTimesMark;
+      size_t     _availableMark;
+      };
+
+   void findCandidateSymbols(TR::Region &region);
+   void processBlock(TR::Block *block);
+   void processNode(TR::Node *node, TR::TreeTop *treeTop);
+   void markEvaluated(TR::Node *node);
+   void setTime(TR::Node *node);
+   bool replaceRedundantExpression(TR::Node *node, TR::TreeTop *treeTop);
+   void anchorChildren(TR::Node *node, TR::TreeTop *treeTop);
+   void makeAvailable(TR::Node *node, TR::TreeTop *treeTop);
+
+   bool isCandidateSymbol(TR::SymbolReference *symRef);
+   bool isCandidateLoad(TR::Node *node);
+   bool isCandidateOperation(TR::Node *node);
+   bool isWorthCommoning(TR::Node *node);
+   bool isUnchanged(TR::Node *node, int32_t &budget);
+   bool isSameExpression(TR::Node *node, TR::Node *other);
+
+   TR_ValueNumberInfo *_valueNumberInfo;
+   vcount_t            _visitCount;
+
+   // Logical clock that advances on every store to a candidate symbol and
+   // at every join point. A load "happens" at the current time.
+   int32_t             _clock;
+   int32_t             _barrier;        // time of the most recent join point on the dominator path
+
+   TR::vector<int32_t, TR::Region&> *_loadTimes;        // by global index, for loads of candidate symbols
+   TR::vector<int32_t, TR::Region&> *_storeTimes;       // by symbol reference number; -1 if not a candidate
+   TR::vector<AvailableExpression *, TR::Region&> *_available;   // by value number
+
+   // Undo logs restoring _storeTimes and _available when the walk leaves a
+   // subtree of the dominator tree
+   TR::vector<std::pair<int32_t, int32_t>, TR::Region&> *_storeTimesLog;
+   TR::vector<std::pair<int32_t, AvailableExpression *>, TR::Region&> *_availableLog;
+
+   TR::Region         *_region;
+   bool                _transformed;
+   };
+
+#endif
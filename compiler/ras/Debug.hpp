@@ -59,6 +59,7 @@
 class TR_Debug;
 class TR_BlockStructure;
 class TR_CHTable;
+class TR_ChunkedBitVector;
 namespace TR { class CompilationFilters; }
 class TR_FilterBST;
 class TR_FrontEnd;
@@ -521,6 +522,7 @@ public:
    virtual void         print(TR::LabelSymbol *, TR_PrettyPrinterString&);
    virtual void         print(TR::FILE *, TR_BitVector *);
    virtual void         print(TR::FILE *, TR_SingleBitContainer *);
+   virtual void         print(TR::FILE *, TR_ChunkedBitVector *);
    virtual void         print(TR::FILE *pOutFile, TR::BitVector * bv);
    virtual void         print(TR::FILE *pOutFile, TR::SparseBitVector * sparse);
    virtual void         print(TR::FILE *, TR::SymbolReferenceTable *);
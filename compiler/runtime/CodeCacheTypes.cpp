@@ -21,6 +21,8 @@
 
 #include "runtime/CodeCacheTypes.hpp"
 #include "runtime/CodeCacheManager.hpp"
+#include "infra/Assert.hpp"
+#include "infra/Bit.hpp"
 
 namespace OMR
 {
@@ -185,4 +187,240 @@ CodeCacheHashTable::remove(CodeCacheHashEntry *entry)
    return false;
    }
 
+
+
+void
+CodeCacheFreeBlockIndex::initialize()
+   {
+   _root = NULL;
+   for (int32_t kind = 0; kind < 2; kind++)
+      {
+      for (int32_t bin = 0; bin < NumBins; bin++)
+         _bins[kind][bin] = NULL;
+      for (int32_t word = 0; word < NumBins / BitsPerWord; word++)
+         _nonEmptyBins[kind][word] = 0;
+      _numBlocks[kind] = 0;
+      _freeBytes[kind] = 0;
+      }
+   }
+
+
+// Size classes are four per power of two: the bin is formed by the position
+// of the most significant bit and the two bits below it
+//
+int32_t
+CodeCacheFreeBlockIndex::binIndex(size_t size)
+   {
+   if (size < ((size_t)1 << Log2BinsPerPowerOfTwo))
+      return 0;
+
+   int32_t log2Size = 63 - leadingZeroes((uint64_t)size);
+   int32_t subBin = (int32_t)(size >> (log2Size - Log2BinsPerPowerOfTwo)) & ((1 << Log2BinsPerPowerOfTwo) - 1);
+   int32_t bin = (log2Size << Log2BinsPerPowerOfTwo) + subBin;
+   return bin < NumBins ? bin : NumBins - 1;
+   }
+
+
+// Treap priority; a hash of the address keeps the tree balanced in
+// expectation without storing a random number in every block
+//
+uint32_t
+CodeCacheFreeBlockIndex::priority(CodeCacheFreeCacheBlock *block)
+   {
+   return (uint32_t)((uintptr_t)block >> 4) * 2654435761u;
+   }
+
+
+int32_t
+CodeCacheFreeBlockIndex::findNonEmptyBin(int32_t first, bool isCold)
+   {
+   for (int32_t word = first / BitsPerWord; word < NumBins / BitsPerWord; word++)
+      {
+      uint64_t bits = _nonEmptyBins[isCold][word];
+      if (word == first / BitsPerWord)
+         bits &= ~(uint64_t)0 << (first % BitsPerWord);
+      if (bits)
+         return word * BitsPerWord + trailingZeroes(bits);
+      }
+   return -1;
+   }
+
+
+void
+CodeCacheFreeBlockIndex::addToBin(CodeCacheFreeCacheBlock *block, bool isCold)
+   {
+   int32_t bin = binIndex(block->_size);
+   block->_prevInBin = NULL;
+   block->_nextInBin = _bins[isCold][bin];
+   if (block->_nextInBin)
+      block->_nextInBin->_prevInBin = block;
+   _bins[isCold][bin] = block;
+   _nonEmptyBins[isCold][bin / BitsPerWord] |= (uint64_t)1 << (bin % BitsPerWord);
+   _freeBytes[isCold] += block->_size;
+   }
+
+
+void
+CodeCacheFreeBlockIndex::removeFromBin(CodeCacheFreeCacheBlock *block, bool isCold)
+   {
+   int32_t bin = binIndex(block->_size);
+   if (block->_prevInBin)
+      block->_prevInBin->_nextInBin = block->_nextInBin;
+   else
+      _bins[isCold][bin] = block->_nextInBin;
+   if (block->_nextInBin)
+      block->_nextInBin->_prevInBin = block->_prevInBin;
+   if (!_bins[isCold][bin])
+      _nonEmptyBins[isCold][bin / BitsPerWord] &= ~((uint64_t)1 << (bin % BitsPerWord));
+   _freeBytes[isCold] -= block->_size;
+   }
+
+
+void
+CodeCacheFreeBlockIndex::add(CodeCacheFreeCacheBlock *block, bool isCold)
+   {
+   addToBin(block, isCold);
+   _numBlocks[isCold]++;
+
+   // Descend while the existing nodes have a higher priority, then split the
+   // remaining subtree around the new block
+   //
+   uint32_t blockPriority = priority(block);
+   CodeCacheFreeCacheBlock **link = &_root;
+   while (*link && priority(*link) >= blockPriority)
+      link = block < *link ? &(*link)->_left : &(*link)->_right;
+
+   CodeCacheFreeCacheBlock *subtree = *link;
+   CodeCacheFreeCacheBlock **lower = &block->_left;
+   CodeCacheFreeCacheBlock **higher = &block->_right;
+   while (subtree)
+      {
+      if (subtree < block)
+         {
+         *lower = subtree;
+         lower = &subtree->_right;
+         subtree = subtree->_right;
+         }
+      else
+         {
+         *higher = subtree;
+         higher = &subtree->_left;
+         subtree = subtree->_left;
+         }
+      }
+   *lower = NULL;
+   *higher = NULL;
+   *link = block;
+   }
+
+
+void
+CodeCacheFreeBlockIndex::remove(CodeCacheFreeCacheBlock *block, bool isCold)
+   {
+   removeFromBin(block, isCold);
+   _numBlocks[isCold]--;
+
+   CodeCacheFreeCacheBlock **link = &_root;
+   while (*link != block)
+      {
+      TR_ASSERT(*link, "free block %p is not in the address tree", block);
+      link = block < *link ? &(*link)->_left : &(*link)->_right;
+      }
+
+   // Replace the block by the merge of its subtrees
+   //
+   CodeCacheFreeCacheBlock *lower = block->_left;
+   CodeCacheFreeCacheBlock *higher = block->_right;
+   while (lower && higher)
+      {
+      if (priority(lower) >= priority(higher))
+         {
+         *link = lower;
+         link = &lower->_right;
+         lower = lower->_right;
+         }
+      else
+         {
+         *link = higher;
+         link = &higher->_left;
+         higher = higher->_left;
+         }
+      }
+   *link = lower ? lower : higher;
+   }
+
+
+void
+CodeCacheFreeBlockIndex::resize(CodeCacheFreeCacheBlock *block, size_t size, bool isCold)
+   {
+   removeFromBin(block, isCold);
+   block->_size = size;
+   addToBin(block, isCold);
+   }
+
+
+CodeCacheFreeCacheBlock *
+CodeCacheFreeBlockIndex::findPredecessor(void *address)
+   {
+   CodeCacheFreeCacheBlock *predecessor = NULL;
+   for (CodeCacheFreeCacheBlock *node = _root; node; )
+      {
+      if ((void *)node < address)
+         {
+         predecessor = node;
+         node = node->_right;
+         }
+      else
+         {
+         node = node->_left;
+         }
+      }
+   return predecessor;
+   }
+
+
+CodeCacheFreeCacheBlock *
+CodeCacheFreeBlockIndex::findFit(size_t size, bool isCold)
+   {
+   // The bin of the request may also hold blocks that are too small; take
+   // the best fit among those that are large enough
+   //
+   int32_t bin = binIndex(size);
+   CodeCacheFreeCacheBlock *bestFit = NULL;
+   for (CodeCacheFreeCacheBlock *block = _bins[isCold][bin]; block; block = block->_nextInBin)
+      {
+      if (block->_size >= size && (!bestFit || block->_size < bestFit->_size))
+         bestFit = block;
+      }
+   if (bestFit)
+      return bestFit;
+
+   // Every block of a higher bin is large enough
+   //
+   bin = findNonEmptyBin(bin + 1, isCold);
+   return bin >= 0 ? _bins[isCold][bin] : NULL;
+   }
+
+
+size_t
+CodeCacheFreeBlockIndex::largestBlockSize(bool isCold)
+   {
+   for (int32_t word = NumBins / BitsPerWord - 1; word >= 0; word--)
+      {
+      uint64_t bits = _nonEmptyBins[isCold][word];
+      if (!bits)
+         continue;
+
+      int32_t bin = word * BitsPerWord + 63 - leadingZeroes(bits);
+      size_t largest = 0;
+      for (CodeCacheFreeCacheBlock *block = _bins[isCold][bin]; block; block = block->_nextInBin)
+         {
+         if (block->_size > largest)
+            largest = block->_size;
+         }
+      return largest;
+      }
+   return 0;
+   }
+
 }
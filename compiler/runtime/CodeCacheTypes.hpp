@@ -160,11 +160,85 @@ CodeCacheMethodHeader *getCodeCacheMethodHeader(char *p, int searchLimit, Method
 struct CodeCacheFreeCacheBlock
    {
    size_t _size;
-   CodeCacheFreeCacheBlock *_next;
+   CodeCacheFreeCacheBlock *_next;        /*!< next free block in address order */
+   CodeCacheFreeCacheBlock *_left;        /*!< free blocks at lower addresses in the address tree */
+   CodeCacheFreeCacheBlock *_right;       /*!< free blocks at higher addresses in the address tree */
+   CodeCacheFreeCacheBlock *_nextInBin;   /*!< next free block of the same size class */
+   CodeCacheFreeCacheBlock *_prevInBin;   /*!< previous free block of the same size class */
    };
 #define MIN_SIZE_BLOCK (sizeof(CodeCacheFreeCacheBlock) > 96 ? sizeof(CodeCacheFreeCacheBlock) : 96)
 
 
+/**
+ * @brief Index over the free blocks of a code cache
+ *
+ * @details
+ *    Free blocks are kept in segregated size bins, separately for the warm
+ *    and the cold region, so that a block large enough for a request is
+ *    found without walking the whole free list. Each power of two is split
+ *    into four bins; a request is satisfied by the best fit within its own
+ *    bin or else by any block of the next non-empty bin, all of which are
+ *    large enough.
+ *
+ *    All free blocks are also kept in a treap ordered by address (with the
+ *    priority derived from the address) so that the neighbours of a block
+ *    being freed can be found for coalescing in logarithmic time.
+ *
+ *    The links are stored in the free blocks themselves; the index does not
+ *    allocate any memory.
+ */
+class CodeCacheFreeBlockIndex
+   {
+public:
+   void initialize();
+
+   void add(CodeCacheFreeCacheBlock *block, bool isCold);
+   void remove(CodeCacheFreeCacheBlock *block, bool isCold);
+
+   /**
+    * @brief Changes the size of a block without moving it
+    */
+   void resize(CodeCacheFreeCacheBlock *block, size_t size, bool isCold);
+
+   /**
+    * @brief Finds the free block with the highest address below the given one
+    *
+    * @return the block, or NULL if there is none
+    */
+   CodeCacheFreeCacheBlock *findPredecessor(void *address);
+
+   /**
+    * @brief Finds a free block of at least the given size in the warm or cold region
+    *
+    * @return the block, or NULL if there is none
+    */
+   CodeCacheFreeCacheBlock *findFit(size_t size, bool isCold);
+
+   size_t largestBlockSize(bool isCold);
+
+   uint32_t numBlocks(bool isCold) const { return _numBlocks[isCold]; }
+   size_t freeBytes(bool isCold) const { return _freeBytes[isCold]; }
+
+private:
+   static const int32_t Log2BinsPerPowerOfTwo = 2;
+   static const int32_t NumBins = 128;
+   static const int32_t BitsPerWord = 64;
+
+   static int32_t binIndex(size_t size);
+   static uint32_t priority(CodeCacheFreeCacheBlock *block);
+
+   int32_t findNonEmptyBin(int32_t first, bool isCold);
+   void addToBin(CodeCacheFreeCacheBlock *block, bool isCold);
+   void removeFromBin(CodeCacheFreeCacheBlock *block, bool isCold);
+
+   CodeCacheFreeCacheBlock *_root;
+   CodeCacheFreeCacheBlock *_bins[2][NumBins];
+   uint64_t                 _nonEmptyBins[2][NumBins / BitsPerWord];
+   uint32_t                 _numBlocks[2];
+   size_t                   _freeBytes[2];
+   };
+
+
 struct FaintCacheBlock
    {
    FaintCacheBlock *_next;
@@ -0,0 +1,542 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/JitDump.hpp"
+
+#if defined(LINUX)
+
+#include <elf.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+
+#define JITDUMP_MAGIC   0x4A695444 // "JiTD"
+#define JITDUMP_VERSION 1
+
+#define ROUND_UP(value, alignment) (((value) + (alignment) - 1) & ~((alignment) - 1))
+
+#if defined(TR_HOST_X86) && defined(TR_HOST_64BIT)
+#define JITDUMP_ELF_MACHINE EM_X86_64
+#elif defined(TR_HOST_X86)
+#define JITDUMP_ELF_MACHINE EM_386
+#elif defined(TR_HOST_ARM64)
+#define JITDUMP_ELF_MACHINE EM_AARCH64
+#elif defined(TR_HOST_ARM)
+#define JITDUMP_ELF_MACHINE EM_ARM
+#elif defined(TR_HOST_POWER) && defined(TR_HOST_64BIT)
+#define JITDUMP_ELF_MACHINE EM_PPC64
+#elif defined(TR_HOST_POWER)
+#define JITDUMP_ELF_MACHINE EM_PPC
+#elif defined(TR_HOST_S390)
+#define JITDUMP_ELF_MACHINE EM_S390
+#else
+#define JITDUMP_ELF_MACHINE EM_NONE
+#endif
+
+// DWARF call frame information is only produced where the register numbering
+// of the stack pointer and the location of the return address on entry are known
+//
+#if defined(TR_HOST_X86) && defined(TR_HOST_64BIT)
+#define JITDUMP_DWARF_SP 7
+#define JITDUMP_DWARF_RA 16
+#elif defined(TR_HOST_X86)
+#define JITDUMP_DWARF_SP 4
+#define JITDUMP_DWARF_RA 8
+#endif
+
+namespace
+{
+
+struct FileHeader
+   {
+   uint32_t _magic;
+   uint32_t _version;
+   uint32_t _totalSize;
+   uint32_t _elfMachine;
+   uint32_t _pad;
+   uint32_t _pid;
+   uint64_t _timestamp;
+   uint64_t _flags;
+   };
+
+struct RecordHeader
+   {
+   uint32_t _id;
+   uint32_t _totalSize;
+   uint64_t _timestamp;
+   };
+
+struct CodeLoad
+   {
+   uint32_t _pid;
+   uint32_t _tid;
+   uint64_t _vma;
+   uint64_t _codeAddress;
+   uint64_t _codeSize;
+   uint64_t _codeIndex;
+   };
+
+struct CodeMove
+   {
+   uint32_t _pid;
+   uint32_t _tid;
+   uint64_t _vma;
+   uint64_t _oldCodeAddress;
+   uint64_t _newCodeAddress;
+   uint64_t _codeSize;
+   uint64_t _codeIndex;
+   };
+
+struct DebugInfo
+   {
+   uint64_t _codeAddress;
+   uint64_t _numEntries;
+   };
+
+struct DebugInfoEntry
+   {
+   uint64_t _address;
+   int32_t  _line;
+   int32_t  _discriminator;
+   };
+
+struct UnwindingInfo
+   {
+   uint64_t _unwindingSize;
+   uint64_t _ehFrameHdrSize;
+   uint64_t _mappedSize;
+   };
+
+// Name of a debug entry that has the same file name as the previous entry
+//
+const char sameFileName[] = { '\xff', '\0' };
+
+/**
+ * Small growable byte buffer used to assemble the .eh_frame and
+ * .eh_frame_hdr sections of an unwinding record.
+ */
+class ByteBuffer
+   {
+public:
+   ByteBuffer(TR::RawAllocator &allocator, size_t capacity) :
+      _allocator(allocator),
+      _data(static_cast<uint8_t *>(allocator.allocate(capacity))),
+      _size(0),
+      _capacity(capacity)
+      {}
+
+   ~ByteBuffer() { _allocator.deallocate(_data); }
+
+   uint8_t *data() { return _data; }
+   size_t size() const { return _size; }
+
+   void u8(uint8_t value)
+      {
+      if (_size == _capacity)
+         {
+         uint8_t *data = static_cast<uint8_t *>(_allocator.allocate(_capacity * 2));
+         memcpy(data, _data, _size);
+         _allocator.deallocate(_data);
+         _data = data;
+         _capacity *= 2;
+         }
+      _data[_size++] = value;
+      }
+
+   void u16(uint16_t value) { u8(value & 0xff); u8(value >> 8); }
+   void u32(uint32_t value) { u16(value & 0xffff); u16(value >> 16); }
+
+   void uleb128(uint32_t value)
+      {
+      do
+         {
+         uint8_t byte = value & 0x7f;
+         value >>= 7;
+         u8(value ? (byte | 0x80) : byte);
+         }
+      while (value);
+      }
+
+   void sleb128(int32_t value)
+      {
+      bool more = true;
+      while (more)
+         {
+         uint8_t byte = value & 0x7f;
+         value >>= 7;
+         more = !((value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40)));
+         u8(more ? (byte | 0x80) : byte);
+         }
+      }
+
+   void patch32(size_t offset, uint32_t value)
+      {
+      _data[offset]     = value & 0xff;
+      _data[offset + 1] = (value >> 8) & 0xff;
+      _data[offset + 2] = (value >> 16) & 0xff;
+      _data[offset + 3] = (value >> 24) & 0xff;
+      }
+
+   /// Pads with DW_CFA_nop so that the entry starting at start ends aligned
+   void alignEntry(size_t start, size_t alignment)
+      {
+      while ((_size - start) % alignment)
+         u8(0);
+      }
+
+private:
+   TR::RawAllocator &_allocator;
+   uint8_t          *_data;
+   size_t            _size;
+   size_t            _capacity;
+   };
+
+}
+
+#define DW_CFA_advance_loc   0x40
+#define DW_CFA_offset        0x80
+#define DW_CFA_advance_loc1  0x02
+#define DW_CFA_advance_loc2  0x03
+#define DW_CFA_advance_loc4  0x04
+#define DW_CFA_def_cfa       0x0c
+#define DW_CFA_def_cfa_offset 0x0e
+
+#define DW_EH_PE_udata4      0x03
+#define DW_EH_PE_sdata4      0x0b
+#define DW_EH_PE_pcrel       0x10
+#define DW_EH_PE_datarel     0x30
+
+
+TR::JitDump::JitDump(TR::RawAllocator rawAllocator, FILE *file, TR::Monitor *monitor) :
+   _rawAllocator(rawAllocator),
+   _file(file),
+   _monitor(monitor),
+   _marker(MAP_FAILED),
+   _markerSize(0),
+   _codeIndex(0)
+   {
+   }
+
+
+TR::JitDump *
+TR::JitDump::create(TR::RawAllocator rawAllocator, const char *directory)
+   {
+   char fileName[256];
+   int length = snprintf(fileName, sizeof(fileName), "%s/jit-%d.dump", directory, getpid());
+   if (length <= 0 || length >= (int)sizeof(fileName))
+      return NULL;
+
+   FILE *file = fopen(fileName, "w+");
+   if (!file)
+      return NULL;
+
+   TR::Monitor *monitor = TR::Monitor::create("JIT-JitDumpMonitor");
+   if (!monitor)
+      {
+      fclose(file);
+      return NULL;
+      }
+
+   TR::JitDump *jitDump = new (rawAllocator) TR::JitDump(rawAllocator, file, monitor);
+   setvbuf(file, NULL, _IOFBF, BufferSize);
+   jitDump->writeFileHeader();
+   fflush(file);
+
+   // perf record only learns about the dump through this mapping, which
+   // must be executable for it to be reported
+   //
+   jitDump->_markerSize = sysconf(_SC_PAGESIZE);
+   jitDump->_marker = mmap(NULL, jitDump->_markerSize, PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(file), 0);
+
+   return jitDump;
+   }
+
+
+void
+TR::JitDump::close()
+   {
+   OMR::CriticalSection closingJitDump(_monitor);
+   if (!_file)
+      return;
+
+   writeRecordHeader(JIT_CODE_CLOSE, sizeof(RecordHeader));
+   fclose(_file);
+   _file = NULL;
+
+   if (_marker != MAP_FAILED)
+      munmap(_marker, _markerSize);
+   _marker = MAP_FAILED;
+   }
+
+
+uint64_t
+TR::JitDump::timestamp()
+   {
+   // perf record uses the monotonic clock for its samples (-k mono)
+   //
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+   }
+
+
+void
+TR::JitDump::writeFileHeader()
+   {
+   FileHeader header;
+   memset(&header, 0, sizeof(header));
+   header._magic = JITDUMP_MAGIC;
+   header._version = JITDUMP_VERSION;
+   header._totalSize = sizeof(header);
+   header._elfMachine = JITDUMP_ELF_MACHINE;
+   header._pid = getpid();
+   header._timestamp = timestamp();
+   header._flags = 0;
+   write(&header, sizeof(header));
+   }
+
+
+void
+TR::JitDump::writeRecordHeader(RecordType type, size_t size)
+   {
+   RecordHeader header;
+   header._id = type;
+   header._totalSize = (uint32_t)size;
+   header._timestamp = timestamp();
+   write(&header, sizeof(header));
+   }
+
+
+void
+TR::JitDump::writePadding(size_t size)
+   {
+   static const uint8_t zeros[8] = { 0 };
+   write(zeros, size);
+   }
+
+
+void
+TR::JitDump::writeCodeLoad(const char *name, const uint8_t *codeStart, size_t codeSize)
+   {
+   OMR::CriticalSection writingCodeLoad(_monitor);
+   if (!_file)
+      return;
+
+   size_t nameLength = strlen(name) + 1;
+   writeRecordHeader(JIT_CODE_LOAD, sizeof(RecordHeader) + sizeof(CodeLoad) + nameLength + codeSize);
+
+   CodeLoad load;
+   load._pid = getpid();
+   load._tid = (uint32_t)syscall(SYS_gettid);
+   load._vma = (uintptr_t)codeStart;
+   load._codeAddress = (uintptr_t)codeStart;
+   load._codeSize = codeSize;
+   load._codeIndex = _codeIndex++;
+   write(&load, sizeof(load));
+   write(name, nameLength);
+   write(codeStart, codeSize);
+   }
+
+
+void
+TR::JitDump::writeCodeMove(const uint8_t *oldCodeStart, const uint8_t *newCodeStart, size_t codeSize)
+   {
+   OMR::CriticalSection writingCodeMove(_monitor);
+   if (!_file)
+      return;
+
+   writeRecordHeader(JIT_CODE_MOVE, sizeof(RecordHeader) + sizeof(CodeMove));
+
+   CodeMove move;
+   move._pid = getpid();
+   move._tid = (uint32_t)syscall(SYS_gettid);
+   move._vma = (uintptr_t)newCodeStart;
+   move._oldCodeAddress = (uintptr_t)oldCodeStart;
+   move._newCodeAddress = (uintptr_t)newCodeStart;
+   move._codeSize = codeSize;
+   move._codeIndex = _codeIndex++;
+   write(&move, sizeof(move));
+   }
+
+
+void
+TR::JitDump::writeDebugInfo(const uint8_t *codeStart, const char *fileName, const DebugEntry *entries, size_t numEntries)
+   {
+   if (numEntries == 0)
+      return;
+
+   OMR::CriticalSection writingDebugInfo(_monitor);
+   if (!_file)
+      return;
+
+   // The file name is only spelled out for the first entry
+   //
+   size_t fileNameLength = strlen(fileName) + 1;
+   size_t size = sizeof(RecordHeader) + sizeof(DebugInfo) + numEntries * sizeof(DebugInfoEntry)
+      + fileNameLength + (numEntries - 1) * sizeof(sameFileName);
+   writeRecordHeader(JIT_CODE_DEBUG_INFO, size);
+
+   DebugInfo info;
+   info._codeAddress = (uintptr_t)codeStart;
+   info._numEntries = numEntries;
+   write(&info, sizeof(info));
+
+   for (size_t i = 0; i < numEntries; ++i)
+      {
+      DebugInfoEntry entry;
+      entry._address = entries[i]._address;
+      entry._line = entries[i]._line;
+      entry._discriminator = entries[i]._discriminator;
+      write(&entry, sizeof(entry));
+      if (i == 0)
+         write(fileName, fileNameLength);
+      else
+         write(sameFileName, sizeof(sameFileName));
+      }
+   }
+
+
+bool
+TR::JitDump::supportsUnwindingInfo()
+   {
+#if defined(JITDUMP_DWARF_SP)
+   return true;
+#else
+   return false;
+#endif
+   }
+
+
+void
+TR::JitDump::writeUnwindingInfo(size_t codeSize, const UnwindRow *rows, size_t numRows)
+   {
+#if defined(JITDUMP_DWARF_SP)
+   // The unwinding data is an .eh_frame section with a single CIE and FDE
+   // followed by an .eh_frame_hdr section indexing it. perf places the
+   // .eh_frame right after the code rounded up to 8 bytes, which is what
+   // the PC relative addresses below are computed against.
+   //
+   const int32_t pointerSize = sizeof(uintptr_t);
+   ByteBuffer ehFrame(_rawAllocator, 128 + numRows * 8);
+
+   // CIE
+   //
+   ehFrame.u32(0);                              // length, patched below
+   ehFrame.u32(0);                              // CIE id
+   ehFrame.u8(1);                               // version
+   ehFrame.u8('z'); ehFrame.u8('R'); ehFrame.u8(0);
+   ehFrame.uleb128(1);                          // code alignment factor
+   ehFrame.sleb128(-pointerSize);               // data alignment factor
+   ehFrame.uleb128(JITDUMP_DWARF_RA);
+   ehFrame.uleb128(1);                          // augmentation data length
+   ehFrame.u8(DW_EH_PE_pcrel | DW_EH_PE_sdata4);
+   ehFrame.u8(DW_CFA_def_cfa);                  // on entry CFA = sp + return address
+   ehFrame.uleb128(JITDUMP_DWARF_SP);
+   ehFrame.uleb128(pointerSize);
+   ehFrame.u8(DW_CFA_offset | JITDUMP_DWARF_RA); // return address at CFA - pointerSize
+   ehFrame.uleb128(1);
+   ehFrame.alignEntry(0, pointerSize);
+   ehFrame.patch32(0, (uint32_t)(ehFrame.size() - 4));
+
+   // FDE
+   //
+   const size_t fdeOffset = ehFrame.size();
+   ehFrame.u32(0);                              // length, patched below
+   ehFrame.u32((uint32_t)(fdeOffset + 4));      // offset back to the CIE
+   ehFrame.u32((uint32_t)-(int32_t)(ROUND_UP(codeSize, 8) + fdeOffset + 8)); // PC relative start of the code
+   ehFrame.u32((uint32_t)codeSize);
+   ehFrame.uleb128(0);                          // augmentation data length
+
+   uint32_t lastOffset = 0;
+   int32_t cfaOffset = pointerSize;
+   for (size_t i = 0; i < numRows; ++i)
+      {
+      if (rows[i]._cfaOffset == cfaOffset)
+         continue;
+
+      uint32_t delta = rows[i]._codeOffset - lastOffset;
+      if (delta < 0x40)
+         {
+         ehFrame.u8(DW_CFA_advance_loc | delta);
+         }
+      else if (delta <= 0xff)
+         {
+         ehFrame.u8(DW_CFA_advance_loc1);
+         ehFrame.u8(delta);
+         }
+      else if (delta <= 0xffff)
+         {
+         ehFrame.u8(DW_CFA_advance_loc2);
+         ehFrame.u16(delta);
+         }
+      else
+         {
+         ehFrame.u8(DW_CFA_advance_loc4);
+         ehFrame.u32(delta);
+         }
+
+      ehFrame.u8(DW_CFA_def_cfa_offset);
+      ehFrame.uleb128(rows[i]._cfaOffset);
+      lastOffset = rows[i]._codeOffset;
+      cfaOffset = rows[i]._cfaOffset;
+      }
+
+   ehFrame.alignEntry(fdeOffset, pointerSize);
+   ehFrame.patch32(fdeOffset, (uint32_t)(ehFrame.size() - fdeOffset - 4));
+
+   ehFrame.u32(0);                              // terminator
+   const int32_t ehFrameSize = (int32_t)ehFrame.size();
+
+   // .eh_frame_hdr with a one entry binary search table
+   //
+   ehFrame.u8(1);                               // version
+   ehFrame.u8(DW_EH_PE_pcrel | DW_EH_PE_sdata4);  // eh_frame_ptr encoding
+   ehFrame.u8(DW_EH_PE_udata4);                   // fde_count encoding
+   ehFrame.u8(DW_EH_PE_datarel | DW_EH_PE_sdata4); // table encoding
+   ehFrame.u32((uint32_t)-(ehFrameSize + 4));
+   ehFrame.u32(1);
+   ehFrame.u32((uint32_t)-(int32_t)(ROUND_UP(codeSize, 8) + ehFrameSize));
+   ehFrame.u32((uint32_t)-(int32_t)(ehFrameSize - fdeOffset));
+   const size_t ehFrameHdrSize = ehFrame.size() - ehFrameSize;
+
+   OMR::CriticalSection writingUnwindingInfo(_monitor);
+   if (!_file)
+      return;
+
+   size_t contentSize = sizeof(RecordHeader) + sizeof(UnwindingInfo) + ehFrame.size();
+   size_t padding = ROUND_UP(contentSize, 8) - contentSize;
+   writeRecordHeader(JIT_CODE_UNWINDING_INFO, contentSize + padding);
+
+   UnwindingInfo info;
+   info._unwindingSize = ehFrame.size();
+   info._ehFrameHdrSize = ehFrameHdrSize;
+   info._mappedSize = ehFrame.size();
+   write(&info, sizeof(info));
+   write(ehFrame.data(), ehFrame.size());
+   writePadding(padding);
+#endif
+   }
+
+#endif // defined(LINUX)
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITDUMP_HPP
+#define JITDUMP_HPP
+
+#if defined(LINUX)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "env/RawAllocator.hpp"
+
+namespace TR { class Monitor; }
+
+namespace TR {
+
+/**
+ * Writer for the jitdump format consumed by `perf inject --jit`.
+ *
+ * The file is named jit-<pid>.dump and is mapped executable once so that
+ * `perf record` sees it and `perf inject` can find it. Every method body is
+ * described by a JIT_CODE_LOAD record carrying a copy of its code, optionally
+ * preceded by JIT_CODE_DEBUG_INFO (instruction address to line mapping) and
+ * JIT_CODE_UNWINDING_INFO (DWARF call frame information) records for the same
+ * code. Code that is moved or that reuses the memory of reclaimed code is
+ * reported with JIT_CODE_MOVE or a new JIT_CODE_LOAD record respectively;
+ * perf orders all records by their timestamps.
+ *
+ * Records are buffered and only reach the file when the buffer fills up or
+ * the dump is closed, so a compilation only pays for copying its records.
+ */
+class JitDump
+   {
+public:
+
+   /**
+    * One row of the instruction address to line number table.
+    */
+   struct DebugEntry
+      {
+      uintptr_t _address;
+      int32_t   _line;
+      int32_t   _discriminator;
+      };
+
+   /**
+    * From _codeOffset until the next row, the canonical frame address (the
+    * stack pointer before the call to the method) is the stack pointer
+    * plus _cfaOffset.
+    */
+   struct UnwindRow
+      {
+      uint32_t _codeOffset;
+      int32_t  _cfaOffset;
+      };
+
+   /**
+    * Creates the dump file for the current process.
+    * @param[in] rawAllocator the TR::RawAllocator
+    * @param[in] directory the directory to write the dump file to
+    * @return the writer, or NULL if the dump file could not be created
+    */
+   static JitDump *create(TR::RawAllocator rawAllocator, const char *directory);
+
+   /**
+    * Writes out any buffered records, a JIT_CODE_CLOSE record and closes the file.
+    */
+   void close();
+
+   /**
+    * Describes newly generated code. Debug and unwinding information must
+    * be written before the code they describe.
+    * @param[in] name the symbol name for the code
+    * @param[in] codeStart the start of the code
+    * @param[in] codeSize the size of the code in bytes
+    */
+   void writeCodeLoad(const char *name, const uint8_t *codeStart, size_t codeSize);
+
+   /**
+    * Describes code that has been copied from oldCodeStart to newCodeStart.
+    */
+   void writeCodeMove(const uint8_t *oldCodeStart, const uint8_t *newCodeStart, size_t codeSize);
+
+   /**
+    * Describes the source lines of the instructions of the next code loaded
+    * at codeStart.
+    * @param[in] codeStart the start of the code
+    * @param[in] fileName the source file name shared by all of the entries
+    * @param[in] entries the rows, in increasing address order
+    * @param[in] numEntries the number of rows
+    */
+   void writeDebugInfo(const uint8_t *codeStart, const char *fileName, const DebugEntry *entries, size_t numEntries);
+
+   /**
+    * Describes how to unwind the stack from the next code loaded, as a list
+    * of CFA offsets from the stack pointer. Only written on hosts whose
+    * DWARF register numbering is known.
+    * @param[in] codeSize the size of the code in bytes
+    * @param[in] rows the rows, in increasing code offset order
+    * @param[in] numRows the number of rows
+    */
+   void writeUnwindingInfo(size_t codeSize, const UnwindRow *rows, size_t numRows);
+
+   /**
+    * Answers whether writeUnwindingInfo produces records on this host.
+    */
+   static bool supportsUnwindingInfo();
+
+private:
+
+   JitDump(TR::RawAllocator rawAllocator, FILE *file, TR::Monitor *monitor);
+
+   enum RecordType
+      {
+      JIT_CODE_LOAD           = 0,
+      JIT_CODE_MOVE           = 1,
+      JIT_CODE_DEBUG_INFO     = 2,
+      JIT_CODE_CLOSE          = 3,
+      JIT_CODE_UNWINDING_INFO = 4
+      };
+
+   void writeFileHeader();
+   void writeRecordHeader(RecordType type, size_t size);
+   void write(const void *data, size_t size) { fwrite(data, 1, size, _file); }
+   void writePadding(size_t size);
+
+   static uint64_t timestamp();
+
+   /// Size of the stdio buffer records are collected in before being written to the file
+   static const size_t BufferSize = 64 * 1024;
+
+   TR::RawAllocator _rawAllocator;
+   FILE            *_file;
+   TR::Monitor     *_monitor;
+   void            *_marker;       ///< executable mapping of the file that tells perf about it
+   size_t           _markerSize;
+   uint64_t         _codeIndex;    ///< unique index of the next code load
+   };
+
+}
+
+#endif // defined(LINUX)
+
+#endif // JITDUMP_HPP
@@ -312,6 +312,9 @@ OMR::CodeCache::initialize(TR::CodeCacheManager *manager,
 
    _hashEntryFreeList = NULL;
    _freeBlockList     = NULL;
+   _freeBlockIndex.initialize();
+   _numFreeBlocksReused = 0;
+   _numFreeBlocksCoalesced = 0;
    _flags = 0;
    _CCPreLoadedCodeInitialized = false;
    self()->unreserve();
@@ -1001,99 +1004,52 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
    //fprintf(stderr, "--ccr-- newFreeBlock size %d at %p\n", size, start);
    CodeCacheFreeCacheBlock *mergedBlock = NULL;
    CodeCacheFreeCacheBlock *link = NULL;
-   if (_freeBlockList)
+
+   // Find the free blocks on either side of the new one
+   CodeCacheFreeCacheBlock *prev = _freeBlockIndex.findPredecessor(start);
+   CodeCacheFreeCacheBlock *next = prev ? prev->_next : _freeBlockList;
+
+   // Gaps too small to ever become a free block are absorbed, but we should
+   // not merge warm blocks with cold blocks
+   bool mergeWithPrev = prev && start - ((uint8_t *)prev + prev->_size) < sizeof(CodeCacheFreeCacheBlock) &&
+                        !((uint8_t *)prev < _warmCodeAlloc && start >= _coldCodeAlloc);
+   bool mergeWithNext = next && (uint8_t *)next - end < sizeof(CodeCacheFreeCacheBlock) &&
+                        !(start < _warmCodeAlloc && (uint8_t *)next >= _coldCodeAlloc);
+
+   uint8_t *mergedEnd = end;
+   CodeCacheFreeCacheBlock *following = next;
+   if (mergeWithNext)
       {
-      CodeCacheFreeCacheBlock *curr;
-      // find the insertion point
-      for (curr = _freeBlockList; curr->_next && (uint8_t *)(curr->_next) < start; curr = curr->_next)
-         {}
+      TR_ASSERT(end <= (uint8_t *)next, "assertion failure"); // check for no overlap of blocks
+      mergedBlock = next;
+      mergedEnd = (uint8_t *)next + next->_size;
+      following = next->_next;
+      _freeBlockIndex.remove(next, self()->isColdFreeBlock(next));
+      _numFreeBlocksCoalesced++;
+      }
 
-      if (start < (uint8_t *)curr && (uint8_t *)curr - end < sizeof(CodeCacheFreeCacheBlock))
-         {
-         // merge with the curr block ahead, which is also the first block
-         TR_ASSERT(end <= (uint8_t *)curr, "assertion failure"); // check for no overlap of blocks
-         // we should not merge warm block with cold blocks
-         if (!(start < _warmCodeAlloc && (uint8_t *)curr >= _coldCodeAlloc))
-            {
-            // which is also the first block
-            link = (CodeCacheFreeCacheBlock *) start;
-            mergedBlock = curr;
-            //fprintf(stderr, "--ccr-- merging new free block of the size %d with a block of the size %d at %p\n", size, curr->size, link);
-            link->_size = (uint8_t *)curr + curr->_size - start;
-            link->_next = curr->_next;
-            _freeBlockList = link;
-            //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", link->size);
-            }
-         }
-      else if (curr->_next && ((uint8_t *)curr->_next - end < sizeof(CodeCacheFreeCacheBlock)) &&
-         !(start < _warmCodeAlloc && (uint8_t *)curr->_next >= _coldCodeAlloc))
-         {
-         // merge with the next block, but don't merge warm blocks with cold blocks
-         if ((start - ((uint8_t *)curr + curr->_size) < sizeof(CodeCacheFreeCacheBlock)) &&
-             !((uint8_t *)curr < _warmCodeAlloc && start >= _coldCodeAlloc))
-            {
-            // merge with the previous and the next blocks
-            mergedBlock = curr;
-            //fprintf(stderr, "--ccr-- merging new free block of the size %d with blocks of the size %d and %d at %p\n", size, curr->_size, curr->_next->_size, curr);
-            curr->_size = (uint8_t *)curr->_next + curr->_next->_size - (uint8_t *)curr;
-            curr->_next = curr->_next->_next;
-            //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", curr->_size);
-            link = curr;
-#ifdef DEBUG
-            start = (uint8_t *)curr;
-#endif
-            }
-         else
-            {
-            mergedBlock = curr->_next;
-            link = (CodeCacheFreeCacheBlock *) start;
-            //fprintf(stderr, "--ccr-- merging new free block of the size %d with a block of the size %d at %p\n", size, curr->next->size, link);
-            link->_size = (uint8_t *)curr->_next + curr->_next->_size - start;
-            link->_next = curr->_next->_next;
-            curr->_next = link;
-            //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", link->_size);
-            }
-         }
-      else if ((uint8_t *)curr < start && start - ((uint8_t *)curr + curr->_size) < sizeof(CodeCacheFreeCacheBlock))
-         {
-         // merge with the previous block
-         if (!((uint8_t *)curr < _warmCodeAlloc && start >= _coldCodeAlloc))
-            {
-            mergedBlock = curr;
-            curr->_size = start + size - (uint8_t *)curr;
-            //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", curr->_size);
-            link = curr;
-#ifdef DEBUG
-            start = (uint8_t *)curr;
-#endif
-            }
-         }
-      if (!link) // no merging happened
-         {
-         link = (CodeCacheFreeCacheBlock *) start;
-         link->_size = size;
-         if (start < (uint8_t *)curr)
-            {
-            link->_next = _freeBlockList;
-            _freeBlockList = link;
-            }
-         else
-            {
-            link->_next = curr->_next;
-            curr->_next = link;
-            }
-         }
+   if (mergeWithPrev)
+      {
+      mergedBlock = prev;
+      link = prev;
+      link->_next = following;
+      _freeBlockIndex.resize(link, mergedEnd - (uint8_t *)link, self()->isColdFreeBlock(link));
+      _numFreeBlocksCoalesced++;
       }
-   else // This is the first block in the list
+   else
       {
-      _freeBlockList = (CodeCacheFreeCacheBlock *) start;
-      _freeBlockList->_size = size;
-      _freeBlockList->_next = NULL;
-      //updateMaxSizeOfFreeBlocks(_freeBlockList, _freeBlockList->_size);
-      link = _freeBlockList;
+      link = (CodeCacheFreeCacheBlock *) start;
+      link->_size = mergedEnd - start;
+      link->_next = following;
+      if (prev)
+         prev->_next = link;
+      else
+         _freeBlockList = link;
+      _freeBlockIndex.add(link, self()->isColdFreeBlock(link));
       }
+   //fprintf(stderr, "--ccr-- new free block's size is %d\n", link->_size);
 
-   self()->updateMaxSizeOfFreeBlocks(link, link->_size);
+   self()->updateMaxSizeOfFreeBlocks(self()->isColdFreeBlock(link));
 
    _manager->decreaseCurrTotalUsedInBytes(size);
 
@@ -1103,8 +1059,8 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
          this,  (void*)start, (void*)end, mergedBlock, link, (uint32_t)link->_size, _sizeOfLargestFreeWarmBlock, _sizeOfLargestFreeColdBlock, _warmCodeAlloc, _coldCodeAlloc);
       }
 #ifdef DEBUG
-   uint8_t *paintStart = start + sizeof(CodeCacheFreeCacheBlock);
-   memset((void*)paintStart, 0xcc, ((CodeCacheFreeCacheBlock*)start)->_size - sizeof(CodeCacheFreeCacheBlock));
+   uint8_t *paintStart = (uint8_t *)link + sizeof(CodeCacheFreeCacheBlock);
+   memset((void*)paintStart, 0xcc, link->_size - sizeof(CodeCacheFreeCacheBlock));
 #endif
 
    if (config.doSanityChecks())
@@ -1119,144 +1075,53 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
 
 
 void
-OMR::CodeCache::updateMaxSizeOfFreeBlocks(CodeCacheFreeCacheBlock *blockPtr, size_t blockSize)
+OMR::CodeCache::updateMaxSizeOfFreeBlocks(bool isCold)
    {
    TR::CodeCacheConfig &config = _manager->codeCacheConfig();
    if (config.codeCacheFreeBlockRecylingEnabled())
       {
-      if ((uint8_t *)blockPtr < _warmCodeAlloc)
-         {
-         if (blockSize > _sizeOfLargestFreeWarmBlock)
-            {
-            //fprintf(stderr, "_sizeOfLargestFreeBlock for cache %p increased to %d\n", this, blockSize);
-            _sizeOfLargestFreeWarmBlock = blockSize;
-            }
-         }
-      else // block belongs to cold code
-         {
-         if (blockSize > _sizeOfLargestFreeColdBlock)
-            _sizeOfLargestFreeColdBlock = blockSize;
-         }
+      if (!isCold)
+         _sizeOfLargestFreeWarmBlock = _freeBlockIndex.largestBlockSize(false);
+      else
+         _sizeOfLargestFreeColdBlock = _freeBlockIndex.largestBlockSize(true);
       }
    }
 
-// Find the smallest free block that will satisfy the request.
+// Find a free block that will satisfy the request: the smallest one of the
+// request's size class, or else any block of the next larger class.
 //
 // isCold indicates whether a warm or cold block of memory is required.
 //
 uint8_t *
 OMR::CodeCache::findFreeBlock(size_t size, bool isCold, bool isMethodHeaderNeeded)
    {
-   CodeCacheFreeCacheBlock *currLink;
-   CodeCacheFreeCacheBlock *prevLink;
-   CodeCacheFreeCacheBlock *bestFitLink = NULL, *bestFitLinkPrev = NULL;
-   CodeCacheFreeCacheBlock *biggestLink = NULL;
-   CodeCacheFreeCacheBlock *secondBiggestLink = NULL;
-
    TR_ASSERT(_freeBlockList, "Because we first checked that a freeBlockExists, freeBlockList cannot be null");
 
-   // Find the smallest free link to fit the requested blockSize
-   for (currLink = _freeBlockList, prevLink = NULL; currLink; prevLink = currLink, currLink = currLink->_next)
-      {
-      if (isCold)
-         {
-         if ((void*)currLink < (void*)_coldCodeAlloc)
-            continue;
-         }
-      else
-         {
-         if ((void*)currLink >= (void*)_warmCodeAlloc)
-            continue;
-         // curLink is warm code
-         }
+   CodeCacheFreeCacheBlock *bestFitLink = _freeBlockIndex.findFit(size, isCold);
 
-      //fprintf(stderr, "cache %p findFreeBlock bs=%u\n", this, currLink->size);
-      if (!biggestLink)
-         {
-         biggestLink = currLink;
-         }
-      else
-         {
-         if (currLink->_size >= biggestLink->_size) // >= is important; do not use > only as secondBiggestLink may be wrong
-            {
-            secondBiggestLink = biggestLink;
-            biggestLink = currLink;
-            }
-         else
-            {
-            if (secondBiggestLink)
-               {
-               if (currLink->_size >= secondBiggestLink->_size)
-                  secondBiggestLink = currLink;
-               }
-            else
-               {
-               secondBiggestLink = currLink;
-               }
-            }
-         }
-
-      if (currLink->_size >= size)
-         {
-         if (!bestFitLink)
-            {
-            bestFitLink = currLink;
-            bestFitLinkPrev = prevLink;
-            }
-         else if (bestFitLink->_size > currLink->_size)
-            {
-            bestFitLink = currLink;
-            bestFitLinkPrev = prevLink;
-            }
-         }
-      } // end for
-
-   // safety net
-   TR_ASSERT(biggestLink, "There must be a biggestLink");
-   TR_ASSERT(bestFitLink, "There must be a bestFitLink");
+   // Because we call this method only after we made sure a free block exists
+   // this function can never return NULL
+   TR_ASSERT(bestFitLink, "FindFreeBlock return NULL");
 
    TR::CodeCacheConfig & config = _manager->codeCacheConfig();
-   if (!isCold)
-      {
-      TR_ASSERT(!config.codeCacheFreeBlockRecylingEnabled() ||
-              _sizeOfLargestFreeWarmBlock == biggestLink->_size, "_sizeOfLargestFreeWarmBlock=%d  biggestLink->_size=%d",
-           _sizeOfLargestFreeWarmBlock, (int32_t)biggestLink->_size);
-      }
-   else
+   TR_ASSERT(!config.codeCacheFreeBlockRecylingEnabled() ||
+           (isCold ? _sizeOfLargestFreeColdBlock : _sizeOfLargestFreeWarmBlock) == _freeBlockIndex.largestBlockSize(isCold),
+           "sizeOfLargestFreeBlock=%d largestBlockSize=%d",
+           (int32_t)(isCold ? _sizeOfLargestFreeColdBlock : _sizeOfLargestFreeWarmBlock), (int32_t)_freeBlockIndex.largestBlockSize(isCold));
+
+   // Remove the allocated block from the free blocks AND if there is any unused
+   // space left in the chunk, reclaim it and put it back as a free block
+   CodeCacheFreeCacheBlock *leftBlock = self()->removeFreeBlock(size, bestFitLink);
+   self()->updateMaxSizeOfFreeBlocks(isCold);
+   _numFreeBlocksReused++;
+
+   //fprintf(stderr, "--ccr-- reallocate free'd block of size %d\n", size);
+   if (config.verboseReclamation())
       {
-      TR_ASSERT(!config.codeCacheFreeBlockRecylingEnabled() ||
-         _sizeOfLargestFreeColdBlock == biggestLink->_size, "assertion failure");
+      TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE,"--ccr- findFreeBlock: CodeCache=%p size=%u isCold=%d bestFitLink=%p bestFitLink->size=%u leftBlock=%p", this, size, isCold, bestFitLink, bestFitLink->_size, leftBlock);
       }
 
-   if (bestFitLink)
-      {
-      // Fix the linked list by removing the allocated block AND if there is any unused
-      // space left in the currLink chunk, reclaim it and put back on the freeList
-      CodeCacheFreeCacheBlock *leftBlock = self()->removeFreeBlock(size, bestFitLinkPrev, bestFitLink);
-
-      if (bestFitLink == biggestLink)  // Size of biggest might have changed
-         {
-         uint64_t leftBlockSize     = leftBlock ? leftBlock->_size : 0;
-         uint64_t secondBiggestSize = secondBiggestLink ? secondBiggestLink->_size : 0;
-         uint64_t biggestSize       = leftBlockSize > secondBiggestSize ? leftBlockSize : secondBiggestSize;
-         if (!isCold)
-            {
-            _sizeOfLargestFreeWarmBlock = (size_t)biggestSize;
-            }
-         else
-            _sizeOfLargestFreeColdBlock = (size_t)biggestSize;
-         }
-     //fprintf(stderr, "--ccr-- reallocate free'd block of size %d\n", size);
-     if (config.verboseReclamation())
-         {
-         TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE,"--ccr- findFreeBlock: CodeCache=%p size=%u isCold=%d bestFitLink=%p bestFitLink->size=%u leftBlock=%p", this, size, isCold, bestFitLink, bestFitLink->_size, leftBlock);
-         }
-
-      _manager->increaseCurrTotalUsedInBytes(bestFitLink->_size);
-      }
-   // Because we call this method only after we made sure a free block exists
-   // this function can never return NULL
-   TR_ASSERT(bestFitLink, "FindFreeBlock return NULL");
+   _manager->increaseCurrTotalUsedInBytes(bestFitLink->_size);
 
    if (isMethodHeaderNeeded)
       self()->writeMethodHeader(bestFitLink, bestFitLink->_size, isCold);
@@ -1268,7 +1133,7 @@ OMR::CodeCache::findFreeBlock(size_t size, bool isCold, bool isMethodHeaderNeede
    }
 
 
-// Remove a free block from the list of free blocks for this code cache to make
+// Remove a free block from the free blocks of this code cache to make
 // it available for re-use.
 //
 // blockSize is the amount of memory needed from this free block.
@@ -1276,53 +1141,75 @@ OMR::CodeCache::findFreeBlock(size_t size, bool isCold, bool isMethodHeaderNeede
 // The function returns the remaining part of the block that was split
 OMR::CodeCacheFreeCacheBlock *
 OMR::CodeCache::removeFreeBlock(size_t blockSize,
-                              CodeCacheFreeCacheBlock *prev,
                               CodeCacheFreeCacheBlock *curr)
    {
+   bool isCold = self()->isColdFreeBlock(curr);
+   CodeCacheFreeCacheBlock *prev = _freeBlockIndex.findPredecessor(curr);
    CodeCacheFreeCacheBlock *next = curr->_next;
 
+#if defined(OSX) && defined(AARCH64)
+   pthread_jit_write_protect_np(0);
+#endif
+
+   _freeBlockIndex.remove(curr, isCold);
+
    // Is there any left over space in the current link? Save it as a
    // separate link and adjust the sizes of the two split resulting blocks
    if (curr->_size - blockSize >= MIN_SIZE_BLOCK)
       {
-#if defined(OSX) && defined(AARCH64)
-      pthread_jit_write_protect_np(0);
-#endif
-
       size_t splitSize = curr->_size - blockSize; // remaining portion
       curr->_size = blockSize;
       curr = (CodeCacheFreeCacheBlock *) ((uint8_t *) curr + blockSize);
       curr->_size = splitSize;
       curr->_next = next;
+      _freeBlockIndex.add(curr, isCold);
+      }
+   else // Use the entire block
+      {
+      curr = next;
+      }
 
-      if (prev)
-         prev->_next = curr;
-      else
-         _freeBlockList = curr;
+   if (prev)
+      prev->_next = curr;
+   else
+      _freeBlockList = curr;
 
 #if defined(OSX) && defined(AARCH64)
-      pthread_jit_write_protect_np(1);
+   pthread_jit_write_protect_np(1);
 #endif
 
-      return curr;
-      }
-   else // Use the entire block
-      {
+   return curr != next ? curr : NULL;
+   }
+
+
+void
+OMR::CodeCache::setFreeBlockList(CodeCacheFreeCacheBlock *fcb)
+   {
 #if defined(OSX) && defined(AARCH64)
-      pthread_jit_write_protect_np(0);
+   pthread_jit_write_protect_np(0);
 #endif
 
-      if (prev)
-         prev->_next = next;
-      else
-         _freeBlockList = next;
+   _freeBlockList = fcb;
+   _freeBlockIndex.initialize();
+   for (CodeCacheFreeCacheBlock *currLink = _freeBlockList; currLink; currLink = currLink->_next)
+      _freeBlockIndex.add(currLink, self()->isColdFreeBlock(currLink));
 
 #if defined(OSX) && defined(AARCH64)
-      pthread_jit_write_protect_np(1);
+   pthread_jit_write_protect_np(1);
 #endif
 
-      return NULL;
-      }
+   self()->updateMaxSizeOfFreeBlocks(false);
+   self()->updateMaxSizeOfFreeBlocks(true);
+   }
+
+
+uint32_t
+OMR::CodeCache::getFreeBlockFragmentation(bool isCold)
+   {
+   size_t freeBytes = _freeBlockIndex.freeBytes(isCold);
+   if (freeBytes == 0)
+      return 0;
+   return (uint32_t)(100 - (uint64_t)_freeBlockIndex.largestBlockSize(isCold) * 100 / freeBytes);
    }
 
 
@@ -1360,7 +1247,12 @@ OMR::CodeCache::printOccupancyStats()
             }
          }
       fprintf(stderr, "\n");
+      fprintf(stderr, "   free warm blocks = %u (%" OMR_PRIuSIZE " bytes, %u%% fragmented)\n",
+         self()->getNumFreeBlocks(false), self()->getFreeBlockBytes(false), self()->getFreeBlockFragmentation(false));
+      fprintf(stderr, "   free cold blocks = %u (%" OMR_PRIuSIZE " bytes, %u%% fragmented)\n",
+         self()->getNumFreeBlocks(true), self()->getFreeBlockBytes(true), self()->getFreeBlockFragmentation(true));
       }
+   fprintf(stderr, "   free blocks reused = %u coalesced = %u\n", _numFreeBlocksReused, _numFreeBlocksCoalesced);
 
    TR::CodeCacheConfig &config = _manager->codeCacheConfig();
    if (config.trampolineCodeSize())
@@ -1405,6 +1297,8 @@ OMR::CodeCache::checkForErrors()
       {
       bool doCrash = false;
       size_t maxFreeWarmSize = 0, maxFreeColdSize = 0;
+      size_t freeWarmBytes = 0, freeColdBytes = 0;
+      uint32_t numFreeWarmBlocks = 0, numFreeColdBlocks = 0;
       // scope for cache walk
          {
          CacheCriticalSection walkFreeList(self());
@@ -1467,13 +1361,29 @@ OMR::CodeCache::checkForErrors()
                {
                if (currLink->_size > maxFreeWarmSize)
                   maxFreeWarmSize = currLink->_size;
+               freeWarmBytes += currLink->_size;
+               numFreeWarmBlocks++;
                }
             else // cold block
                {
                if (currLink->_size > maxFreeColdSize)
                   maxFreeColdSize = currLink->_size;
+               freeColdBytes += currLink->_size;
+               numFreeColdBlocks++;
+               }
+            // The address tree must find the block from its successor
+            if (currLink->_next && _freeBlockIndex.findPredecessor(currLink->_next) != currLink)
+               {
+               fprintf(stderr, "checkForErrors cache %p: Error: free block %p is not the predecessor of %p in the free block index\n", this, currLink, currLink->_next);
+               doCrash = true;
                }
             } // end for
+         if (_freeBlockIndex.numBlocks(false) != numFreeWarmBlocks || _freeBlockIndex.freeBytes(false) != freeWarmBytes ||
+             _freeBlockIndex.numBlocks(true) != numFreeColdBlocks || _freeBlockIndex.freeBytes(true) != freeColdBytes)
+            {
+            fprintf(stderr, "checkForErrors cache %p: Error: free block index does not match the free block list\n", this);
+            doCrash = true;
+            }
          if (_sizeOfLargestFreeWarmBlock != maxFreeWarmSize)
             {
             fprintf(stderr, "checkForErrors cache %p: Error: _sizeOfLargestFreeWarmBlock(%" OMR_PRIuSIZE ") != maxFreeWarmSize(%" OMR_PRIuSIZE ")\n", this, _sizeOfLargestFreeWarmBlock, maxFreeWarmSize);
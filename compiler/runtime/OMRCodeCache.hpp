@@ -171,6 +171,34 @@ public:
    size_t                     getSizeOfLargestFreeWarmBlock() const { return _sizeOfLargestFreeWarmBlock; }
    size_t                     getSizeOfLargestFreeColdBlock() const { return _sizeOfLargestFreeColdBlock; }
 
+   /**
+    * @brief Number of reclaimed blocks currently free in the warm or cold region
+    */
+   uint32_t                   getNumFreeBlocks(bool isCold) const   { return _freeBlockIndex.numBlocks(isCold); }
+
+   /**
+    * @brief Number of bytes in reclaimed blocks currently free in the warm or cold region
+    */
+   size_t                     getFreeBlockBytes(bool isCold) const  { return _freeBlockIndex.freeBytes(isCold); }
+
+   /**
+    * @brief Fragmentation of the reclaimed space of the warm or cold region
+    *
+    * @return the percentage of the free block bytes that are not in the
+    *         largest free block; 0 when there are no free blocks
+    */
+   uint32_t                   getFreeBlockFragmentation(bool isCold);
+
+   /**
+    * @brief Number of allocations satisfied from a reclaimed block
+    */
+   uint32_t                   getNumFreeBlocksReused() const        { return _numFreeBlocksReused; }
+
+   /**
+    * @brief Number of times a freed block was coalesced with a neighbouring free block
+    */
+   uint32_t                   getNumFreeBlocksCoalesced() const     { return _numFreeBlocksCoalesced; }
+
    uint32_t                   tempTrampolinesMax()                  { return _tempTrampolinesMax; }
    bool                       addResolvedMethod(TR_OpaqueMethodBlock *method);
 
@@ -220,12 +248,13 @@ public:
                                          size_t allocatedCodeCacheSizeInBytes);
 
 private:
-   void                       updateMaxSizeOfFreeBlocks(CodeCacheFreeCacheBlock *blockPtr, size_t blockSize);
+   void                       updateMaxSizeOfFreeBlocks(bool isCold);
 
    CodeCacheFreeCacheBlock *  removeFreeBlock(size_t blockSize,
-                                              CodeCacheFreeCacheBlock *prev,
                                               CodeCacheFreeCacheBlock *curr);
 
+   bool                       isColdFreeBlock(CodeCacheFreeCacheBlock *block) const { return (uint8_t *)block >= _warmCodeAlloc; }
+
 public:
    bool                       addFreeBlock2WithCallSite(uint8_t *start,
                                                         uint8_t *end,
@@ -296,11 +325,11 @@ public:
    CodeCacheFreeCacheBlock *freeBlockList() { return _freeBlockList; }
 
    /**
-    * @brief Setter for freeBlockList
+    * @brief Setter for freeBlockList; the free block index is rebuilt from the new list
     *
     * @param[in] : The new head of the CodeCacheFreeCacheBlock list
     */
-   void setFreeBlockList(CodeCacheFreeCacheBlock *fcb) { _freeBlockList = fcb; }
+   void setFreeBlockList(CodeCacheFreeCacheBlock *fcb);
 
    /**
     * @brief Getter for the base address of temporary trampolines
@@ -415,6 +444,9 @@ public:
    TR::CodeCacheMemorySegment *_segment;
 
    CodeCacheFreeCacheBlock *_freeBlockList;
+   CodeCacheFreeBlockIndex  _freeBlockIndex;
+   uint32_t                 _numFreeBlocksReused;
+   uint32_t                 _numFreeBlocksCoalesced;
 
    // This is used in an attempt to enforce mutually exclusive ownership.
    // flag accessed under mutex <== This is deceiving! There are two different monitors we may hold (not at the same time!) when we write to this.
@@ -107,7 +107,8 @@ class OMR_EXTENSIBLE CodeCacheConfig
          _doSanityChecks(false),
          _codeCacheFreeBlockRecylingEnabled(false),
          _emitExecutableELF(false),
-         _emitRelocatableELF(false)
+         _emitRelocatableELF(false),
+         _emitJitDump(false)
       {
       #if defined(J9ZOS390)     // EBCDIC
       _warmEyeCatcher[0] = '\xD1';
@@ -179,6 +180,7 @@ class OMR_EXTENSIBLE CodeCacheConfig
 
    bool emitExecutableELF() const { return _emitExecutableELF; }
    bool emitRelocatableELF() const { return _emitRelocatableELF; }
+   bool emitJitDump() const { return _emitJitDump; }
 
    int32_t _trampolineCodeSize;          /*!< size of the trampoline code in bytes */
    int32_t _CCPreLoadedCodeSize;         /*!< size of the pre-Loaded CodeCache Helpers code in bytes */
@@ -210,6 +212,7 @@ class OMR_EXTENSIBLE CodeCacheConfig
 
    bool _emitExecutableELF;                  /*!< emit code cache as ELF object on shutdown */
    bool _emitRelocatableELF;
+   bool _emitJitDump;                        /*!< describe compiled code in a jitdump file for perf */
 
    char * const warmEyeCatcher() { return _warmEyeCatcher; }
 
@@ -49,6 +49,7 @@
 #include <elf.h>
 #include <unistd.h>
 #include "codegen/ELFGenerator.hpp"
+#include "runtime/JitDump.hpp"
 
 TR::CodeCacheSymbolContainer * OMR::CodeCacheManager::_symbolContainer = NULL;
 
@@ -93,10 +94,15 @@ OMR::CodeCacheManager::initialize(
    {
    TR_ASSERT(!self()->initialized(), "cannot initialize code cache manager more than once");
 
+   _jitDump = NULL;
+
 #if (HOST_OS == OMR_LINUX)
    _elfRelocatableGenerator = NULL;
    _elfExecutableGenerator = NULL;
 
+   if (self()->codeCacheConfig().emitJitDump())
+      self()->initializeJitDump();
+
    if (_symbolContainer == NULL){
          TR::CodeCacheSymbolContainer * symbolContainer = static_cast<TR::CodeCacheSymbolContainer *>(self()->getMemory(sizeof(TR::CodeCacheSymbolContainer)));
          symbolContainer->_head = NULL;
@@ -144,6 +150,7 @@ OMR::CodeCacheManager::initialize(
    // Initialize the list of code caches
    //
    _codeCacheList._head = NULL;
+   _hotCodeCache = NULL;
    _codeCacheList._mutex = TR::Monitor::create("JIT-CodeCacheListMutex");
    if (_codeCacheList._mutex == NULL)
       return NULL;
@@ -223,6 +230,12 @@ OMR::CodeCacheManager::destroy()
                               "Failed to write code cache symbols to relocatable ELF file.");
       }
    }
+
+   if (_jitDump)
+      {
+      _jitDump->close();
+      _jitDump = NULL;
+      }
 #endif // HOST_OS == OMR_LINUX
 
    TR::CodeCache *codeCache = self()->getFirstCodeCache();
@@ -303,11 +316,30 @@ OMR::CodeCacheManager::unreserveCodeCache(TR::CodeCache *codeCache)
 // A compThreadID of -1 means unknown. This ID will be written into the code cache
 // The ID of the thread that last reserved the cache will remain written after the
 // reservation is over. This will allow us to implement some affinity.
+static bool
+canHoldCompilation(TR::CodeCache *codeCache, bool compilationCodeAllocationsMustBeContiguous, size_t sizeEstimate)
+   {
+   TR_YesNoMaybe almostFull = codeCache->almostFull();
+   if (almostFull == TR_no || (almostFull == TR_maybe && !compilationCodeAllocationsMustBeContiguous))
+      {
+      // Is the free space big enough?
+      if (sizeEstimate == 0 || // If size estimate is not given we'll blindly pick anything
+          codeCache->getFreeContiguousSpace() >= sizeEstimate ||
+          codeCache->getSizeOfLargestFreeWarmBlock() >= sizeEstimate   // we don't know yet the warm/cold requirements
+          )                                                             // so check only for warm part
+         {
+         return true;
+         }
+      }
+   return false;
+   }
+
 TR::CodeCache *
 OMR::CodeCacheManager::reserveCodeCache(bool compilationCodeAllocationsMustBeContiguous,
                                       size_t sizeEstimate,
                                       int32_t compThreadID,
-                                      int32_t *numReserved)
+                                      int32_t *numReserved,
+                                      bool isHotCode)
    {
    int32_t numCachesAlreadyReserved = 0;
    TR::CodeCache *codeCache = NULL;
@@ -316,54 +348,77 @@ OMR::CodeCacheManager::reserveCodeCache(bool compilationCodeAllocationsMustBeCon
    //
       {
       CacheListCriticalSection scanCacheList(self());
-      for (codeCache = self()->getFirstCodeCache(); codeCache; codeCache = codeCache->next())
+
+      TR::CodeCache *hotCodeCache = _hotCodeCache;
+      if (isHotCode && hotCodeCache && !hotCodeCache->isReserved() &&
+          canHoldCompilation(hotCodeCache, compilationCodeAllocationsMustBeContiguous, sizeEstimate))
          {
-         if (!codeCache->isReserved()) // we cannot touch the reserved ones
+         hotCodeCache->reserve(compThreadID);
+         codeCache = hotCodeCache;
+         }
+      else
+         {
+         for (codeCache = self()->getFirstCodeCache(); codeCache; codeCache = codeCache->next())
             {
-            TR_YesNoMaybe almostFull = codeCache->almostFull();
-            if (almostFull == TR_no || (almostFull == TR_maybe && !compilationCodeAllocationsMustBeContiguous))
+            if (!codeCache->isReserved()) // we cannot touch the reserved ones
                {
-               // Is the free space big enough?
-               if (sizeEstimate == 0 || // If size estimate is not given we'll blindly pick anything
-                   codeCache->getFreeContiguousSpace() >= sizeEstimate ||
-                   codeCache->getSizeOfLargestFreeWarmBlock() >= sizeEstimate   // we don't know yet the warm/cold requirements
-                   )                                                             // so check only for warm part
+               // Leave the hot code cache to hot code while there are others
+               if (codeCache == hotCodeCache && !isHotCode)
+                  continue;
+
+               if (canHoldCompilation(codeCache, compilationCodeAllocationsMustBeContiguous, sizeEstimate))
                   {
                   codeCache->reserve(compThreadID);
                   break;
                   }
                }
-            }
-         else // code cache is reserved
+            else // code cache is reserved
+               {
+               numCachesAlreadyReserved++;
+               }
+            } // end for
+
+         if (!codeCache && !isHotCode && hotCodeCache && !hotCodeCache->isReserved() &&
+             canHoldCompilation(hotCodeCache, compilationCodeAllocationsMustBeContiguous, sizeEstimate))
             {
-            numCachesAlreadyReserved++;
+            hotCodeCache->reserve(compThreadID);
+            codeCache = hotCodeCache;
             }
-         } // end for
+         }
       }
 
    *numReserved = numCachesAlreadyReserved;
 
-   if (codeCache)
-      {
-      TR_ASSERT(codeCache->isReserved(), "cache must be reserved\n");
-      return codeCache;
-      }
-
-   // No existing code cache is available; try to allocate a new one
-   if (self()->canAddNewCodeCache())
-      {
-      TR::CodeCacheConfig &config = self()->codeCacheConfig();
-      codeCache = self()->allocateCodeCacheFromNewSegment(config.codeCacheKB() << 10, compThreadID);
-      }
-   else
+   if (!codeCache)
       {
-      if (numCachesAlreadyReserved > 0)
-         self()->setHasFailedCodeCacheAllocation();
+      // No existing code cache is available; try to allocate a new one
+      if (self()->canAddNewCodeCache())
+         {
+         TR::CodeCacheConfig &config = self()->codeCacheConfig();
+         codeCache = self()->allocateCodeCacheFromNewSegment(config.codeCacheKB() << 10, compThreadID);
+         }
+      else
+         {
+         if (numCachesAlreadyReserved > 0)
+            self()->setHasFailedCodeCacheAllocation();
+         }
       }
 
    if (codeCache)
       {
       TR_ASSERT(codeCache->isReserved(), "cache must be reserved\n");
+
+      // Hot code moves on to a new hot code cache once the current one fills up
+      if (isHotCode && codeCache != _hotCodeCache)
+         {
+         CacheListCriticalSection updateHotCodeCache(self());
+         if (!_hotCodeCache || _hotCodeCache->almostFull() != TR_no)
+            {
+            _hotCodeCache = codeCache;
+            if (self()->codeCacheConfig().verboseCodeCache())
+               TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "CodeCache %p is now the hot code cache", codeCache);
+            }
+         }
       }
    else
       {
@@ -890,6 +945,8 @@ void
 OMR::CodeCacheManager::registerCompiledMethod(const char *sig, uint8_t *startPC, uint32_t codeSize)
    {
 #if (HOST_OS == OMR_LINUX)
+   if (_jitDump)
+      _jitDump->writeCodeLoad(sig, startPC, codeSize);
 
    TR::CodeCacheSymbol *newSymbol = static_cast<TR::CodeCacheSymbol *> (self()->getMemory(sizeof(TR::CodeCacheSymbol)));
    uint32_t nameLength = strlen(sig) + 1;
@@ -927,6 +984,15 @@ OMR::CodeCacheManager::registerCompiledMethod(const char *sig, uint8_t *startPC,
 #endif // HOST_OS == OMR_LINUX
    }
 
+void
+OMR::CodeCacheManager::registerCodeMove(uint8_t *oldStartPC, uint8_t *newStartPC, uint32_t codeSize)
+   {
+#if (HOST_OS == OMR_LINUX)
+   if (_jitDump)
+      _jitDump->writeCodeMove(oldStartPC, newStartPC, codeSize);
+#endif // HOST_OS == OMR_LINUX
+   }
+
 void
 OMR::CodeCacheManager::registerStaticRelocation(const TR::StaticRelocation &relocation)
    {
@@ -1181,6 +1247,14 @@ OMR::CodeCacheManager::initializeExecutableELFGenerator(void)
          _codeCacheRepositorySegment->segmentTop() - _codeCacheRepositorySegment->segmentBase()
          );
    }
+
+void
+OMR::CodeCacheManager::initializeJitDump(void)
+   {
+   _jitDump = TR::JitDump::create(_rawAllocator, "/tmp");
+   if (!_jitDump && self()->codeCacheConfig().verboseCodeCache())
+      TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "Failed to create the jitdump file");
+   }
 #endif // HOST_OS==OMR_LINUX
 
 
@@ -53,6 +53,7 @@ namespace OMR { typedef CodeCacheManager CodeCacheManagerConnector; }
 
 namespace TR { class ELFRelocatableGenerator; }
 namespace TR { class ELFExecutableGenerator; }
+namespace TR { class JitDump; }
 
 namespace TR {
 
@@ -169,10 +170,37 @@ public:
    TR::CodeCacheMemorySegment *getNewCodeCacheMemorySegment(size_t segmentSize, size_t & codeCacheSizeAllocated);
 
    void        unreserveCodeCache(TR::CodeCache *codeCache);
+
+   /**
+    * @brief Reserve a code cache for a compilation
+    *
+    * @details
+    *    Code of hot compilations (including recompilations of methods that
+    *    became hot) is clustered in a designated hot code cache, which other
+    *    compilations only use when no other code cache can be reserved. Keeping
+    *    the hot method bodies together reduces the number of pages, and thus
+    *    iTLB entries and i-cache lines, that the hot code spans.
+    *
+    * @param[in] compilationCodeAllocationsMustBeContiguous : true if the code must be allocated contiguously
+    * @param[in] sizeEstimate : estimated size of the code, or 0 if unknown
+    * @param[in] compThreadID : ID of the requesting compilation thread, or -1 if unknown
+    * @param[out] numReserved : the number of code caches already reserved by other compilations
+    * @param[in] isHotCode : true if the compilation produces hot code
+    *
+    * @return the reserved code cache, or NULL if none is available
+    */
    TR::CodeCache * reserveCodeCache(bool compilationCodeAllocationsMustBeContiguous,
                                     size_t sizeEstimate,
                                     int32_t compThreadID,
-                                    int32_t *numReserved);
+                                    int32_t *numReserved,
+                                    bool isHotCode = false);
+
+   /**
+    * @brief Getter for the code cache in which hot code is clustered
+    *
+    * @returns The hot code cache, or NULL if no hot code has been compiled yet
+    */
+   TR::CodeCache * getHotCodeCache() { return _hotCodeCache; }
    TR::CodeCache * getNewCodeCache(int32_t reservingCompThreadID);
 
    uint8_t * allocateCodeMemory(size_t warmCodeSize,
@@ -304,6 +332,17 @@ public:
    void registerCompiledMethod(const char *sig, uint8_t *startPC, uint32_t codeSize);
    void registerStaticRelocation(const TR::StaticRelocation &relocation);
 
+   /**
+    * @brief Reports that compiled code has been copied to a new location, so
+    *        that profilers can attribute samples at the new location to it.
+    */
+   void registerCodeMove(uint8_t *oldStartPC, uint8_t *newStartPC, uint32_t codeSize);
+
+   /**
+    * @brief Answers the jitdump file writer, or NULL if no jitdump file is being written.
+    */
+   TR::JitDump *getJitDump() { return _jitDump; }
+
    /**
     * @brief Hint to free a given code cache segment.
     *
@@ -329,6 +368,7 @@ protected:
    TR::RawAllocator               _rawAllocator;
    TR::CodeCacheConfig            _config;
    TR::CodeCache                 *_lastCache;                         /*!< last code cache round robined through */
+   TR::CodeCache                 *_hotCodeCache;                      /*!< code cache in which hot code is clustered */
    CodeCacheList                  _codeCacheList;                     /*!< list of allocated code caches */
    int32_t                        _curNumberOfCodeCaches;
 
@@ -344,6 +384,8 @@ protected:
    TR::Monitor                   *_usageMonitor;
    size_t                         _currTotalUsedInBytes;
    size_t                         _maxUsedInBytes;
+
+   TR::JitDump                   *_jitDump;                           /*!< jitdump file writer for perf */
 #if (HOST_OS == OMR_LINUX)
    public:
    /**
@@ -360,6 +402,11 @@ protected:
    */
    void initializeExecutableELFGenerator(void);
 
+   /**
+    * Creates the jitdump file for this process if the option is enabled
+   */
+   void initializeJitDump(void);
+
    protected:
 
    TR::ELFExecutableGenerator      *_elfExecutableGenerator; /**< Executable ELF generator */
@@ -22,6 +22,10 @@
 #include "runtime/CodeCacheMemorySegment.hpp"
 #include "runtime/CodeCacheManager.hpp"
 
+#if defined(LINUX)
+#include <sys/mman.h>
+#endif
+
 TR::CodeCacheMemorySegment*
 OMR::CodeCacheMemorySegment::self()
    {
@@ -42,3 +46,19 @@ OMR::CodeCacheMemorySegment::free(TR::CodeCacheManager *manager)
    manager->freeMemory(_base);
    new (static_cast<TR::CodeCacheMemorySegment *>(this)) TR::CodeCacheMemorySegment();
    }
+
+
+bool
+OMR::CodeCacheMemorySegment::adviseHugePages(size_t hugePageSize)
+   {
+#if defined(LINUX) && defined(MADV_HUGEPAGE)
+   uintptr_t start = ((uintptr_t)_base + hugePageSize - 1) & ~(uintptr_t)(hugePageSize - 1);
+   uintptr_t end = (uintptr_t)_top & ~(uintptr_t)(hugePageSize - 1);
+   if (start >= end)
+      return false;
+
+   return madvise((void *)start, end - start, MADV_HUGEPAGE) == 0;
+#else
+   return false;
+#endif
+   }
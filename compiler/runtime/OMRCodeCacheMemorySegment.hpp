@@ -70,6 +70,23 @@ public:
    // memory is backed by something else
    void free(TR::CodeCacheManager *manager);
 
+   /**
+    * @brief Asks the operating system to back the segment with huge pages
+    *
+    * @details
+    *    Only the part of the segment that is aligned on \p hugePageSize is
+    *    advised, so the segment should be allocated with that alignment.
+    *    Executable code spread over many small pages costs iTLB misses; a
+    *    single 2MB page covers a whole code cache.
+    *
+    * @param[in] hugePageSize : the size of a huge page in bytes
+    *
+    * @return true if at least one huge page could be requested; false otherwise
+    */
+   bool adviseHugePages(size_t hugePageSize);
+
+   static const size_t DefaultHugePageSize = 2 * 1024 * 1024;
+
    uint8_t *_base;
    uint8_t *_alloc;
    uint8_t *_top;
@@ -23,10 +23,8 @@
 
 #include <stdint.h>
 #include <string.h>
-#include "avl_api.h"
 #include "env/TRMemory.hpp"
 #include "infra/Assert.hpp"
-#include "j9nongenerated.h"
 #include "runtime/CodeCache.hpp"
 #include "runtime/CodeCacheMemorySegment.hpp"
 #include "runtime/CodeMetaDataManager.hpp"
@@ -44,11 +42,8 @@ TR::CodeMetaDataManager *CodeMetaDataManager::_codeMetaDataManager = NULL;
 
 
 CodeMetaDataManager::CodeMetaDataManager() :
-   _cachedPC(0),
-   _cachedHashTable(NULL),
-   _retrievedMetaDataCache(NULL)
+   _hashTables(NULL)
    {
-   _metaDataAVL = self()->allocateMetaDataAVL();
    }
 
 
@@ -75,31 +70,22 @@ CodeMetaDataManager::initializeCodeMetaDataManager()
    }
 
 
-// First allocation
-//
-J9AVLTree *
-CodeMetaDataManager::allocateMetaDataAVL()
+TR::CodeMetaDataManager::HashTableArray *
+CodeMetaDataManager::allocateHashTableArray(uintptr_t numTables)
    {
-   J9AVLTree *metaDataAVLTree;
+   size_t size = sizeof(HashTableArray) + (numTables - 1) * sizeof(TR::MetaDataHashTable *);
+   HashTableArray *array = (HashTableArray *) TR_Memory::jitPersistentAlloc(size, TR_Memory::CodeMetaDataAVL);
 
-   metaDataAVLTree = (J9AVLTree *) TR_Memory::jitPersistentAlloc(sizeof(J9AVLTree), TR_Memory::CodeMetaDataAVL);
-
-   if (!metaDataAVLTree)
-      return NULL;
-
-   metaDataAVLTree->insertionComparator = (intptr_t (*)(J9AVLTree *, J9AVLTreeNode *, J9AVLTreeNode *))OMR::avl_jit_metadata_insertionCompare;
-   metaDataAVLTree->searchComparator = (intptr_t (*)(J9AVLTree *, uintptr_t, J9AVLTreeNode *))OMR::avl_jit_metadata_searchCompare;
-   metaDataAVLTree->genericActionHook = NULL;
-   metaDataAVLTree->flags = 0;
-   metaDataAVLTree->rootNode = 0;
-
-   // Use the OMR AVL structure but TR will manage its own memory
-   //
-   metaDataAVLTree->portLibrary = NULL;
+   if (array)
+      {
+      array->_numTables = numTables;
+      array->_retired = NULL;
+      }
 
-   return metaDataAVLTree;
+   return array;
    }
 
+
 /**
  * Insert metadata into the MetaDataManager.
  *
@@ -137,8 +123,6 @@ CodeMetaDataManager::removeMetaData(const TR::MethodMetaDataPOD *metaData)
       removeSuccess = self()->removeRange(metaData, metaData->startPC, metaData->endPC);
       }
 
-   _retrievedMetaDataCache = NULL;
-
    return removeSuccess;
    }
 
@@ -147,16 +131,8 @@ const TR::MethodMetaDataPOD *
 CodeMetaDataManager::findMetaDataForPC(uintptr_t pc)
    {
    TR_ASSERT(pc != 0, "attempting to query existing MetaData for a NULL PC");
-   self()->updateCache(pc);
-   if (!_retrievedMetaDataCache)
-      {
-      if (_cachedHashTable)
-         {
-         _retrievedMetaDataCache = self()->findMetaDataInHash(_cachedHashTable, pc);
-         }
-      }
-
-   return _retrievedMetaDataCache;
+   TR::MetaDataHashTable *table = self()->findHashTable(pc);
+   return table ? self()->findMetaDataInHash(table, pc) : NULL;
    }
 
 
@@ -168,10 +144,10 @@ CodeMetaDataManager::insertRange(
       uintptr_t endPC)
    {
    bool insertSuccess = false;
-   self()->updateCache(metaData->startPC);
-   if (_cachedHashTable)
+   TR::MetaDataHashTable *table = self()->findHashTable(startPC);
+   if (table)
       {
-      insertSuccess = (self()->insertMetaDataRangeInHash(_cachedHashTable, metaData, startPC, endPC) == 0);
+      insertSuccess = (self()->insertMetaDataRangeInHash(table, metaData, startPC, endPC) == 0);
       }
 
    return insertSuccess;
@@ -186,10 +162,10 @@ CodeMetaDataManager::removeRange(
       uintptr_t endPC)
    {
    bool removeSuccess = false;
-   self()->updateCache(metaData->startPC);
-   if (_cachedHashTable)
+   TR::MetaDataHashTable *table = self()->findHashTable(startPC);
+   if (table)
       {
-      removeSuccess = (self()->removeMetaDataRangeFromHash(_cachedHashTable, metaData, startPC, endPC) == 0);
+      removeSuccess = (self()->removeMetaDataRangeFromHash(table, metaData, startPC, endPC) == 0);
       }
 
    return removeSuccess;
@@ -197,19 +173,36 @@ CodeMetaDataManager::removeRange(
 
 
 // protected
-void
-CodeMetaDataManager::updateCache(uintptr_t currentPC)
+TR::MetaDataHashTable *
+CodeMetaDataManager::findHashTable(uintptr_t pc)
    {
-   TR_ASSERT(currentPC > 0, "Attempting to find a code cache's metaData hash table for a NULL PC.");
-   if (currentPC != _cachedPC)
-      {
-      _retrievedMetaDataCache = NULL;
-      _cachedPC = currentPC;
-      _cachedHashTable =
-         static_cast<TR::MetaDataHashTable *>(static_cast<void *>(avl_search(_metaDataAVL, currentPC) ) );
+   TR_ASSERT(pc > 0, "Attempting to find a code cache's metaData hash table for a NULL PC.");
+   HashTableArray *array = _hashTables;
+   if (!array)
+      return NULL;
+
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+   // Pairs with the write barrier in addCodeCache, so the contents of the
+   // array are seen no older than the pointer to it.
+   //
+   VM_AtomicSupport::readBarrier();
+#endif
 
-      TR_ASSERT(_cachedHashTable, "Either we lost a code cache or we attempted to find a hash table for a non-code cache startPC: Searched for %p", currentPC);
+   uintptr_t low = 0;
+   uintptr_t high = array->_numTables;
+   while (low < high)
+      {
+      uintptr_t mid = low + (high - low) / 2;
+      TR::MetaDataHashTable *table = array->_tables[mid];
+      if (pc < table->start)
+         high = mid;
+      else if (pc >= table->end)
+         low = mid + 1;
+      else
+         return table;
       }
+
+   return NULL;
    }
 
 #undef LOW_BIT_SET
@@ -594,15 +587,64 @@ CodeMetaDataManager::addCodeCache(
          (uintptr_t) (codeCache->segment()->segmentBase()),
          (uintptr_t) (codeCache->segment()->segmentTop()) );
 
-   if (newTable)
+   if (!newTable)
+      return NULL;
+
+   // Publish a copy of the sorted range array with the new table added. The
+   // array being replaced may still be in use by lookups, so it is retired
+   // rather than freed.
+   //
+   while (true)
       {
-      avl_insert(_metaDataAVL, (J9AVLTreeNode *) newTable);
+      HashTableArray *oldArray = _hashTables;
+      uintptr_t oldNumTables = oldArray ? oldArray->_numTables : 0;
+
+      HashTableArray *newArray = self()->allocateHashTableArray(oldNumTables + 1);
+      if (!newArray)
+         return NULL;
+
+      uintptr_t i = 0;
+      for (; i < oldNumTables && oldArray->_tables[i]->start < newTable->start; ++i)
+         newArray->_tables[i] = oldArray->_tables[i];
+      newArray->_tables[i] = newTable;
+      for (; i < oldNumTables; ++i)
+         newArray->_tables[i + 1] = oldArray->_tables[i];
+      newArray->_retired = oldArray;
+
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+      VM_AtomicSupport::writeBarrier();
+      if (VM_AtomicSupport::lockCompareExchange((volatile uintptr_t *) &_hashTables, (uintptr_t) oldArray, (uintptr_t) newArray) == (uintptr_t) oldArray)
+         break;
+#else
+      _hashTables = newArray;
+      break;
+#endif
+
+      TR_Memory::jitPersistentFree(newArray);
       }
 
    return newTable;
    }
 
 
+void
+CodeMetaDataManager::freeRetiredHashTableArrays()
+   {
+   HashTableArray *current = _hashTables;
+   if (!current)
+      return;
+
+   HashTableArray *retired = current->_retired;
+   current->_retired = NULL;
+   while (retired)
+      {
+      HashTableArray *next = retired->_retired;
+      TR_Memory::jitPersistentFree(retired);
+      retired = next;
+      }
+   }
+
+
 // protected, secondary
 TR::MetaDataHashTable *
 CodeMetaDataManager::allocateCodeMetaDataHash(uintptr_t start, uintptr_t end)
@@ -642,38 +684,4 @@ CodeMetaDataManager::allocateCodeMetaDataHash(uintptr_t start, uintptr_t end)
    return table;
    }
 
-extern "C"
-{
-
-intptr_t
-avl_jit_metadata_insertionCompare(J9AVLTree *tree, TR::MetaDataHashTable *insertNode, TR::MetaDataHashTable *walkNode)
-   {
-   if (walkNode->start > insertNode->start)
-      {
-      return 1;
-      }
-   else if (walkNode->start < insertNode->start)
-      {
-      return -1;
-      }
-
-   return 0;
-   }
-
-
-intptr_t
-avl_jit_metadata_searchCompare(J9AVLTree *tree, uintptr_t searchValue, TR::MetaDataHashTable *walkNode)
-   {
-   if (searchValue >= walkNode->end)
-      return -1;
-
-   if (searchValue < walkNode->start)
-      return 1;
-
-   return 0;
-   }
-
-} // extern "C"
-
-
 }
@@ -40,7 +40,6 @@ namespace OMR { typedef OMR::MetaDataHashTable MetaDataHashTableConnector; }
 #include <stdint.h>
 #include "env/TRMemory.hpp"
 #include "infra/Annotations.hpp"
-#include "j9nongenerated.h"
 
 namespace TR { class CodeCache; }
 namespace TR { class CodeMetaDataManager; }
@@ -60,6 +59,15 @@ namespace OMR
  *
  * The CodeMetaDataManager only manages pointers; It takes no ownership of the
  * POD pointers provided to it.
+ *
+ * Lookups do not take a lock and may run concurrently with each other and
+ * with a single updater. The hash tables of the code caches are found
+ * through a sorted array of their ranges that is never modified once
+ * published: registering a code cache publishes a new copy of the array and
+ * retires the old one, which is only freed by freeRetiredHashTableArrays
+ * once no lookup can still be using it. Within a hash table, buckets are
+ * updated with write barriers so a concurrent lookup sees either the old or
+ * the new chain.
  */
 class OMR_EXTENSIBLE CodeMetaDataManager
    {
@@ -121,10 +129,10 @@ class OMR_EXTENSIBLE CodeMetaDataManager
 
    /**
     * @brief Attempts to find a registered metadata for a given metadata's startPC.
-    * 
-    * Note: findMetaDataForPC does not locally acquire the JIT metadata monitor.
-    * Users must first manually acquire the monitor or go through another function
-    * that does.
+    *
+    * Note: findMetaDataForPC does not acquire any lock and has no side
+    * effects, so it may be called concurrently from any number of threads
+    * (for example, while walking stacks).
     *
     * @param pc The PC for which we require the JIT metadata .
     * @return If an metadata for a given startPC is successfully found, returns
@@ -141,6 +149,14 @@ class OMR_EXTENSIBLE CodeMetaDataManager
     */
    TR::MetaDataHashTable *addCodeCache(TR::CodeCache *codeCache);
 
+   /**
+    * @brief Frees the code cache range arrays replaced by addCodeCache.
+    *
+    * Must only be called when no thread can be in the middle of a lookup,
+    * e.g. while all threads are stopped at a safepoint.
+    */
+   void freeRetiredHashTableArrays();
+
 
    protected:
 
@@ -187,16 +203,12 @@ class OMR_EXTENSIBLE CodeMetaDataManager
 
 
    /**
-    * @brief Determines if the current metadataManager query is using the same
-    * metadata as the previous query, and if not, searches for and retrieves the
-    * new metadata's code cache's hash table.
+    * @brief Finds the hash table of the code cache containing a PC.
     *
-    * Note this method expects to be called via another method in the metadata  
-    * manager and thus does not acquire the metadata manager's monitor.
-    *
-    * @param currentPC The PC we are currently inquiring about.
+    * @param pc The PC we are currently inquiring about.
+    * @return The hash table, or NULL if the PC is not in a registered code cache.
     */
-   void updateCache(uintptr_t currentPC);
+   TR::MetaDataHashTable *findHashTable(uintptr_t pc);
 
    TR::MethodMetaDataPOD *findMetaDataInHash(
       TR::MetaDataHashTable *table,
@@ -230,27 +242,29 @@ class OMR_EXTENSIBLE CodeMetaDataManager
       uintptr_t start,
       uintptr_t end);
 
-   J9AVLTree *allocateMetaDataAVL();
+   /**
+    * The hash tables of all code caches, sorted by start address. An array is
+    * never modified once it has been published in _hashTables.
+    */
+   struct HashTableArray
+      {
+      uintptr_t              _numTables;
+      HashTableArray        *_retired;    ///< the array this one replaced
+      TR::MetaDataHashTable *_tables[1];
+      };
+
+   HashTableArray *allocateHashTableArray(uintptr_t numTables);
 
    // Singleton: Protected to allow manipulation of singleton pointer 
    // in test cases. 
    static TR::CodeMetaDataManager *_codeMetaDataManager;
 
-   J9AVLTree *_metaDataAVL;
-
-   private:
-
-   mutable uintptr_t _cachedPC;
-   mutable TR::MetaDataHashTable *_cachedHashTable;
-   mutable TR::MethodMetaDataPOD *_retrievedMetaDataCache;
-
-
+   HashTableArray * volatile _hashTables;
    };
 
 
 struct OMR_EXTENSIBLE MetaDataHashTable
    {
-   J9AVLTreeNode parentAVLTreeNode;
    uintptr_t *buckets;
    uintptr_t start;
    uintptr_t end;
@@ -261,14 +275,6 @@ struct OMR_EXTENSIBLE MetaDataHashTable
    };
 
 
-extern "C"
-{
-intptr_t avl_jit_metadata_insertionCompare(J9AVLTree *tree, TR::MetaDataHashTable *insertNode, TR::MetaDataHashTable *walkNode);
-
-intptr_t avl_jit_metadata_searchCompare(J9AVLTree *tree, uintptr_t searchValue, TR::MetaDataHashTable *walkNode);
-}
-
-
 }
 
 #endif
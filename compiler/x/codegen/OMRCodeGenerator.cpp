@@ -1630,6 +1630,28 @@ bool OMR::X86::CodeGenerator::isReturnInstruction(TR::Instruction *instr)
       return false;
    }
 
+bool OMR::X86::CodeGenerator::updateCFAOffset(TR::Instruction *instr, int32_t &cfaOffset)
+   {
+   // Frames addressed off a dedicated frame pointer are not tracked by the
+   // VFP state once the frame pointer has been established
+   //
+   if (self()->getLinkage()->getProperties().getAlwaysDedicateFramePointerRegister())
+      return false;
+
+   // Replay the VFP state tracking done during binary encoding. Before the
+   // prologue, the VFP is the stack pointer on entry.
+   //
+   if (instr == self()->getFirstInstruction())
+      self()->initializeVFPState(TR::RealRegister::esp, 0);
+
+   instr->adjustVFPState(&_vfpState, self());
+   if (_vfpState._register != TR::RealRegister::esp)
+      return false;
+
+   cfaOffset = _vfpState._displacement + (self()->comp()->target().is64Bit() ? 8 : 4);
+   return true;
+   }
+
 bool OMR::X86::CodeGenerator::isBranchInstruction(TR::Instruction *instr)
    {
    return (instr->getOpCode().isBranchOp() || instr->getOpCode().getOpCodeValue() == TR::InstOpCode::CALLImm4 ? true : false);
@@ -404,6 +404,8 @@ class OMR_EXTENSIBLE CodeGenerator : public OMR::CodeGenerator
    bool isReturnInstruction(TR::Instruction *instr);
    bool isBranchInstruction(TR::Instruction *instr);
 
+   virtual bool updateCFAOffset(TR::Instruction *instr, int32_t &cfaOffset);
+
    TR::SymbolReference *getNanoTimeTemp();
 
    int32_t branchDisplacementToHelperOrTrampoline(uint8_t *nextInstructionAddress, TR::SymbolReference *helper);
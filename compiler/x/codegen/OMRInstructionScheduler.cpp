@@ -0,0 +1,339 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "codegen/InstructionScheduler.hpp"
+
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/MemoryReference.hpp"
+#include "codegen/RealRegister.hpp"
+#include "codegen/Register.hpp"
+#include "compile/Compilation.hpp"
+#include "env/CompilerEnv.hpp"
+#include "x/codegen/X86Instruction.hpp"
+
+// Resource number of the condition flags; real registers use their register number
+//
+#define FLAGS_RESOURCE ((int32_t)TR::RealRegister::NumRegisters)
+
+// Port masks follow the execution port numbering of each microarchitecture.
+// A mask of 0 allows any port.
+//
+static const OMR::X86::InstructionScheduler::MachineModel skylakeModel =
+   {
+   "Skylake", 4,
+   //  ALU   IMul  Div   Load  Store FPAdd FPMul FPDiv VALU  VMul
+   {   1,    3,    26,   5,    4,    4,    4,    14,   1,    5    },
+   {   0x63, 0x02, 0x01, 0x0C, 0x10, 0x03, 0x03, 0x01, 0x23, 0x03 }
+   };
+
+static const OMR::X86::InstructionScheduler::MachineModel haswellModel =
+   {
+   "Haswell", 4,
+   {   1,    3,    26,   5,    4,    3,    5,    14,   1,    5    },
+   {   0x63, 0x02, 0x01, 0x0C, 0x10, 0x02, 0x03, 0x01, 0x23, 0x01 }
+   };
+
+static const OMR::X86::InstructionScheduler::MachineModel sandyBridgeModel =
+   {
+   "SandyBridge", 4,
+   {   1,    3,    26,   5,    4,    3,    5,    14,   1,    5    },
+   {   0x23, 0x02, 0x01, 0x0C, 0x10, 0x02, 0x01, 0x01, 0x23, 0x01 }
+   };
+
+static const OMR::X86::InstructionScheduler::MachineModel nehalemModel =
+   {
+   "Nehalem", 4,
+   {   1,    3,    26,   4,    4,    3,    5,    20,   1,    5    },
+   {   0x23, 0x02, 0x01, 0x04, 0x18, 0x02, 0x01, 0x01, 0x23, 0x01 }
+   };
+
+static const OMR::X86::InstructionScheduler::MachineModel amdFamily15hModel =
+   {
+   "AMDFamily15h", 4,
+   {   1,    4,    30,   4,    4,    5,    5,    20,   2,    5    },
+   {   0x03, 0x02, 0x01, 0x0C, 0x0C, 0x30, 0x30, 0x20, 0xC0, 0x10 }
+   };
+
+static const OMR::X86::InstructionScheduler::MachineModel genericModel =
+   {
+   "generic x86", 4,
+   {   1,    3,    26,   4,    4,    3,    5,    14,   1,    5    },
+   {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0    }
+   };
+
+OMR::X86::InstructionScheduler::InstructionScheduler(TR::Compilation* comp) :
+   OMR::InstructionScheduler(comp)
+   {}
+
+const OMR::X86::InstructionScheduler::MachineModel *
+OMR::X86::InstructionScheduler::getMachineModel()
+   {
+   switch (comp()->target().cpu.getProcessorDescription().processor)
+      {
+      case OMR_PROCESSOR_X86_INTELSKYLAKE:
+         return &skylakeModel;
+      case OMR_PROCESSOR_X86_INTELHASWELL:
+      case OMR_PROCESSOR_X86_INTELBROADWELL:
+         return &haswellModel;
+      case OMR_PROCESSOR_X86_INTELSANDYBRIDGE:
+      case OMR_PROCESSOR_X86_INTELIVYBRIDGE:
+         return &sandyBridgeModel;
+      case OMR_PROCESSOR_X86_INTELCORE2:
+      case OMR_PROCESSOR_X86_INTELNEHALEM:
+      case OMR_PROCESSOR_X86_INTELWESTMERE:
+         return &nehalemModel;
+      case OMR_PROCESSOR_X86_AMDFAMILY15H:
+         return &amdFamily15hModel;
+      default:
+         return &genericModel;
+      }
+   }
+
+bool
+OMR::X86::InstructionScheduler::addRegister(TR::Register *reg, ResourceSet &resources)
+   {
+   if (reg == NULL)
+      return true;
+
+   TR::RealRegister *realReg = reg->getRealRegister();
+   if (realReg == NULL)
+      return false;
+
+   // Stack pointer adjustments change the meaning of every VFP-relative memory reference
+   //
+   if (realReg->getRegisterNumber() == TR::RealRegister::esp)
+      return false;
+
+   resources.set(realReg->getRegisterNumber());
+   return true;
+   }
+
+OMR::X86::InstructionScheduler::InstructionClass
+OMR::X86::InstructionScheduler::getInstructionClass(TR::Instruction *instr)
+   {
+   TR::InstOpCode &op = instr->getOpCode();
+   TR::InstOpCode::Mnemonic mnemonic = op.getOpCodeValue();
+
+   if (mnemonic >= TR::InstOpCode::VFMADD132SSRegRegReg && mnemonic <= TR::InstOpCode::VFNMSUB231SDRegRegMem)
+      return FloatingPointMultiply;
+
+   switch (mnemonic)
+      {
+      case TR::InstOpCode::IMUL2RegReg:
+      case TR::InstOpCode::IMUL4RegReg:
+      case TR::InstOpCode::IMUL8RegReg:
+      case TR::InstOpCode::IMUL2RegMem:
+      case TR::InstOpCode::IMUL4RegMem:
+      case TR::InstOpCode::IMUL8RegMem:
+      case TR::InstOpCode::IMUL2RegRegImm2:
+      case TR::InstOpCode::IMUL2RegRegImms:
+      case TR::InstOpCode::IMUL4RegRegImm4:
+      case TR::InstOpCode::IMUL8RegRegImm4:
+      case TR::InstOpCode::IMUL4RegRegImms:
+      case TR::InstOpCode::IMUL8RegRegImms:
+      case TR::InstOpCode::IMUL2RegMemImm2:
+      case TR::InstOpCode::IMUL2RegMemImms:
+      case TR::InstOpCode::IMUL4RegMemImm4:
+      case TR::InstOpCode::IMUL8RegMemImm4:
+      case TR::InstOpCode::IMUL4RegMemImms:
+      case TR::InstOpCode::IMUL8RegMemImms:
+         return IntegerMultiply;
+
+      case TR::InstOpCode::ADDSSRegReg:
+      case TR::InstOpCode::ADDSSRegMem:
+      case TR::InstOpCode::ADDPSRegReg:
+      case TR::InstOpCode::ADDPSRegMem:
+      case TR::InstOpCode::ADDSDRegReg:
+      case TR::InstOpCode::ADDSDRegMem:
+      case TR::InstOpCode::ADDPDRegReg:
+      case TR::InstOpCode::ADDPDRegMem:
+      case TR::InstOpCode::SUBSSRegReg:
+      case TR::InstOpCode::SUBSSRegMem:
+      case TR::InstOpCode::SUBPSRegReg:
+      case TR::InstOpCode::SUBPSRegMem:
+      case TR::InstOpCode::SUBSDRegReg:
+      case TR::InstOpCode::SUBSDRegMem:
+      case TR::InstOpCode::SUBPDRegReg:
+      case TR::InstOpCode::SUBPDRegMem:
+      case TR::InstOpCode::CVTSI2SSRegReg4:
+      case TR::InstOpCode::CVTSI2SSRegReg8:
+      case TR::InstOpCode::CVTSI2SSRegMem:
+      case TR::InstOpCode::CVTSI2SSRegMem8:
+      case TR::InstOpCode::CVTSI2SDRegReg4:
+      case TR::InstOpCode::CVTSI2SDRegReg8:
+      case TR::InstOpCode::CVTSI2SDRegMem:
+      case TR::InstOpCode::CVTSI2SDRegMem8:
+      case TR::InstOpCode::CVTTSS2SIReg4Reg:
+      case TR::InstOpCode::CVTTSS2SIReg8Reg:
+      case TR::InstOpCode::CVTTSS2SIReg4Mem:
+      case TR::InstOpCode::CVTTSS2SIReg8Mem:
+      case TR::InstOpCode::CVTTSD2SIReg4Reg:
+      case TR::InstOpCode::CVTTSD2SIReg8Reg:
+      case TR::InstOpCode::CVTTSD2SIReg4Mem:
+      case TR::InstOpCode::CVTTSD2SIReg8Mem:
+      case TR::InstOpCode::CVTSS2SDRegReg:
+      case TR::InstOpCode::CVTSS2SDRegMem:
+      case TR::InstOpCode::CVTSD2SSRegReg:
+      case TR::InstOpCode::CVTSD2SSRegMem:
+         return FloatingPointAdd;
+
+      case TR::InstOpCode::MULSSRegReg:
+      case TR::InstOpCode::MULSSRegMem:
+      case TR::InstOpCode::MULPSRegReg:
+      case TR::InstOpCode::MULPSRegMem:
+      case TR::InstOpCode::MULSDRegReg:
+      case TR::InstOpCode::MULSDRegMem:
+      case TR::InstOpCode::MULPDRegReg:
+      case TR::InstOpCode::MULPDRegMem:
+         return FloatingPointMultiply;
+
+      case TR::InstOpCode::DIVSSRegReg:
+      case TR::InstOpCode::DIVSSRegMem:
+      case TR::InstOpCode::DIVPSRegReg:
+      case TR::InstOpCode::DIVPSRegMem:
+      case TR::InstOpCode::DIVSDRegReg:
+      case TR::InstOpCode::DIVSDRegMem:
+      case TR::InstOpCode::DIVPDRegReg:
+      case TR::InstOpCode::DIVPDRegMem:
+      case TR::InstOpCode::SQRTSSRegReg:
+      case TR::InstOpCode::SQRTSDRegReg:
+         return FloatingPointDivide;
+
+      case TR::InstOpCode::PMULLWRegReg:
+      case TR::InstOpCode::PMULLWRegMem:
+      case TR::InstOpCode::PMULLDRegReg:
+      case TR::InstOpCode::PMULLDRegMem:
+         return VectorMultiply;
+
+      default:
+         break;
+      }
+
+   if (op.hasXMMTarget() || op.hasXMMSource())
+      return VectorALU;
+
+   return IntegerALU;
+   }
+
+bool
+OMR::X86::InstructionScheduler::getEffects(TR::Instruction *instr, InstructionEffects &effects)
+   {
+   TR::InstOpCode &op = instr->getOpCode();
+
+   if (instr->getDependencyConditions() != NULL || instr->needsGCMap())
+      return false;
+
+   if (op.isBranchOp() || op.isCallOp() || op.isPseudoOp() || op.isPushOp() || op.isPopOp() || op.info().isX87())
+      return false;
+
+   if (op.targetRegIsImplicit() || op.sourceRegIsImplicit())
+      return false;
+
+   if (op.supportsLockPrefix() || op.needsXacquirePrefix() || op.needsXreleasePrefix() ||
+       instr->needsLockPrefix() || instr->needsRepPrefix())
+      return false;
+
+   bool hasRegisterTarget;
+   switch (instr->getKind())
+      {
+      case TR::Instruction::IsRegReg:
+      case TR::Instruction::IsRegRegImm:
+      case TR::Instruction::IsRegRegReg:
+      case TR::Instruction::IsRegImm:
+      case TR::Instruction::IsRegMem:
+      case TR::Instruction::IsRegMemImm:
+      case TR::Instruction::IsRegRegMem:
+         hasRegisterTarget = true;
+         break;
+      case TR::Instruction::IsMemReg:
+      case TR::Instruction::IsMemRegImm:
+      case TR::Instruction::IsMemImm:
+         hasRegisterTarget = false;
+         break;
+      default:
+         return false;
+      }
+
+   bool modifiesTarget = op.modifiesTarget() != 0;
+   bool usesTarget = op.usesTarget() || !modifiesTarget || op.hasByteTarget() || op.hasShortTarget();
+
+   if (hasRegisterTarget)
+      {
+      TR::Register *target = instr->getTargetRegister();
+      if (modifiesTarget && !addRegister(target, effects._defs))
+         return false;
+      if (usesTarget && !addRegister(target, effects._uses))
+         return false;
+      }
+
+   TR::Register *sources[] = { instr->getSourceRegister(), instr->getSource2ndRegister() };
+   for (int32_t i = 0; i < 2; ++i)
+      {
+      if (!addRegister(sources[i], effects._uses))
+         return false;
+      if (op.modifiesSource() && !addRegister(sources[i], effects._defs))
+         return false;
+      }
+
+   TR::MemoryReference *mr = instr->getMemoryReference();
+   if (mr != NULL)
+      {
+      if (mr->getUnresolvedDataSnippet() != NULL)
+         return false;
+      if (!addRegister(mr->getBaseRegister(), effects._uses) || !addRegister(mr->getIndexRegister(), effects._uses))
+         return false;
+
+      if (hasRegisterTarget)
+         {
+         switch (op.getOpCodeValue())
+            {
+            case TR::InstOpCode::LEA2RegMem:
+            case TR::InstOpCode::LEA4RegMem:
+            case TR::InstOpCode::LEA8RegMem:
+               break;
+            default:
+               effects._readsMemory = true;
+               effects._writesMemory = op.modifiesSource() != 0;
+               break;
+            }
+         }
+      else
+         {
+         effects._readsMemory = usesTarget;
+         effects._writesMemory = modifiesTarget;
+         }
+      }
+
+   if (op.modifiesSomeArithmeticFlags())
+      effects._defs.set(FLAGS_RESOURCE);
+   if (op.testsSomeFlag())
+      effects._uses.set(FLAGS_RESOURCE);
+
+   effects._class = getInstructionClass(instr);
+   if (effects._writesMemory)
+      effects._class = Store;
+   else if (effects._readsMemory && (effects._class == IntegerALU || effects._class == VectorALU))
+      effects._class = Load;
+
+   return true;
+   }
@@ -219,6 +219,42 @@ OMR::X86::CPU::supportsAVX()
    return self()->supportsFeature(OMR_FEATURE_X86_AVX) && self()->supportsFeature(OMR_FEATURE_X86_OSXSAVE);
    }
 
+bool
+OMR::X86::CPU::hostSupportsAVX2()
+   {
+   // Query the host directly rather than a detected TR::CPU: AVX2 is not part
+   // of the feature set the compiler enables for target or relocatable code,
+   // so it is also masked out of the cached TR_X86ProcessorInfo flags
+   //
+   if (TR::Compiler->omrPortLib == NULL)
+      {
+      int CPUInfo[4];
+      cpuid(CPUInfo, 0);
+      if (CPUInfo[0] < 7)
+         return false;
+
+      cpuid(CPUInfo, 1);
+      if (!(CPUInfo[2] & TR_OSXSAVE))
+         return false;
+
+      cpuidex(CPUInfo, 7, 0);
+      if (!(CPUInfo[1] & TR_AVX2))
+         return false;
+      }
+   else
+      {
+      OMRPORT_ACCESS_FROM_OMRPORT(TR::Compiler->omrPortLib);
+      OMRProcessorDesc processorDescription;
+      omrsysinfo_get_processor_description(&processorDescription);
+
+      if (TRUE != omrsysinfo_processor_has_feature(&processorDescription, OMR_FEATURE_X86_AVX2) ||
+          TRUE != omrsysinfo_processor_has_feature(&processorDescription, OMR_FEATURE_X86_OSXSAVE))
+         return false;
+      }
+
+   return (6 & _xgetbv(0)) == 6 && !feGetEnv("TR_DisableAVX"); // '6' = mask for XCR0[2:1]='11b' (XMM state and YMM state are enabled)
+   }
+
 bool
 OMR::X86::CPU::is(OMRProcessorArchitecture p)
    {
@@ -373,6 +409,8 @@ OMR::X86::CPU::supports_feature_test(uint32_t feature)
          return TR::CodeGenerator::getX86ProcessorInfo().hasThermalMonitor() == ans;
       case OMR_FEATURE_X86_AVX:
          return true;
+      case OMR_FEATURE_X86_AVX2:
+         return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX2() == ans;
       default:
          return false;
       }
@@ -101,6 +101,13 @@ public:
    bool prefersMultiByteNOP();
    bool supportsAVX();
 
+   /**
+    * @brief Answers whether the host the compiler is running on can execute
+    *        AVX2 instructions. This is used for compiler-internal routines
+    *        only and does not depend on the target processor description.
+    */
+   static bool hostSupportsAVX2();
+
    /**
     * It is generally safe to assume that all modern operating systems
     * support preserving the SSE state.  However, to be strictly
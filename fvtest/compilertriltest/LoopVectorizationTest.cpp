@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+#include "compile/Compilation.hpp"
+#include "il/Node.hpp"
+#include "infra/ILWalk.hpp"
+#include "ras/IlVerifier.hpp"
+
+#include <vector>
+
+/**
+ * Checks whether the loop was (or was not) rewritten into vector IL.
+ *
+ * Vector code is only required on x86-64, where every opcode used by these
+ * tests is supported; elsewhere only the results of the compiled code are
+ * checked.
+ */
+class VectorLoopIlVerifier : public TR::IlVerifier
+   {
+   public:
+   VectorLoopIlVerifier(bool expectVectors) : _expectVectors(expectVectors) {}
+
+   int32_t verify(TR::ResolvedMethodSymbol *sym)
+      {
+      if (!sym->comp()->target().cpu.isX86() || !sym->comp()->target().is64Bit())
+         return 0;
+
+      bool foundVectors = false;
+      for (TR::PreorderNodeIterator iter(sym->getFirstTreeTop(), sym->comp()); iter.currentTree(); ++iter)
+         {
+         if (iter.currentNode()->getOpCode().isVector())
+            foundVectors = true;
+         }
+
+      return foundVectors == _expectVectors ? 0 : 1;
+      }
+
+   private:
+   bool _expectVectors;
+   };
+
+class LoopVectorizationTest : public TRTest::JitOptTest
+   {
+   public:
+   LoopVectorizationTest()
+      {
+      addOptimization(OMR::inductionVariableAnalysis);
+      addOptimization(OMR::loopVectorization);
+      }
+   };
+
+/*
+ * void add(int32_t *a, int32_t *b, int32_t *c, int32_t n)
+ *    {
+ *    if (n > 0)
+ *       {
+ *       int32_t i = 0;
+ *       do { c[i] = a[i] + b[i]; i++; } while (i < n);
+ *       }
+ *    }
+ */
+static const char *int32AddTrees =
+   "(method return=NoType args=[Address, Address, Address, Int32]"
+   "  (block name=\"entry\""
+   "    (istore temp=\"i\" (iconst 0))"
+   "    (ificmple target=\"exit\" (iload parm=3) (iconst 0)))"
+   "  (block name=\"loop\""
+   "    (istorei offset=0"
+   "      (aladd (aload parm=2) (lmul (i2l (iload temp=\"i\")) (lconst 4)))"
+   "      (iadd"
+   "        (iloadi offset=0 (aladd (aload parm=0) (lmul (i2l (iload temp=\"i\")) (lconst 4))))"
+   "        (iloadi offset=0 (aladd (aload parm=1) (lmul (i2l (iload temp=\"i\")) (lconst 4))))))"
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))"
+   "    (ificmplt target=\"loop\" (iload temp=\"i\") (iload parm=3)))"
+   "  (block name=\"exit\""
+   "    (return)))";
+
+TEST_F(LoopVectorizationTest, Int32AddWithRemainder)
+   {
+   auto trees = parseString(int32AddTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   VectorLoopIlVerifier verifier(true);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << int32AddTrees;
+
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t *, int32_t *, int32_t)>();
+
+   const int32_t sizes[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 100, 1001 };
+   for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+      {
+      int32_t n = sizes[s];
+      std::vector<int32_t> a(n + 1), b(n + 1), c(n + 1, -1);
+      for (int32_t i = 0; i < n; ++i)
+         {
+         a[i] = i * 3 - 7;
+         b[i] = 1000 - i * i;
+         }
+
+      entry_point(a.data(), b.data(), c.data(), n);
+
+      for (int32_t i = 0; i < n; ++i)
+         EXPECT_EQ(a[i] + b[i], c[i]) << "n = " << n << ", i = " << i;
+      EXPECT_EQ(-1, c[n]) << "store past the end for n = " << n;
+      }
+   }
+
+TEST_F(LoopVectorizationTest, Int32AddWithOverlappingArrays)
+   {
+   auto trees = parseString(int32AddTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << int32AddTrees;
+
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t *, int32_t *, int32_t)>();
+
+   // The destination starts 0..5 elements after the first source; every
+   // distance below a vector length must fall back to the scalar loop
+   //
+   const int32_t n = 37;
+   for (int32_t distance = 0; distance <= 5; ++distance)
+      {
+      std::vector<int32_t> memory(n + distance), expected(n + distance), b(n);
+      for (int32_t i = 0; i < n + distance; ++i)
+         memory[i] = expected[i] = i + 1;
+      for (int32_t i = 0; i < n; ++i)
+         b[i] = 10 * i;
+
+      for (int32_t i = 0; i < n; ++i)
+         expected[i + distance] = expected[i] + b[i];
+
+      entry_point(memory.data(), b.data(), memory.data() + distance, n);
+
+      for (int32_t i = 0; i < n + distance; ++i)
+         EXPECT_EQ(expected[i], memory[i]) << "distance = " << distance << ", i = " << i;
+      }
+   }
+
+/*
+ * int32_t sum(int32_t *a, int32_t n)
+ *    {
+ *    int32_t s = 0, i = 0;
+ *    do { s = s + a[i]; i++; } while (i < n);
+ *    return s;
+ *    }
+ */
+TEST_F(LoopVectorizationTest, Int32SumReduction)
+   {
+   auto inputTrees =
+      "(method return=Int32 args=[Address, Int32]"
+      "  (block name=\"entry\""
+      "    (istore temp=\"s\" (iconst 0))"
+      "    (istore temp=\"i\" (iconst 0)))"
+      "  (block name=\"loop\""
+      "    (istore temp=\"s\""
+      "      (iadd"
+      "        (iload temp=\"s\")"
+      "        (iloadi offset=0 (aladd (aload parm=0) (lmul (i2l (iload temp=\"i\")) (lconst 4))))))"
+      "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))"
+      "    (ificmplt target=\"loop\" (iload temp=\"i\") (iload parm=1)))"
+      "  (block name=\"exit\""
+      "    (ireturn (iload temp=\"s\"))))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   VectorLoopIlVerifier verifier(true);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t *, int32_t)>();
+
+   const int32_t sizes[] = { 1, 2, 3, 4, 5, 8, 11, 64, 257 };
+   for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+      {
+      int32_t n = sizes[s];
+      std::vector<int32_t> a(n);
+      int32_t expected = 0;
+      for (int32_t i = 0; i < n; ++i)
+         {
+         a[i] = (i % 7) * 1000 - i;
+         expected += a[i];
+         }
+
+      EXPECT_EQ(expected, entry_point(a.data(), n)) << "n = " << n;
+      }
+   }
+
+/*
+ * void axpy(double *x, double *y, int32_t n, double k)
+ *    {
+ *    int32_t i = 0;
+ *    do { y[i] = x[i] * k + y[i]; i++; } while (i < n);
+ *    }
+ */
+TEST_F(LoopVectorizationTest, DoubleMultiplyAddWithInvariant)
+   {
+   auto inputTrees =
+      "(method return=NoType args=[Address, Address, Int32, Double]"
+      "  (block name=\"entry\""
+      "    (istore temp=\"i\" (iconst 0)))"
+      "  (block name=\"loop\""
+      "    (dstorei offset=0"
+      "      (aladd (aload parm=1) (lmul (i2l (iload temp=\"i\")) (lconst 8)))"
+      "      (dadd"
+      "        (dmul"
+      "          (dloadi offset=0 (aladd (aload parm=0) (lmul (i2l (iload temp=\"i\")) (lconst 8))))"
+      "          (dload parm=3))"
+      "        (dloadi offset=0 (aladd (aload parm=1) (lmul (i2l (iload temp=\"i\")) (lconst 8))))))"
+      "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))"
+      "    (ificmplt target=\"loop\" (iload temp=\"i\") (iload parm=2)))"
+      "  (block name=\"exit\""
+      "    (return)))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   VectorLoopIlVerifier verifier(true);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<void (*)(double *, double *, int32_t, double)>();
+
+   const int32_t sizes[] = { 1, 2, 3, 10, 33 };
+   for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+      {
+      int32_t n = sizes[s];
+      std::vector<double> x(n), y(n), expected(n);
+      for (int32_t i = 0; i < n; ++i)
+         {
+         x[i] = i * 0.5;
+         y[i] = 100.0 - i;
+         expected[i] = x[i] * 2.5 + y[i];
+         }
+
+      entry_point(x.data(), y.data(), n, 2.5);
+
+      for (int32_t i = 0; i < n; ++i)
+         EXPECT_DOUBLE_EQ(expected[i], y[i]) << "n = " << n << ", i = " << i;
+      }
+   }
+
+/*
+ * a[i + 1] = a[i] + 1 carries a dependence to the next iteration and must be
+ * left alone.
+ */
+TEST_F(LoopVectorizationTest, LoopCarriedDependenceNotVectorized)
+   {
+   auto inputTrees =
+      "(method return=NoType args=[Address, Int32]"
+      "  (block name=\"entry\""
+      "    (istore temp=\"i\" (iconst 0)))"
+      "  (block name=\"loop\""
+      "    (istorei offset=4"
+      "      (aladd (aload parm=0) (lmul (i2l (iload temp=\"i\")) (lconst 4)))"
+      "      (iadd"
+      "        (iloadi offset=0 (aladd (aload parm=0) (lmul (i2l (iload temp=\"i\")) (lconst 4))))"
+      "        (iconst 1)))"
+      "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))"
+      "    (ificmplt target=\"loop\" (iload temp=\"i\") (iload parm=1)))"
+      "  (block name=\"exit\""
+      "    (return)))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   VectorLoopIlVerifier verifier(false);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t)>();
+
+   std::vector<int32_t> a(21, 0);
+   a[0] = 5;
+   entry_point(a.data(), 20);
+   for (int32_t i = 0; i <= 20; ++i)
+      EXPECT_EQ(5 + i, a[i]) << "i = " << i;
+   }
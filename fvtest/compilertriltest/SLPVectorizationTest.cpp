@@ -0,0 +1,265 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+#include "compile/Compilation.hpp"
+#include "il/Node.hpp"
+#include "infra/ILWalk.hpp"
+#include "ras/IlVerifier.hpp"
+
+/**
+ * Checks whether the straight line stores were (or were not) packed into
+ * vector IL.
+ *
+ * Vector code is only required on x86-64, where every opcode used by these
+ * tests is supported; elsewhere only the results of the compiled code are
+ * checked.
+ */
+class PackedStoresIlVerifier : public TR::IlVerifier
+   {
+   public:
+   PackedStoresIlVerifier(bool expectVectors) : _expectVectors(expectVectors) {}
+
+   int32_t verify(TR::ResolvedMethodSymbol *sym)
+      {
+      if (!sym->comp()->target().cpu.isX86() || !sym->comp()->target().is64Bit())
+         return 0;
+
+      bool foundVectors = false;
+      for (TR::PreorderNodeIterator iter(sym->getFirstTreeTop(), sym->comp()); iter.currentTree(); ++iter)
+         {
+         if (iter.currentNode()->getOpCode().isVector())
+            foundVectors = true;
+         }
+
+      return foundVectors == _expectVectors ? 0 : 1;
+      }
+
+   private:
+   bool _expectVectors;
+   };
+
+class SLPVectorizationTest : public TRTest::JitOptTest
+   {
+   public:
+   SLPVectorizationTest()
+      {
+      addOptimization(OMR::slpVectorization);
+      }
+   };
+
+/*
+ * void add4(int32_t *a, int32_t *b, int32_t *c)
+ *    {
+ *    c[0] = a[0] + b[0];
+ *    c[1] = a[1] + b[1];
+ *    c[2] = a[2] + b[2];
+ *    c[3] = a[3] + b[3];
+ *    }
+ */
+TEST_F(SLPVectorizationTest, Int32AddPacked)
+   {
+   auto inputTrees =
+      "(method return=NoType args=[Address, Address, Address]"
+      "  (block"
+      "    (istorei offset=0 (aladd (aload parm=2) (lconst 0))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 0))) (iloadi offset=0 (aladd (aload parm=1) (lconst 0)))))"
+      "    (istorei offset=0 (aladd (aload parm=2) (lconst 4))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 4))) (iloadi offset=0 (aladd (aload parm=1) (lconst 4)))))"
+      "    (istorei offset=0 (aladd (aload parm=2) (lconst 8))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 8))) (iloadi offset=0 (aladd (aload parm=1) (lconst 8)))))"
+      "    (istorei offset=0 (aladd (aload parm=2) (lconst 12))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 12))) (iloadi offset=0 (aladd (aload parm=1) (lconst 12)))))"
+      "    (return)))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   PackedStoresIlVerifier verifier(true);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t *, int32_t *)>();
+
+   int32_t a[4] = { 1, -2, 300000, 0x7fffffff };
+   int32_t b[4] = { 10, 20, -30, 1 };
+   int32_t c[5] = { -1, -1, -1, -1, -1 };
+   entry_point(a, b, c);
+
+   for (int32_t i = 0; i < 4; ++i)
+      EXPECT_EQ((int32_t)((uint32_t)a[i] + (uint32_t)b[i]), c[i]) << "i = " << i;
+   EXPECT_EQ(-1, c[4]) << "store past the end of the group";
+   }
+
+/*
+ * void scale2(double *a, double *c, double k)
+ *    {
+ *    c[0] = a[0] * k;
+ *    c[1] = a[1] * k;
+ *    }
+ */
+TEST_F(SLPVectorizationTest, DoubleMultiplyBySplat)
+   {
+   auto inputTrees =
+      "(method return=NoType args=[Address, Address, Double]"
+      "  (block"
+      "    (dstorei offset=0 (aladd (aload parm=1) (lconst 0))"
+      "      (dmul (dloadi offset=0 (aladd (aload parm=0) (lconst 0))) (dload parm=2)))"
+      "    (dstorei offset=0 (aladd (aload parm=1) (lconst 8))"
+      "      (dmul (dloadi offset=0 (aladd (aload parm=0) (lconst 8))) (dload parm=2)))"
+      "    (return)))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   PackedStoresIlVerifier verifier(true);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<void (*)(double *, double *, double)>();
+
+   double a[2] = { 1.5, -2.25 };
+   double c[3] = { 0.0, 0.0, 42.0 };
+   entry_point(a, c, 4.0);
+
+   EXPECT_EQ(6.0, c[0]);
+   EXPECT_EQ(-9.0, c[1]);
+   EXPECT_EQ(42.0, c[2]) << "store past the end of the group";
+   }
+
+/*
+ * void incrementInPlace(int64_t *a)
+ *    {
+ *    a[0] = a[0] + 3;
+ *    a[1] = a[1] + 3;
+ *    }
+ *
+ * Every lane reads exactly the element it stores, so the loads may be hoisted
+ * above the stores.
+ */
+TEST_F(SLPVectorizationTest, Int64InPlacePacked)
+   {
+   auto inputTrees =
+      "(method return=NoType args=[Address]"
+      "  (block"
+      "    (lstorei offset=0 (aladd (aload parm=0) (lconst 0))"
+      "      (ladd (lloadi offset=0 (aladd (aload parm=0) (lconst 0))) (lconst 3)))"
+      "    (lstorei offset=0 (aladd (aload parm=0) (lconst 8))"
+      "      (ladd (lloadi offset=0 (aladd (aload parm=0) (lconst 8))) (lconst 3)))"
+      "    (return)))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   PackedStoresIlVerifier verifier(true);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<void (*)(int64_t *)>();
+
+   int64_t a[3] = { 7, -1000000000000LL, 5 };
+   entry_point(a);
+
+   EXPECT_EQ(10, a[0]);
+   EXPECT_EQ(-999999999997LL, a[1]);
+   EXPECT_EQ(5, a[2]) << "store past the end of the group";
+   }
+
+/*
+ * The lanes mix additions and subtractions, so they are not isomorphic.
+ */
+TEST_F(SLPVectorizationTest, MixedOperationsNotPacked)
+   {
+   auto inputTrees =
+      "(method return=NoType args=[Address, Address, Address]"
+      "  (block"
+      "    (istorei offset=0 (aladd (aload parm=2) (lconst 0))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 0))) (iloadi offset=0 (aladd (aload parm=1) (lconst 0)))))"
+      "    (istorei offset=0 (aladd (aload parm=2) (lconst 4))"
+      "      (isub (iloadi offset=0 (aladd (aload parm=0) (lconst 4))) (iloadi offset=0 (aladd (aload parm=1) (lconst 4)))))"
+      "    (istorei offset=0 (aladd (aload parm=2) (lconst 8))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 8))) (iloadi offset=0 (aladd (aload parm=1) (lconst 8)))))"
+      "    (istorei offset=0 (aladd (aload parm=2) (lconst 12))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 12))) (iloadi offset=0 (aladd (aload parm=1) (lconst 12)))))"
+      "    (return)))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   PackedStoresIlVerifier verifier(false);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t *, int32_t *)>();
+
+   int32_t a[4] = { 1, 2, 3, 4 };
+   int32_t b[4] = { 10, 20, 30, 40 };
+   int32_t c[4] = { 0, 0, 0, 0 };
+   entry_point(a, b, c);
+
+   EXPECT_EQ(11, c[0]);
+   EXPECT_EQ(-18, c[1]);
+   EXPECT_EQ(33, c[2]);
+   EXPECT_EQ(44, c[3]);
+   }
+
+/*
+ * void shift(int32_t *a)
+ *    {
+ *    a[1] = a[0] + 1;
+ *    a[2] = a[1] + 1;
+ *    a[3] = a[2] + 1;
+ *    a[4] = a[3] + 1;
+ *    }
+ *
+ * Each lane reads the element stored by the previous one.
+ */
+TEST_F(SLPVectorizationTest, OverlappingStoresNotPacked)
+   {
+   auto inputTrees =
+      "(method return=NoType args=[Address]"
+      "  (block"
+      "    (istorei offset=0 (aladd (aload parm=0) (lconst 4))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 0))) (iconst 1)))"
+      "    (istorei offset=0 (aladd (aload parm=0) (lconst 8))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 4))) (iconst 1)))"
+      "    (istorei offset=0 (aladd (aload parm=0) (lconst 12))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 8))) (iconst 1)))"
+      "    (istorei offset=0 (aladd (aload parm=0) (lconst 16))"
+      "      (iadd (iloadi offset=0 (aladd (aload parm=0) (lconst 12))) (iconst 1)))"
+      "    (return)))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   PackedStoresIlVerifier verifier(false);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *)>();
+
+   int32_t a[5] = { 5, 0, 0, 0, 0 };
+   entry_point(a);
+
+   for (int32_t i = 0; i < 5; ++i)
+      EXPECT_EQ(5 + i, a[i]) << "i = " << i;
+   }
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+#include "compile/Compilation.hpp"
+#include "il/Node.hpp"
+#include "infra/ILWalk.hpp"
+#include "ras/IlVerifier.hpp"
+
+/**
+ * Checks the number of imul nodes left in the trees.
+ */
+class MultiplyCountIlVerifier : public TR::IlVerifier
+   {
+   public:
+   MultiplyCountIlVerifier(int32_t expectedMultiplies) : _expectedMultiplies(expectedMultiplies) {}
+
+   int32_t verify(TR::ResolvedMethodSymbol *sym)
+      {
+      int32_t multiplies = 0;
+      for (TR::PreorderNodeIterator iter(sym->getFirstTreeTop(), sym->comp()); iter.currentTree(); ++iter)
+         {
+         if (iter.currentNode()->getOpCodeValue() == TR::imul)
+            multiplies++;
+         }
+
+      return multiplies == _expectedMultiplies ? 0 : 1;
+      }
+
+   private:
+   int32_t _expectedMultiplies;
+   };
+
+class ValueNumberCSETest : public TRTest::JitOptTest
+   {
+   public:
+   ValueNumberCSETest()
+      {
+      addOptimization(OMR::valueNumberCSE);
+      }
+   };
+
+/*
+ * int32_t f(int32_t a, int32_t b, int32_t c)
+ *    {
+ *    if (a * b + c < 0)
+ *       return (a * b + c) - 1;
+ *    return a * b + c;
+ *    }
+ */
+TEST_F(ValueNumberCSETest, DominatedExpressionsCommoned)
+   {
+   auto inputTrees =
+      "(method return=Int32 args=[Int32, Int32, Int32]"
+      "  (block"
+      "    (ificmpge target=b2 (iadd (imul (iload parm=0) (iload parm=1)) (iload parm=2)) (iconst 0)))"
+      "  (block"
+      "    (ireturn (isub (iadd (imul (iload parm=0) (iload parm=1)) (iload parm=2)) (iconst 1))))"
+      "  (block name=b2"
+      "    (ireturn (iadd (imul (iload parm=0) (iload parm=1)) (iload parm=2)))))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   MultiplyCountIlVerifier verifier(1);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t, int32_t)>();
+   EXPECT_EQ(3 * 4 + 5, entry_point(3, 4, 5));
+   EXPECT_EQ(-3 * 4 + 5 - 1, entry_point(-3, 4, 5));
+   }
+
+/*
+ * int32_t f(int32_t a, int32_t b, int32_t c)
+ *    {
+ *    int32_t x = a * b + c;
+ *    a = a + 1;
+ *    if (x < 0)
+ *       return x;
+ *    return a * b + c;
+ *    }
+ */
+TEST_F(ValueNumberCSETest, StoreKillsExpression)
+   {
+   auto inputTrees =
+      "(method return=Int32 args=[Int32, Int32, Int32]"
+      "  (block"
+      "    (istore temp=\"a\" (iload parm=0))"
+      "    (istore temp=\"x\" (iadd (imul (iload temp=\"a\") (iload parm=1)) (iload parm=2)))"
+      "    (istore temp=\"a\" (iadd (iload temp=\"a\") (iconst 1)))"
+      "    (ificmpge target=b2 (iload temp=\"x\") (iconst 0)))"
+      "  (block"
+      "    (ireturn (iload temp=\"x\")))"
+      "  (block name=b2"
+      "    (ireturn (iadd (imul (iload temp=\"a\") (iload parm=1)) (iload parm=2)))))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   MultiplyCountIlVerifier verifier(2);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t, int32_t)>();
+   EXPECT_EQ(4 * 4 + 5, entry_point(3, 4, 5));
+   EXPECT_EQ(-3 * 4 + 5, entry_point(-3, 4, 5));
+   }
+
+/*
+ * int32_t f(int32_t a, int32_t b, int32_t c)
+ *    {
+ *    int32_t x = a * b + c;
+ *    if (x < 0)
+ *       a = 0;
+ *    return (a * b + c) + x;
+ *    }
+ */
+TEST_F(ValueNumberCSETest, JoinPointKillsExpression)
+   {
+   auto inputTrees =
+      "(method return=Int32 args=[Int32, Int32, Int32]"
+      "  (block"
+      "    (istore temp=\"a\" (iload parm=0))"
+      "    (istore temp=\"x\" (iadd (imul (iload temp=\"a\") (iload parm=1)) (iload parm=2)))"
+      "    (ificmpge target=b2 (iload temp=\"x\") (iconst 0)))"
+      "  (block"
+      "    (istore temp=\"a\" (iconst 0)))"
+      "  (block name=b2"
+      "    (ireturn (iadd (iadd (imul (iload temp=\"a\") (iload parm=1)) (iload parm=2)) (iload temp=\"x\")))))";
+
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   MultiplyCountIlVerifier verifier(2);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t, int32_t)>();
+   EXPECT_EQ(2 * (3 * 4 + 5), entry_point(3, 4, 5));
+   EXPECT_EQ(5 + (-3 * 4 + 5), entry_point(-3, 4, 5));
+   }
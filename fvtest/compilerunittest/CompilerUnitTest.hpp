@@ -83,7 +83,7 @@ public:
         _dispatchRegion(_segmentProvider, _rawAllocator),
         _trMemory(*OMR::FrontEnd::singleton().persistentMemory(), _dispatchRegion),
         _types(),
-        _options(),
+        _options(*TR::Options::getCmdLineOptions()),
         _ilGenRequest(),
         _method("compunittest", "0", "test", 0, NULL, _types.NoType, NULL, NULL),
         _comp(0, NULL, &OMR::FrontEnd::singleton(), &_method, _ilGenRequest, _options, _dispatchRegion, &_trMemory, TR_OptimizationPlan::alloc(warm)) {
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include "env/RawAllocator.hpp"
+#include "env/RecyclingRegion.hpp"
+#include "env/SystemSegmentProvider.hpp"
+
+class RecyclingRegionTest : public ::testing::Test
+   {
+   public:
+   RecyclingRegionTest() :
+      _rawAllocator(),
+      _segmentProvider(1 << 16, _rawAllocator)
+      {
+      }
+
+   TR::RawAllocator _rawAllocator;
+   TR::SystemSegmentProvider _segmentProvider;
+   };
+
+TEST_F(RecyclingRegionTest, SmallBlocksAreReusedBySize)
+   {
+   TR::RecyclingRegion region(_segmentProvider, _rawAllocator);
+   void *first = region.allocate(48);
+   void *second = region.allocate(100);
+   region.deallocate(first, 48);
+   region.deallocate(second, 100);
+
+   EXPECT_EQ(second, region.allocate(100));
+   EXPECT_EQ(first, region.allocate(40));
+   EXPECT_NE(first, region.allocate(48));
+   }
+
+TEST_F(RecyclingRegionTest, LargeBlocksAreReusedByPowerOfTwo)
+   {
+   TR::RecyclingRegion region(_segmentProvider, _rawAllocator);
+   void *block = region.allocate(1024);
+   region.deallocate(block, 1024);
+
+   EXPECT_NE(block, region.allocate(1025));
+   EXPECT_EQ(block, region.allocate(600));
+   }
+
+TEST_F(RecyclingRegionTest, PeakBytesInUse)
+   {
+   TR::RecyclingRegion region(_segmentProvider, _rawAllocator);
+   void *first = region.allocate(256);
+   void *second = region.allocate(256);
+   EXPECT_EQ(512u, region.bytesInUse());
+   region.deallocate(first, 256);
+   region.deallocate(second, 256);
+   EXPECT_EQ(0u, region.bytesInUse());
+
+   region.allocate(256);
+   EXPECT_EQ(256u, region.bytesInUse());
+   EXPECT_EQ(512u, region.peakBytesInUse());
+   EXPECT_EQ(512u, region.bytesAllocated());
+   }
+
+TEST_F(RecyclingRegionTest, PlainRegionIgnoresDeallocations)
+   {
+   TR::Region region(_segmentProvider, _rawAllocator);
+   void *block = region.allocate(64);
+   region.deallocate(block, 64);
+
+   EXPECT_NE(block, region.allocate(64));
+   EXPECT_EQ(128u, region.bytesInUse());
+   }
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include "env/MemorySegment.hpp"
+#include "env/RawAllocator.hpp"
+#include "env/SegmentPool.hpp"
+#include "env/SystemSegmentProvider.hpp"
+
+class SegmentPoolTest : public ::testing::Test
+   {
+   public:
+   SegmentPoolTest() :
+      _rawAllocator(),
+      _segmentProvider(1 << 16, _rawAllocator)
+      {
+      }
+
+   TR::RawAllocator _rawAllocator;
+   TR::SystemSegmentProvider _segmentProvider;
+   };
+
+TEST_F(SegmentPoolTest, ReleasedSegmentsAreRecycled)
+   {
+   TR::SegmentPool pool(_segmentProvider, 2, _rawAllocator);
+   TR::MemorySegment &first = pool.request(100);
+   TR::MemorySegment &second = pool.request(100);
+   TR::MemorySegment &third = pool.request(100);
+   EXPECT_EQ(3u * (1 << 16), pool.bytesAllocated());
+
+   pool.release(first);
+   pool.release(second);
+   pool.release(third);
+   EXPECT_EQ(2u, pool.pooledSegments());
+   EXPECT_EQ(1u, pool.statistics()._released);
+
+   EXPECT_EQ(&second, &pool.request(1 << 16));
+   EXPECT_EQ(&first, &pool.request(1));
+   EXPECT_EQ(0u, pool.pooledSegments());
+   EXPECT_EQ(5u, pool.statistics()._requests);
+   EXPECT_EQ(2u, pool.statistics()._recycled);
+
+   pool.release(first);
+   pool.release(second);
+   }
+
+TEST_F(SegmentPoolTest, LargeSegmentsBypassThePool)
+   {
+   TR::SegmentPool pool(_segmentProvider, 4, _rawAllocator);
+   TR::MemorySegment &large = pool.request((1 << 16) + 1);
+   EXPECT_EQ(2u * (1 << 16), large.size());
+   pool.release(large);
+   EXPECT_EQ(0u, pool.pooledSegments());
+   EXPECT_EQ(0u, pool.statistics()._requests);
+   }
+
+TEST_F(SegmentPoolTest, HighWaterMarkIsReset)
+   {
+   TR::SegmentPool pool(_segmentProvider, 4, _rawAllocator);
+   TR::MemorySegment &first = pool.request(1);
+   TR::MemorySegment &second = pool.request(1);
+   pool.release(second);
+   pool.resetHighWaterMark();
+   EXPECT_EQ(1u * (1 << 16), pool.bytesAllocated());
+   pool.release(first);
+   }
+
+TEST_F(SegmentPoolTest, TrimKeepsResidentSegments)
+   {
+   TR::SegmentPool pool(_segmentProvider, 4, 1, _rawAllocator);
+   TR::MemorySegment *segments[4];
+   for (int i = 0; i < 4; ++i)
+      segments[i] = &pool.request(1);
+   for (int i = 0; i < 4; ++i)
+      pool.release(*segments[i]);
+
+   pool.trim();
+   EXPECT_EQ(3u, pool.statistics()._trimmed);
+   pool.trim();
+   EXPECT_EQ(3u, pool.statistics()._trimmed);
+
+   // Trimmed segments are still usable
+   TR::MemorySegment &recycled = pool.request(1);
+   static_cast<char *>(recycled.allocate(16))[0] = 1;
+   pool.release(recycled);
+   }
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+#include "env/RawAllocator.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "env/Region.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/BitVectorKernels.hpp"
+
+class BitVectorKernelsTest : public ::testing::Test
+   {
+   public:
+   BitVectorKernelsTest()
+      {
+      _kernels.push_back(&TR_BitVectorKernels::scalar());
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+      if (TR_BitVectorKernels::avx2() && __builtin_cpu_supports("avx2"))
+         _kernels.push_back(TR_BitVectorKernels::avx2());
+#endif
+      if (TR_BitVectorKernels::neon())
+         _kernels.push_back(TR_BitVectorKernels::neon());
+      }
+
+   static void fill(std::vector<chunk_t> &chunks, unsigned int seed)
+      {
+      srand(seed);
+      for (size_t i = 0; i < chunks.size(); i++)
+         {
+         chunk_t value = 0;
+         for (size_t b = 0; b < sizeof(chunk_t); b++)
+            value = (value << 8) | (chunk_t)(rand() & 0xff);
+         chunks[i] = value;
+         }
+      }
+
+   static int32_t referencePopulationCount(const chunk_t *a, int32_t numChunks)
+      {
+      int32_t count = 0;
+      for (int32_t i = 0; i < numChunks; i++)
+         for (chunk_t v = a[i]; v; v &= v - 1)
+            count++;
+      return count;
+      }
+
+   protected:
+   std::vector<const TR_BitVectorKernels *> _kernels;
+   };
+
+TEST_F(BitVectorKernelsTest, MatchReferenceOnAllLengthsAndOffsets)
+   {
+   const int32_t maxChunks = 37;
+   std::vector<chunk_t> a(maxChunks + 1), b(maxChunks + 1);
+   fill(a, 1);
+   fill(b, 2);
+
+   for (size_t k = 0; k < _kernels.size(); k++)
+      {
+      const TR_BitVectorKernels &kernels = *_kernels[k];
+      SCOPED_TRACE(kernels.name);
+
+      // Start at an odd chunk as well so the SIMD kernels see unaligned data
+      for (int32_t offset = 0; offset <= 1; offset++)
+         {
+         for (int32_t n = 0; n <= maxChunks - offset; n++)
+            {
+            const chunk_t *src = &b[offset];
+            std::vector<chunk_t> orResult(a), andResult(a), andNotResult(a);
+            kernels.orChunks(&orResult[offset], src, n);
+            kernels.andChunks(&andResult[offset], src, n);
+            kernels.andNotChunks(&andNotResult[offset], src, n);
+
+            std::vector<chunk_t> common(n);
+            for (int32_t i = 0; i < (int32_t)a.size(); i++)
+               {
+               bool inRange = i >= offset && i < offset + n;
+               ASSERT_EQ(inRange ? (a[i] | b[i]) : a[i], orResult[i]);
+               ASSERT_EQ(inRange ? (a[i] & b[i]) : a[i], andResult[i]);
+               ASSERT_EQ(inRange ? (a[i] & ~b[i]) : a[i], andNotResult[i]);
+               if (inRange)
+                  common[i - offset] = a[i] & b[i];
+               }
+
+            ASSERT_EQ(referencePopulationCount(&a[offset], n), kernels.populationCount(&a[offset], n));
+            ASSERT_EQ(referencePopulationCount(common.data(), n), kernels.commonPopulationCount(&a[offset], src, n));
+            ASSERT_EQ(referencePopulationCount(common.data(), n) != 0, kernels.intersects(&a[offset], src, n));
+            }
+         }
+      }
+   }
+
+TEST_F(BitVectorKernelsTest, IntersectsFindsSingleCommonBit)
+   {
+   const int32_t numChunks = 64;
+   for (size_t k = 0; k < _kernels.size(); k++)
+      {
+      const TR_BitVectorKernels &kernels = *_kernels[k];
+      SCOPED_TRACE(kernels.name);
+      for (int32_t common = 0; common < numChunks; common++)
+         {
+         std::vector<chunk_t> a(numChunks, (chunk_t)0x5555555555555555ULL);
+         std::vector<chunk_t> b(numChunks, (chunk_t)0xAAAAAAAAAAAAAAAAULL);
+         ASSERT_FALSE(kernels.intersects(a.data(), b.data(), numChunks));
+         b[common] |= 1;
+         ASSERT_TRUE(kernels.intersects(a.data(), b.data(), numChunks));
+         }
+      }
+   }
+
+// Runs TR_BitVector operations with each kernel table forced in turn, on
+// vectors whose non-zero ranges are long enough to take the bulk path
+//
+class BitVectorDispatchTest : public BitVectorKernelsTest
+   {
+   public:
+   BitVectorDispatchTest() :
+      _rawAllocator(),
+      _segmentProvider(1 << 16, _rawAllocator),
+      _region(_segmentProvider, _rawAllocator),
+      _saved(&TR_BitVectorKernels::active())
+      {
+      }
+
+   ~BitVectorDispatchTest()
+      {
+      TR_BitVectorKernels::setActive(*_saved);
+      }
+
+   // Set bits in [low, high) with a density that varies by seed
+   void fill(TR_BitVector &bv, std::vector<bool> &ref, int32_t low, int32_t high, unsigned int seed)
+      {
+      srand(seed);
+      for (int32_t i = low; i < high; i++)
+         {
+         if (rand() % 3 == 0)
+            {
+            bv.set(i);
+            ref[i] = true;
+            }
+         }
+      }
+
+   void expectEqual(TR_BitVector &bv, const std::vector<bool> &ref)
+      {
+      for (int32_t i = 0; i < (int32_t)ref.size(); i++)
+         ASSERT_EQ(ref[i], bv.isSet(i)) << "bit " << i;
+      }
+
+   static int32_t count(const std::vector<bool> &ref)
+      {
+      int32_t n = 0;
+      for (size_t i = 0; i < ref.size(); i++)
+         n += ref[i];
+      return n;
+      }
+
+   TR::Region &region() { return _region; }
+
+   private:
+   TR::RawAllocator _rawAllocator;
+   TR::SystemSegmentProvider _segmentProvider;
+   TR::Region _region;
+   const TR_BitVectorKernels *_saved;
+   };
+
+TEST_F(BitVectorDispatchTest, MatchReferenceThroughEachTable)
+   {
+   const int32_t numBits = 24 * BITS_IN_CHUNK;
+
+   // Ranges are chosen so that the overlapping chunks of the two operands
+   // exceed minBulkChunks but start and end at different chunks
+   const int32_t ranges[][4] =
+      {
+      { 0, numBits, 0, numBits },
+      { BITS_IN_CHUNK + 5, 19 * BITS_IN_CHUNK + 3, 3 * BITS_IN_CHUNK, numBits },
+      { 2 * BITS_IN_CHUNK, 22 * BITS_IN_CHUNK, 7, 14 * BITS_IN_CHUNK + 9 },
+      };
+
+   for (size_t k = 0; k < _kernels.size(); k++)
+      {
+      TR_BitVectorKernels::setActive(*_kernels[k]);
+      SCOPED_TRACE(_kernels[k]->name);
+
+      for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++)
+         {
+         SCOPED_TRACE(r);
+         std::vector<bool> refA(numBits), refB(numBits);
+         TR_BitVector a(numBits, region()), b(numBits, region());
+         fill(a, refA, ranges[r][0], ranges[r][1], 5 + r);
+         fill(b, refB, ranges[r][2], ranges[r][3], 6 + r);
+
+         int32_t common = 0;
+         for (int32_t i = 0; i < numBits; i++)
+            common += refA[i] && refB[i];
+
+         ASSERT_EQ(count(refA), a.elementCount());
+         ASSERT_EQ(common, a.commonElementCount(b));
+         ASSERT_EQ(common != 0, a.intersects(b));
+
+         std::vector<bool> ref(numBits);
+         TR_BitVector result(numBits, region());
+
+         result = a;
+         result |= b;
+         for (int32_t i = 0; i < numBits; i++)
+            ref[i] = refA[i] || refB[i];
+         expectEqual(result, ref);
+         ASSERT_EQ(count(ref), result.elementCount());
+
+         result = a;
+         result &= b;
+         for (int32_t i = 0; i < numBits; i++)
+            ref[i] = refA[i] && refB[i];
+         expectEqual(result, ref);
+         ASSERT_EQ(common, result.elementCount());
+
+         result = a;
+         result -= b;
+         for (int32_t i = 0; i < numBits; i++)
+            ref[i] = refA[i] && !refB[i];
+         expectEqual(result, ref);
+         ASSERT_EQ(count(ref), result.elementCount());
+         ASSERT_FALSE(result.intersects(b));
+         }
+      }
+   }
+
+// Microbenchmark comparing the kernel implementations on vectors the size of
+// a large method's dataflow sets.  Disabled by default; run it with
+//
+//    compunittest --gtest_filter=*Benchmark* --gtest_also_run_disabled_tests
+//
+TEST_F(BitVectorKernelsTest, DISABLED_Benchmark)
+   {
+   const int32_t numChunks = 1024;
+   const int32_t iterations = 100000;
+   std::vector<chunk_t> a(numChunks), b(numChunks);
+   fill(a, 3);
+   fill(b, 4);
+
+   for (size_t k = 0; k < _kernels.size(); k++)
+      {
+      const TR_BitVectorKernels &kernels = *_kernels[k];
+      volatile int32_t sink = 0;
+      clock_t start = clock();
+      for (int32_t i = 0; i < iterations; i++)
+         {
+         kernels.orChunks(a.data(), b.data(), numChunks);
+         kernels.andNotChunks(a.data(), b.data(), numChunks);
+         sink += kernels.intersects(a.data(), b.data(), numChunks);
+         sink += kernels.populationCount(a.data(), numChunks);
+         }
+      double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+      printf("%-8s %d x %d chunks: %.3f s (%.3f ns per chunk per operation)\n",
+             kernels.name, iterations, numChunks, seconds,
+             seconds * 1e9 / ((double)iterations * numChunks * 4));
+      }
+   }
@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include "env/RawAllocator.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "env/Region.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/ChunkedBitVector.hpp"
+
+class ChunkedBitVectorTest : public ::testing::Test
+   {
+   public:
+   ChunkedBitVectorTest() :
+      _rawAllocator(),
+      _segmentProvider(1 << 16, _rawAllocator),
+      _region(_segmentProvider, _rawAllocator)
+      {
+      }
+
+   TR::Region &region() { return _region; }
+
+   // Fill a dense and a chunked vector with the same pseudo-random contents,
+   // clustered so that some chunks are shared and most are empty
+   //
+   void fill(TR_BitVector &dense, TR_ChunkedBitVector &chunked, int32_t numBits, int32_t count, unsigned int seed)
+      {
+      srand(seed);
+      for (int32_t i = 0; i < count; i++)
+         {
+         int32_t bit = (rand() % (numBits / 256)) * 256 + (rand() % 80);
+         dense.set(bit);
+         chunked.set(bit);
+         }
+      }
+
+   void expectSameContents(TR_BitVector &dense, TR_ChunkedBitVector &chunked)
+      {
+      ASSERT_EQ(dense.elementCount(), chunked.elementCount());
+      ASSERT_EQ(dense.isEmpty(), chunked.isEmpty());
+      TR_BitVectorIterator di(dense);
+      TR_ChunkedBitVectorIterator ci(chunked);
+      while (di.hasMoreElements())
+         {
+         ASSERT_TRUE(ci.hasMoreElements());
+         ASSERT_EQ(di.getNextElement(), ci.getNextElement());
+         }
+      ASSERT_FALSE(ci.hasMoreElements());
+      }
+
+   protected:
+   TR::RawAllocator _rawAllocator;
+   TR::SystemSegmentProvider _segmentProvider;
+   TR::Region _region;
+   };
+
+TEST_F(ChunkedBitVectorTest, SetGetReset)
+   {
+   TR_ChunkedBitVector bv(100000, region());
+   ASSERT_TRUE(bv.isEmpty());
+   ASSERT_EQ(0, bv.numNonZeroChunks());
+
+   bv.set(99999);
+   bv.set(0);
+   bv.set(63);
+   bv.set(64);
+   ASSERT_TRUE(bv.isSet(0));
+   ASSERT_TRUE(bv.isSet(63));
+   ASSERT_TRUE(bv.isSet(64));
+   ASSERT_TRUE(bv.isSet(99999));
+   ASSERT_FALSE(bv.isSet(1));
+   ASSERT_FALSE(bv.isSet(50000));
+   ASSERT_EQ(4, bv.elementCount());
+   ASSERT_EQ(99999, bv.getHighestBitPosition());
+
+   bv.reset(99999);
+   ASSERT_FALSE(bv.isSet(99999));
+   ASSERT_EQ(64, bv.getHighestBitPosition());
+   ASSERT_TRUE(bv.clear(0));
+   ASSERT_FALSE(bv.clear(0));
+   ASSERT_TRUE(bv.hasMoreThanOneElement());
+   bv.reset(63);
+   ASSERT_FALSE(bv.hasMoreThanOneElement());
+   bv.empty();
+   ASSERT_TRUE(bv.isEmpty());
+   }
+
+TEST_F(ChunkedBitVectorTest, OnlyNonZeroChunksAreStored)
+   {
+   TR_ChunkedBitVector bv(1 << 20, region());
+   for (int32_t i = 0; i < 16; i++)
+      bv.set(i * 65536);
+   ASSERT_EQ(16, bv.numNonZeroChunks());
+   ASSERT_LT(bv.memoryUsed(), (size_t)(1 << 20) / 8);
+   }
+
+TEST_F(ChunkedBitVectorTest, Ranges)
+   {
+   TR_BitVector dense(1000, region());
+   TR_ChunkedBitVector chunked(1000, region());
+
+   dense.set(3);
+   chunked.set(3);
+   dense.set(700);
+   chunked.set(700);
+
+   dense.setAll(10, 20);
+   chunked.setAll(10, 20);
+   expectSameContents(dense, chunked);
+
+   dense.setAll(60, 400);
+   chunked.setAll(60, 400);
+   expectSameContents(dense, chunked);
+
+   dense.resetAll(100, 300);
+   chunked.resetAll(100, 300);
+   expectSameContents(dense, chunked);
+
+   dense.resetAll(0, 127);
+   chunked.resetAll(0, 127);
+   expectSameContents(dense, chunked);
+
+   TR_BitVector allDense(1000, region());
+   TR_ChunkedBitVector allChunked(1000, region());
+   allDense.setAll(777);
+   allChunked.setAll(777);
+   expectSameContents(allDense, allChunked);
+   }
+
+TEST_F(ChunkedBitVectorTest, SetOperationsMatchDense)
+   {
+   const int32_t numBits = 1 << 16;
+   for (unsigned int seed = 1; seed <= 8; seed++)
+      {
+      TR_BitVector a(numBits, region()), b(numBits, region());
+      TR_ChunkedBitVector ca(numBits, region()), cb(numBits, region());
+      fill(a, ca, numBits, 200, seed);
+      fill(b, cb, numBits, 200, seed + 100);
+
+      ASSERT_EQ(a.intersects(b), ca.intersects(cb));
+
+      TR_BitVector u(a);
+      TR_ChunkedBitVector cu(ca);
+      u |= b;
+      cu |= cb;
+      expectSameContents(u, cu);
+
+      TR_BitVector n(a);
+      TR_ChunkedBitVector cn(ca);
+      n &= b;
+      cn &= cb;
+      expectSameContents(n, cn);
+
+      TR_BitVector d(a);
+      TR_ChunkedBitVector cd(ca);
+      d -= b;
+      cd -= cb;
+      expectSameContents(d, cd);
+
+      // Same-shape operands take the bulk path
+      TR_ChunkedBitVector same(cu);
+      same &= cu;
+      ASSERT_TRUE(same == cu);
+      same -= cu;
+      ASSERT_TRUE(same.isEmpty());
+      }
+   }
+
+TEST_F(ChunkedBitVectorTest, ConversionToAndFromDense)
+   {
+   const int32_t numBits = 1 << 14;
+   TR_BitVector dense(numBits, region());
+   TR_ChunkedBitVector chunked(numBits, region());
+   fill(dense, chunked, numBits, 100, 42);
+
+   TR_ChunkedBitVector fromDense(region());
+   fromDense = dense;
+   ASSERT_TRUE(fromDense == chunked);
+
+   TR_BitVector toDense(numBits, region());
+   toDense = chunked;
+   ASSERT_TRUE(toDense == dense);
+   }
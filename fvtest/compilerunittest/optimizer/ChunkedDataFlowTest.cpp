@@ -0,0 +1,184 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "../CompilerUnitTest.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "compile/TLSCompilationManager.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "il/Block.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Cfg.hpp"
+#include "optimizer/DataFlowAnalysis.hpp"
+#include "optimizer/StructuralAnalysis.hpp"
+#include "optimizer/Structure.hpp"
+#include "optimizer/UseDefInfo.hpp"
+
+/**
+ * Builds a small loop nest over enough temporaries that the analysis sets
+ * span many chunks, then solves the same problem with the dense and the
+ * chunked containers so the two solutions can be compared block by block.
+ */
+class ChunkedDataFlowTest : public TRTest::CompilerUnitTest
+   {
+   public:
+   ChunkedDataFlowTest() : _tlsManager(_comp), _numTemps(700) {}
+
+   typedef std::vector<std::vector<int32_t> > Solution;
+
+   void buildLoop()
+      {
+      TR::CFG *cfg = _symbol->getFlowGraph();
+      cfg->setStartAndEnd(new (_comp.trHeapMemory()) TR::Block(_comp.trMemory()),
+                          new (_comp.trHeapMemory()) TR::Block(_comp.trMemory()));
+
+      for (int32_t i = 0; i < _numTemps; ++i)
+         _temps.push_back(_comp.getSymRefTab()->createTemporary(_symbol, TR::Int32));
+
+      TR::Block *entry = TR::Block::createEmptyBlock(&_comp);
+      TR::Block *header = TR::Block::createEmptyBlock(&_comp);
+      TR::Block *body = TR::Block::createEmptyBlock(&_comp);
+      TR::Block *exit = TR::Block::createEmptyBlock(&_comp);
+      cfg->addNode(entry);
+      cfg->addNode(header);
+      cfg->addNode(body);
+      cfg->addNode(exit);
+
+      for (int32_t i = 0; i < _numTemps; i += 3)
+         store(entry, i, TR::Node::iconst(i));
+
+      header->append(TR::TreeTop::create(&_comp,
+         TR::Node::createif(TR::ificmpgt, load(0), TR::Node::iconst(100), exit->getEntry())));
+
+      for (int32_t i = 5; i < _numTemps; i += 5)
+         store(body, i, TR::Node::create(TR::iadd, 2, load((i * 7) % _numTemps), load(i / 2)));
+      store(body, 0, TR::Node::create(TR::iadd, 2, load(0), TR::Node::iconst(1)));
+      body->append(TR::TreeTop::create(&_comp, TR::Node::create(TR::Goto, 0, header->getEntry())));
+
+      TR::Node *sum = load(1);
+      for (int32_t i = 11; i < _numTemps; i += 11)
+         sum = TR::Node::create(TR::iadd, 2, sum, load(i));
+      exit->append(TR::TreeTop::create(&_comp, TR::Node::create(TR::ireturn, 1, sum)));
+
+      entry->getExit()->join(header->getEntry());
+      header->getExit()->join(body->getEntry());
+      body->getExit()->join(exit->getEntry());
+      _symbol->setFirstTreeTop(entry->getEntry());
+
+      cfg->addEdge(cfg->getStart(), entry);
+      cfg->addEdge(entry, header);
+      cfg->addEdge(header, body);
+      cfg->addEdge(header, exit);
+      cfg->addEdge(body, header);
+      cfg->addEdge(exit, cfg->getEnd());
+
+      cfg->setStructure(TR_RegionAnalysis::getRegions(&_comp, _symbol));
+      }
+
+   Solution solveLiveness(bool chunked)
+      {
+      _comp.getOptions()->setOption(TR_EnableChunkedDataFlowSets, chunked);
+      _comp.getOptions()->setOption(TR_DisableChunkedDataFlowSets, !chunked);
+
+      Solution solution;
+      TR::StackMemoryRegion stackMemoryRegion(*_comp.trMemory());
+      TR_Liveness liveness(&_comp, _optimizer, _symbol->getFlowGraph()->getStructure());
+      int32_t numLocals = liveness.getLiveVariableInfo()->numLocals();
+      for (int32_t b = 0; b < liveness._numberOfNodes; ++b)
+         {
+         solution.push_back(std::vector<int32_t>());
+         for (int32_t i = 0; liveness._blockAnalysisInfo[b] && i < numLocals; ++i)
+            {
+            if (liveness._blockAnalysisInfo[b]->isSet(i))
+               solution.back().push_back(i);
+            }
+         }
+      return solution;
+      }
+
+   Solution solveReachingDefinitions(bool chunked)
+      {
+      _comp.getOptions()->setOption(TR_EnableChunkedDataFlowSets, chunked);
+      _comp.getOptions()->setOption(TR_DisableChunkedDataFlowSets, !chunked);
+
+      Solution solution;
+      TR_UseDefInfo *info = _optimizer->createUseDefInfo(&_comp, true, true, false);
+      if (!info->infoIsValid())
+         return solution;
+      for (int32_t use = info->getFirstUseIndex(); use <= info->getLastUseIndex(); ++use)
+         {
+         solution.push_back(std::vector<int32_t>());
+         TR_UseDefInfo::BitVector defs(_comp.allocator());
+         if (!info->getUseDef(defs, use))
+            continue;
+         TR_UseDefInfo::BitVector::Cursor cursor(defs);
+         for (cursor.SetToFirstOne(); cursor.Valid(); cursor.SetToNextOne())
+            solution.back().push_back(cursor);
+         }
+      return solution;
+      }
+
+   private:
+   TR::Node *load(int32_t temp) { return TR::Node::createLoad(_temps[temp]); }
+
+   void store(TR::Block *block, int32_t temp, TR::Node *value)
+      {
+      block->append(TR::TreeTop::create(&_comp, TR::Node::createStore(_temps[temp], value)));
+      }
+
+   TR::TLSCompilationManager _tlsManager;
+   int32_t _numTemps;
+   std::vector<TR::SymbolReference *> _temps;
+   };
+
+TEST_F(ChunkedDataFlowTest, LivenessMatchesDenseSolution)
+   {
+   buildLoop();
+   Solution dense = solveLiveness(false);
+   Solution chunked = solveLiveness(true);
+
+   ASSERT_EQ(dense.size(), chunked.size());
+   size_t numLive = 0;
+   for (size_t b = 0; b < dense.size(); ++b)
+      {
+      EXPECT_EQ(dense[b], chunked[b]) << "live-in set differs for block_" << b;
+      numLive += dense[b].size();
+      }
+   EXPECT_GT(numLive, 0u);
+   }
+
+TEST_F(ChunkedDataFlowTest, ReachingDefinitionsMatchDenseSolution)
+   {
+   buildLoop();
+   Solution dense = solveReachingDefinitions(false);
+   Solution chunked = solveReachingDefinitions(true);
+
+   ASSERT_FALSE(dense.empty());
+   ASSERT_EQ(dense.size(), chunked.size());
+   for (size_t use = 0; use < dense.size(); ++use)
+      EXPECT_EQ(dense[use], chunked[use]) << "reaching definitions differ for use " << use;
+   }
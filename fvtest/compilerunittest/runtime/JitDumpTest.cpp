@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "env/RawAllocator.hpp"
+#include "runtime/JitDump.hpp"
+
+class JitDumpTest : public ::testing::Test
+   {
+   public:
+   virtual void SetUp()
+      {
+      char directory[] = "/tmp/jitdumptestXXXXXX";
+      ASSERT_TRUE(mkdtemp(directory) != NULL);
+      _directory = directory;
+      char fileName[256];
+      snprintf(fileName, sizeof(fileName), "%s/jit-%d.dump", directory, getpid());
+      _fileName = fileName;
+      }
+
+   virtual void TearDown()
+      {
+      unlink(_fileName.c_str());
+      rmdir(_directory.c_str());
+      }
+
+   std::vector<uint8_t> readDump()
+      {
+      std::vector<uint8_t> contents;
+      FILE *file = fopen(_fileName.c_str(), "rb");
+      if (!file)
+         return contents;
+      int c;
+      while ((c = fgetc(file)) != EOF)
+         contents.push_back((uint8_t)c);
+      fclose(file);
+      return contents;
+      }
+
+   template <typename T> static T read(const std::vector<uint8_t> &data, size_t offset)
+      {
+      T value;
+      memcpy(&value, &data[offset], sizeof(value));
+      return value;
+      }
+
+   std::string _directory;
+   std::string _fileName;
+   };
+
+TEST_F(JitDumpTest, RecordsAreWrittenInOrder)
+   {
+   TR::RawAllocator allocator;
+   TR::JitDump *jitDump = TR::JitDump::create(allocator, _directory.c_str());
+   ASSERT_TRUE(jitDump != NULL);
+
+   static const uint8_t code[] = { 0x55, 0x48, 0x83, 0xec, 0x18, 0x90, 0x48, 0x83, 0xc4, 0x18, 0x5d, 0xc3 };
+   TR::JitDump::DebugEntry entries[] = { { (uintptr_t)code, 0, 0 }, { (uintptr_t)code + 5, 7, 1 } };
+   TR::JitDump::UnwindRow rows[] = { { 1, 16 }, { 5, 40 }, { 10, 16 }, { 11, 8 } };
+
+   jitDump->writeDebugInfo(code, "method", entries, 2);
+   jitDump->writeUnwindingInfo(sizeof(code), rows, 4);
+   jitDump->writeCodeLoad("method", code, sizeof(code));
+   jitDump->writeCodeMove(code, code + 64, sizeof(code));
+   jitDump->close();
+   allocator.deallocate(jitDump);
+
+   std::vector<uint8_t> dump = readDump();
+   ASSERT_GE(dump.size(), 40u);
+   EXPECT_EQ(0x4A695444u, read<uint32_t>(dump, 0));
+   EXPECT_EQ(1u, read<uint32_t>(dump, 4));
+   EXPECT_EQ((uint32_t)getpid(), read<uint32_t>(dump, 20));
+
+   std::vector<uint32_t> expectedIds;
+   expectedIds.push_back(2);
+   if (TR::JitDump::supportsUnwindingInfo())
+      expectedIds.push_back(4);
+   expectedIds.push_back(0);
+   expectedIds.push_back(1);
+   expectedIds.push_back(3);
+
+   size_t offset = read<uint32_t>(dump, 8);
+   uint64_t lastTimestamp = 0;
+   for (size_t i = 0; i < expectedIds.size(); ++i)
+      {
+      ASSERT_LE(offset + 16, dump.size());
+      uint32_t id = read<uint32_t>(dump, offset);
+      uint32_t size = read<uint32_t>(dump, offset + 4);
+      uint64_t timestamp = read<uint64_t>(dump, offset + 8);
+      EXPECT_EQ(expectedIds[i], id);
+      EXPECT_GE(timestamp, lastTimestamp);
+      lastTimestamp = timestamp;
+      ASSERT_LE(offset + size, dump.size());
+
+      const size_t body = offset + 16;
+      switch (id)
+         {
+         case 0: // JIT_CODE_LOAD
+            EXPECT_EQ((uint64_t)(uintptr_t)code, read<uint64_t>(dump, body + 16));
+            EXPECT_EQ(sizeof(code), read<uint64_t>(dump, body + 24));
+            EXPECT_EQ(0, strcmp("method", (const char *)&dump[body + 40]));
+            EXPECT_EQ(0, memcmp(code, &dump[body + 40 + 7], sizeof(code)));
+            EXPECT_EQ(16 + 40 + 7 + sizeof(code), size);
+            break;
+         case 1: // JIT_CODE_MOVE
+            EXPECT_EQ((uint64_t)(uintptr_t)code, read<uint64_t>(dump, body + 16));
+            EXPECT_EQ((uint64_t)(uintptr_t)(code + 64), read<uint64_t>(dump, body + 24));
+            break;
+         case 2: // JIT_CODE_DEBUG_INFO
+            EXPECT_EQ(2u, read<uint64_t>(dump, body + 8));
+            EXPECT_EQ((uint64_t)(uintptr_t)code + 5, read<uint64_t>(dump, body + 16 + 16 + 7));
+            EXPECT_EQ(7, read<int32_t>(dump, body + 16 + 16 + 7 + 8));
+            EXPECT_EQ(0xff, dump[body + 16 + 16 + 7 + 16]);
+            break;
+         case 4: // JIT_CODE_UNWINDING_INFO
+            {
+            uint64_t unwindingSize = read<uint64_t>(dump, body);
+            EXPECT_EQ(20u, read<uint64_t>(dump, body + 8));
+            EXPECT_EQ(0u, size % 8);
+            EXPECT_LE(16 + 24 + unwindingSize, size);
+            // The .eh_frame_hdr points back at the start of the .eh_frame
+            size_t header = body + 24 + unwindingSize - 20;
+            EXPECT_EQ(1, dump[header]);
+            EXPECT_EQ((int32_t)-(unwindingSize - 20 + 4), read<int32_t>(dump, header + 4));
+            EXPECT_EQ(1u, read<uint32_t>(dump, header + 8));
+            break;
+            }
+         }
+
+      offset += size;
+      }
+
+   EXPECT_EQ(dump.size(), offset);
+   }
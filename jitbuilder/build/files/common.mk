@@ -32,6 +32,8 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/env/ExceptionTable.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/Assert.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/BitVector.cpp \
+    $(JIT_OMR_DIRTY_DIR)/infra/BitVectorKernels.cpp \
+    $(JIT_OMR_DIRTY_DIR)/infra/ChunkedBitVector.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/Checklist.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/HashTab.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/STLUtils.cpp \
@@ -74,10 +76,12 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/env/OMRVMEnv.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRVMMethodEnv.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SegmentProvider.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/SegmentPool.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SegmentAllocator.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SystemSegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/DebugSegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/Region.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/RecyclingRegion.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/StackMemoryRegion.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRPersistentInfo.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/TRMemory.cpp \
@@ -141,9 +145,11 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/optimizer/LoopCanonicalizer.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/LoopReducer.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/LoopReplicator.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/LoopVectorizer.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/LoopVersioner.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/OMRLocalCSE.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/LocalDeadStoreElimination.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/LocalEscapeAnalysis.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/LocalOpts.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/OMROptimization.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/OMROptimizationManager.cpp \
@@ -160,6 +166,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/optimizer/RegisterCandidate.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/ReorderIndexExpr.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/SinkStores.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/SLPVectorizer.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/StripMiner.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/VPConstraint.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/VPHandlers.cpp \
@@ -177,6 +184,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/optimizer/TrivialDeadBlockRemover.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/UnionBitVectorAnalysis.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/UseDefInfo.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/ValueNumberCSE.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/ValueNumberInfo.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/VirtualGuardCoalescer.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/VirtualGuardHeadMerger.cpp \
@@ -210,6 +218,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/codegen/OMRRealRegister.cpp \
     $(JIT_OMR_DIRTY_DIR)/codegen/OMRRegisterPair.cpp \
     $(JIT_OMR_DIRTY_DIR)/codegen/OMRInstruction.cpp \
+    $(JIT_OMR_DIRTY_DIR)/codegen/OMRInstructionScheduler.cpp \
     $(JIT_OMR_DIRTY_DIR)/codegen/ELFGenerator.cpp \
     $(JIT_OMR_DIRTY_DIR)/codegen/OMRELFRelocationResolver.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/FEBase.cpp \
@@ -240,6 +249,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/ilgen/OMRVirtualMachineRegisterInStruct.cpp \
     $(JIT_OMR_DIRTY_DIR)/ilgen/OMRVirtualMachineState.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/CodeCacheTypes.cpp \
+    $(JIT_OMR_DIRTY_DIR)/runtime/JitDump.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCache.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheManager.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheMemorySegment.cpp \
@@ -33,6 +33,7 @@
 #include "ilgen/MethodBuilder.hpp"
 #include "ilgen/TypeDictionary.hpp"
 #include "runtime/CodeCache.hpp"
+#include "runtime/CodeCacheMemorySegment.hpp"
 #include "runtime/Runtime.hpp"
 #include "runtime/JBJitConfig.hpp"
 
@@ -98,13 +99,15 @@ initializeCodeCache(TR::CodeCacheManager & codeCacheManager)
    codeCacheConfig._codeCachePadKB = 0;
    codeCacheConfig._codeCacheAlignment = 32;
    codeCacheConfig._codeCacheFreeBlockRecylingEnabled = true;
-   codeCacheConfig._largeCodePageSize = 0;
+   codeCacheConfig._largeCodePageSize = TR::Options::getCmdLineOptions()->getOption(TR_EnableCodeCacheHugePages) ?
+                                         TR::CodeCacheMemorySegment::DefaultHugePageSize : 0;
    codeCacheConfig._largeCodePageFlags = 0;
    codeCacheConfig._maxNumberOfCodeCaches = 96;
    codeCacheConfig._canChangeNumCodeCaches = true;
    codeCacheConfig._emitExecutableELF = TR::Options::getCmdLineOptions()->getOption(TR_PerfTool) 
                                     ||  TR::Options::getCmdLineOptions()->getOption(TR_EmitExecutableELFFile);
    codeCacheConfig._emitRelocatableELF = TR::Options::getCmdLineOptions()->getOption(TR_EmitRelocatableELFFile);
+   codeCacheConfig._emitJitDump = TR::Options::getCmdLineOptions()->getOption(TR_EmitJitDump);
 
    TR::CodeCache *firstCodeCache = codeCacheManager.initialize(true, 1);
    }
@@ -218,5 +221,6 @@ internal_shutdownJit()
    TR::CodeCacheManager &codeCacheManager = fe->codeCacheManager();
    codeCacheManager.destroy();
 
+   commonJitShutdown();
    TR::CompilationController::shutdown();
    }
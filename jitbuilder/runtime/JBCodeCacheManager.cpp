@@ -80,6 +80,9 @@ JitBuilder::CodeCacheManager::allocateCodeCacheSegment(size_t segmentSize,
    if (segmentSize < config.codeCachePadKB() << 10)
       codeCacheSizeToAllocate = config.codeCachePadKB() << 10;
 
+   // Huge page backed segments are allocated in whole, aligned huge pages
+   size_t hugePageSize = config.largeCodePageSize();
+
 #if defined(OMR_OS_WINDOWS)
    auto memorySlab = reinterpret_cast<uint8_t *>(
          VirtualAlloc(NULL,
@@ -94,13 +97,30 @@ JitBuilder::CodeCacheManager::allocateCodeCacheSegment(size_t segmentSize,
    auto memorySlab = reinterpret_cast<uint8_t *>(
          __malloc31(codeCacheSizeToAllocate));
 #else
+   size_t mappingSize = codeCacheSizeToAllocate;
+   if (hugePageSize)
+      {
+      // Map an extra huge page so that the segment can be aligned
+      codeCacheSizeToAllocate = (codeCacheSizeToAllocate + hugePageSize - 1) & ~(hugePageSize - 1);
+      mappingSize = codeCacheSizeToAllocate + hugePageSize;
+      }
    auto memorySlab = reinterpret_cast<uint8_t *>(
          mmap(NULL,
-              codeCacheSizeToAllocate,
+              mappingSize,
               PROT_READ | PROT_WRITE | PROT_EXEC,
               MAP_ANONYMOUS | MAP_PRIVATE,
               -1,
               0));
+   if (hugePageSize && memorySlab != MAP_FAILED)
+      {
+      uint8_t *alignedSlab = reinterpret_cast<uint8_t *>(((uintptr_t)memorySlab + hugePageSize - 1) & ~(uintptr_t)(hugePageSize - 1));
+      uint8_t *alignedTop = alignedSlab + codeCacheSizeToAllocate;
+      if (alignedSlab != memorySlab)
+         munmap(memorySlab, alignedSlab - memorySlab);
+      if (alignedTop != memorySlab + mappingSize)
+         munmap(alignedTop, memorySlab + mappingSize - alignedTop);
+      memorySlab = alignedSlab;
+      }
    // keep the impact of this fix localized
    #if defined(NO_MAP_ANONYMOUS)
       #undef MAP_ANONYMOUS
@@ -109,6 +129,8 @@ JitBuilder::CodeCacheManager::allocateCodeCacheSegment(size_t segmentSize,
 #endif /* OMR_OS_WINDOWS */
    TR::CodeCacheMemorySegment *memSegment = (TR::CodeCacheMemorySegment *) ((size_t)memorySlab + codeCacheSizeToAllocate - sizeof(TR::CodeCacheMemorySegment));
    new (memSegment) TR::CodeCacheMemorySegment(memorySlab, reinterpret_cast<uint8_t *>(memSegment));
+   if (hugePageSize)
+      memSegment->adviseHugePages(hugePageSize);
    return memSegment;
    }
 